@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                             adaptfilter-impl.h
+ *
+ * Implementation for AdaptFilter class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor, the delay line keeps "extra" samples more
+ * than the filter length
+ */
+template <typename Type>
+AdaptFilter<Type>::AdaptFilter( int length, int extra )
+                 : L(length), D(length+extra), pos(0), wn(length),
+                   buf(2*(length+extra))
+{
+    assert( L > 0 );
+    assert( extra >= 0 );
+}
+
+template <typename Type>
+AdaptFilter<Type>::~AdaptFilter()
+{
+}
+
+
+/**
+ * Clear the delay line and the weights.
+ */
+template <typename Type>
+void AdaptFilter<Type>::reset()
+{
+    pos = 0;
+    wn = Type(0);
+    buf = Type(0);
+}
+
+
+/**
+ * Get the filter length.
+ */
+template <typename Type>
+inline int AdaptFilter<Type>::length() const
+{
+    return L;
+}
+
+
+/**
+ * Get and set the weight vector.
+ */
+template <typename Type>
+inline Vector<Type> AdaptFilter<Type>::getWeights() const
+{
+    return wn;
+}
+
+template <typename Type>
+void AdaptFilter<Type>::setWeights( const Vector<Type> &w )
+{
+    assert( w.size() == L );
+    wn = w;
+}
+
+
+/**
+ * Insert a new sample into the circular delay line. After this the delay
+ * line x(k), x(k-1), ..., x(k-D+1) is buf[pos], ..., buf[pos+D-1].
+ */
+template <typename Type>
+inline void AdaptFilter<Type>::push( const Type &xk )
+{
+    pos = ( pos == 0 ) ? D-1 : pos-1;
+    buf[pos] = xk;
+    buf[pos+D] = xk;
+}
+
+
+/**
+ * Pointer to the latest sample of the delay line.
+ */
+template <typename Type>
+inline const Type* AdaptFilter<Type>::delayLine() const
+{
+    return &buf[pos];
+}
+
+
+/**
+ * The filter output with current weights and delay line.
+ */
+template <typename Type>
+inline Type AdaptFilter<Type>::output() const
+{
+    const Type *xn = delayLine();
+
+    Type yk = 0;
+    for( int i=0; i<L; ++i )
+        yk += wn[i]*xn[i];
+
+    return yk;
+}
+
+
+/**
+ * The output of filtering without adaptation, which is the output of the
+ * weights unless a derived class overrides it.
+ */
+template <typename Type>
+Type AdaptFilter<Type>::response( const Type* )
+{
+    return output();
+}
+
+
+/**
+ * Filtering without adaptation.
+ */
+template <typename Type>
+Type AdaptFilter<Type>::filter( const Type &xk )
+{
+    push(xk);
+    return response( delayLine() );
+}
+
+template <typename Type>
+void AdaptFilter<Type>::filter( const Vector<Type> &xn, Vector<Type> &yn )
+{
+    int N = xn.size();
+    if( yn.size() != N )
+        yn.resize(N);
+
+    for( int k=0; k<N; ++k )
+    {
+        push(xn[k]);
+        yn[k] = response( delayLine() );
+    }
+}
+
+
+/**
+ * Filtering and updating the weights by the desired signal "dk", return
+ * the filter output (see the derived classes for a priori or a posteriori
+ * output).
+ */
+template <typename Type>
+Type AdaptFilter<Type>::adapt( const Type &xk, const Type &dk )
+{
+    push(xk);
+    return update( delayLine(), dk, output() );
+}
+
+template <typename Type>
+void AdaptFilter<Type>::adapt( const Vector<Type> &xn,
+                               const Vector<Type> &dn, Vector<Type> &yn )
+{
+    int N = xn.size();
+    assert( dn.size() == N );
+    if( yn.size() != N )
+        yn.resize(N);
+
+    for( int k=0; k<N; ++k )
+    {
+        push(xn[k]);
+        yn[k] = update( delayLine(), dn[k], output() );
+    }
+}
+
+
+/**
+ * Run C independent adaptive filters, the ith row of "xn", "dn" and "yn"
+ * is the input, desired and output signal of the ith filter, respectively.
+ * The filters are processed in parallel, so each one must appear only once
+ * in "filters".
+ */
+template <typename Type>
+void adaptChannels( AdaptFilter<Type> **filters, const Matrix<Type> &xn,
+                    const Matrix<Type> &dn, Matrix<Type> &yn )
+{
+    int C = xn.rows(),
+        N = xn.cols();
+
+    assert( dn.rows() == C );
+    assert( dn.cols() == N );
+    if( yn.rows() != C || yn.cols() != N )
+        yn.resize( C, N );
+
+    #pragma omp parallel for
+    for( int c=0; c<C; ++c )
+    {
+        AdaptFilter<Type> *af = filters[c];
+        const Type *x = xn[c],
+                   *d = dn[c];
+        Type *y = yn[c];
+
+        for( int k=0; k<N; ++k )
+            y[k] = af->adapt( x[k], d[k] );
+    }
+}
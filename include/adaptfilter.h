@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                               adaptfilter.h
+ *
+ * Base class for adaptive transversal filters.
+ *
+ * An adaptive filter object owns all of its state: the weight vector, the
+ * delay line of the input signal and whatever the particular algorithm
+ * needs (e.g. the inverse correlation matrix of RLS), so any number of
+ * filters can run independently, even in different threads.
+ *
+ * The delay line is a circular buffer stored twice in a length 2*D array,
+ * hence the latest D input samples are always contiguous in memory and a
+ * new sample is inserted without shifting the old ones. D is the filter
+ * length L plus the extra samples a derived class asks for (e.g. the fast
+ * transversal RLS needs the previous delay line too). The per-sample and
+ * per-block updates make no memory allocation.
+ *
+ * The derived classes implement "update", which adjusts the weights from
+ * the current delay line and the desired signal, and "response" if their
+ * output is not the inner product of the weights and the delay line (e.g.
+ * the lattice filters). "adaptChannels" runs a group of independent
+ * filters, one per channel, in parallel if OpenMP is enabled.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef ADAPTFILTER_H
+#define ADAPTFILTER_H
+
+
+#include <vector.h>
+#include <matrix.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class AdaptFilter
+    {
+
+    public:
+
+        AdaptFilter( int length, int extra=0 );
+        virtual ~AdaptFilter();
+
+        virtual void reset();
+
+        int length() const;
+        Vector<Type> getWeights() const;
+        void setWeights( const Vector<Type> &w );
+
+        Type filter( const Type &xk );
+        void filter( const Vector<Type> &xn, Vector<Type> &yn );
+
+        Type adapt( const Type &xk, const Type &dk );
+        void adapt( const Vector<Type> &xn, const Vector<Type> &dn,
+                    Vector<Type> &yn );
+
+    protected:
+
+        // filter length, delay line length and the position of the latest
+        // sample
+        int L,
+            D,
+            pos;
+
+        // weight vector and the duplicated delay line
+        Vector<Type> wn;
+        Vector<Type> buf;
+
+        void push( const Type &xk );
+        const Type* delayLine() const;
+        Type output() const;
+
+        virtual Type update( const Type *xn, const Type &dk,
+                             const Type &yk ) = 0;
+        virtual Type response( const Type *xn );
+
+    };
+    // class AdaptFilter
+
+
+    template<typename Type>
+    void adaptChannels( AdaptFilter<Type>**, const Matrix<Type>&,
+                        const Matrix<Type>&, Matrix<Type>& );
+
+
+    #include <adaptfilter-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// ADAPTFILTER_H
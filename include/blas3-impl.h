@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                blas3-impl.h
+ *
+ * Implementation for blocked matrix-matrix kernels.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * General matrix multiplication, C(MxN) = alpha*op(A)*op(B) + beta*C,
+ * where op(A) is MxK and op(B) is KxN, "trans" is 'N', 'T' or 'C'.
+ */
+template <typename Type>
+void gemm( char transA, char transB, int M, int N, int K,
+           const Type &alpha, const Type *A, int lda,
+           const Type *B, int ldb, const Type &beta, Type *C, int ldc )
+{
+    const int MC = 64,
+              NC = 256,
+              KC = 256;
+
+    if( M <= 0 || N <= 0 )
+        return;
+
+    int nI = (M+MC-1) / MC,
+        nJ = (N+NC-1) / NC;
+
+    #pragma omp parallel
+    {
+        Vector<Type> packA( MC*KC ),
+                     packB( KC*NC );
+
+        #pragma omp for
+        for( int t=0; t<nI*nJ; ++t )
+        {
+            int i0 = (t/nJ) * MC,
+                j0 = (t%nJ) * NC;
+            const Type *At = (transA == 'N') ? A+i0*lda : A+i0,
+                       *Bt = (transB == 'N') ? B+j0 : B+j0*ldb;
+
+            gemmTile( transA, transB, min(MC,M-i0), min(NC,N-j0), K,
+                      alpha, At, lda, Bt, ldb, beta, C+i0*ldc+j0, ldc,
+                      &packA[0], &packB[0] );
+        }
+    }
+}
+
+
+/**
+ * Symmetric (Hermitian) rank-k update of the lower triangle of C(NxN),
+ * C = alpha*A*A^H + beta*C for A(NxK) if "trans" is 'N', or
+ * C = alpha*A^H*A + beta*C for A(KxN) if "trans" is 'C' (or 'T').
+ */
+template <typename Type>
+void syrk( char trans, int N, int K, const Type &alpha,
+           const Type *A, int lda, const Type &beta, Type *C, int ldc )
+{
+    const int NC = 64,
+              KC = 256;
+
+    if( N <= 0 )
+        return;
+
+    int nT = (N+NC-1) / NC;
+    char transB = (trans == 'N') ? 'C' : 'N';
+
+    #pragma omp parallel
+    {
+        Vector<Type> packA( NC*KC ),
+                     packB( KC*NC ),
+                     tile( NC*NC );
+
+        // the tiles (I,J), J <= I, in rows of the lower triangle
+        #pragma omp for
+        for( int t=0; t<nT*(nT+1)/2; ++t )
+        {
+            int I = int( (sqrt(8.0*t+1)-1) / 2 );
+            while( I*(I+1)/2 > t )
+                --I;
+            while( (I+1)*(I+2)/2 <= t )
+                ++I;
+            int J = t - I*(I+1)/2,
+                i0 = I*NC,
+                j0 = J*NC,
+                mb = min( NC, N-i0 ),
+                nb = min( NC, N-j0 );
+            const Type *Ai = (trans == 'N') ? A+i0*lda : A+i0,
+                       *Aj = (trans == 'N') ? A+j0*lda : A+j0;
+
+            if( I > J )
+                gemmTile( trans, transB, mb, nb, K, alpha, Ai, lda, Aj, lda,
+                          beta, C+i0*ldc+j0, ldc, &packA[0], &packB[0] );
+            else
+            {
+                // compute the diagonal tile aside, and keep its lower part
+                gemmTile( trans, transB, mb, nb, K, alpha, Ai, lda, Aj, lda,
+                          Type(0), &tile[0], nb, &packA[0], &packB[0] );
+                for( int i=0; i<mb; ++i )
+                {
+                    Type *c = C + (i0+i)*ldc + j0;
+                    for( int j=0; j<=i; ++j )
+                        c[j] = ( (beta == Type(0)) ? Type(0) : beta*c[j] )
+                             + tile[i*nb+j];
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Triangular solver, op(A)*X = B (side 'L') or X*op(A) = B (side 'R'),
+ * where A is lower ('L') or upper ('U') triangular, op(A) is A, A^T or A^H
+ * ("trans" is 'N', 'T' or 'C'), the diagonal is unit ('U') or not ('N'),
+ * and B is MxN, which is overwritten by X.
+ */
+template <typename Type>
+void trsm( char side, char uplo, char trans, char diag, int M, int N,
+           const Type *A, int lda, Type *B, int ldb )
+{
+    const int MS = 64;
+
+    int na = (side == 'L') ? M : N;
+    if( M <= 0 || N <= 0 )
+        return;
+    if( na <= MS )
+    {
+        trsmSmall( side, uplo, trans, diag, M, N, A, lda, B, ldb );
+        return;
+    }
+
+    // op(A) = [ T1 0; S T2 ] (lower) or [ T1 S; 0 T2 ] (upper), and the
+    // unknowns of T1 are solved at first if the system is lower (left side)
+    // or upper (right side)
+    int m1 = na / 2,
+        m2 = na - m1;
+    const Type *A12 = A + m1,
+               *A21 = A + m1*lda,
+               *A22 = A21 + m1;
+    bool lower = ( (uplo == 'L') == (trans == 'N') );
+
+    if( side == 'L' )
+    {
+        Type *B1 = B,
+             *B2 = B + m1*ldb;
+
+        if( lower )
+        {
+            trsm( side, uplo, trans, diag, m1, N, A, lda, B1, ldb );
+            gemm( trans, 'N', m2, N, m1, Type(-1),
+                  (trans == 'N') ? A21 : A12, lda, B1, ldb,
+                  Type(1), B2, ldb );
+            trsm( side, uplo, trans, diag, m2, N, A22, lda, B2, ldb );
+        }
+        else
+        {
+            trsm( side, uplo, trans, diag, m2, N, A22, lda, B2, ldb );
+            gemm( trans, 'N', m1, N, m2, Type(-1),
+                  (trans == 'N') ? A12 : A21, lda, B2, ldb,
+                  Type(1), B1, ldb );
+            trsm( side, uplo, trans, diag, m1, N, A, lda, B1, ldb );
+        }
+    }
+    else
+    {
+        Type *B1 = B,
+             *B2 = B + m1;
+
+        if( !lower )
+        {
+            trsm( side, uplo, trans, diag, M, m1, A, lda, B1, ldb );
+            gemm( 'N', trans, M, m2, m1, Type(-1), B1, ldb,
+                  (trans == 'N') ? A12 : A21, lda, Type(1), B2, ldb );
+            trsm( side, uplo, trans, diag, M, m2, A22, lda, B2, ldb );
+        }
+        else
+        {
+            trsm( side, uplo, trans, diag, M, m2, A22, lda, B2, ldb );
+            gemm( 'N', trans, M, m1, m2, Type(-1), B2, ldb,
+                  (trans == 'N') ? A21 : A12, lda, Type(1), B1, ldb );
+            trsm( side, uplo, trans, diag, M, m1, A, lda, B1, ldb );
+        }
+    }
+}
+
+
+/**
+ * One tile of "gemm", op(A) and op(B) are packed into "packA" (MxKC) and
+ * "packB" (KCxN) for each panel of KC columns.
+ */
+template <typename Type>
+void gemmTile( char transA, char transB, int M, int N, int K,
+               const Type &alpha, const Type *A, int lda,
+               const Type *B, int ldb, const Type &beta,
+               Type *C, int ldc, Type *packA, Type *packB )
+{
+    const int KC = 256;
+
+    if( beta == Type(0) )
+        for( int i=0; i<M; ++i )
+            for( int j=0; j<N; ++j )
+                C[i*ldc+j] = 0;
+    else if( beta != Type(1) )
+        for( int i=0; i<M; ++i )
+            for( int j=0; j<N; ++j )
+                C[i*ldc+j] *= beta;
+
+    if( alpha == Type(0) )
+        return;
+
+    for( int p0=0; p0<K; p0+=KC )
+    {
+        int kb = min( KC, K-p0 );
+        Type *pa = packA,
+             *pb = packB;
+
+        // pack alpha*op(A) in rows of kb and op(B) in rows of N
+        if( transA == 'N' )
+            for( int i=0; i<M; ++i )
+                for( int k=0; k<kb; ++k )
+                    pa[i*kb+k] = alpha * A[i*lda+p0+k];
+        else
+            for( int k=0; k<kb; ++k )
+                for( int i=0; i<M; ++i )
+                    pa[i*kb+k] = alpha * conjOp( transA, A[(p0+k)*lda+i] );
+
+        if( transB == 'N' )
+            for( int k=0; k<kb; ++k )
+                for( int j=0; j<N; ++j )
+                    pb[k*N+j] = B[(p0+k)*ldb+j];
+        else
+            for( int j=0; j<N; ++j )
+                for( int k=0; k<kb; ++k )
+                    pb[k*N+j] = conjOp( transB, B[j*ldb+p0+k] );
+
+        // four rows of the tile at a time
+        int i = 0;
+        for( ; i+4<=M; i+=4 )
+        {
+            Type *c0 = C + i*ldc,
+                 *c1 = c0 + ldc,
+                 *c2 = c1 + ldc,
+                 *c3 = c2 + ldc;
+            const Type *a = pa + i*kb;
+
+            for( int k=0; k<kb; ++k )
+            {
+                Type a0 = a[k],
+                     a1 = a[kb+k],
+                     a2 = a[2*kb+k],
+                     a3 = a[3*kb+k];
+                const Type *b = pb + k*N;
+                for( int j=0; j<N; ++j )
+                {
+                    c0[j] += a0*b[j];
+                    c1[j] += a1*b[j];
+                    c2[j] += a2*b[j];
+                    c3[j] += a3*b[j];
+                }
+            }
+        }
+        for( ; i<M; ++i )
+        {
+            Type *c0 = C + i*ldc;
+            const Type *a = pa + i*kb;
+
+            for( int k=0; k<kb; ++k )
+            {
+                Type a0 = a[k];
+                const Type *b = pb + k*N;
+                for( int j=0; j<N; ++j )
+                    c0[j] += a0*b[j];
+            }
+        }
+    }
+}
+
+
+/**
+ * Triangular solver for small A by substitution. For the left side the
+ * rows of X are solved in turn on chunks of the columns, for the right
+ * side each row of X is solved independently.
+ */
+template <typename Type>
+void trsmSmall( char side, char uplo, char trans, char diag, int M, int N,
+                const Type *A, int lda, Type *B, int ldb )
+{
+    const int NS = 256;
+    bool lower = ( (uplo == 'L') == (trans == 'N') );
+
+    if( side == 'L' )
+    {
+        int nChunks = (N+NS-1) / NS;
+
+        #pragma omp parallel for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int j0 = c*NS,
+                nb = min( NS, N-j0 );
+
+            for( int s=0; s<M; ++s )
+            {
+                int i = lower ? s : M-1-s,
+                    k0 = lower ? 0 : i+1,
+                    k1 = lower ? i : M;
+                Type *bi = B + i*ldb + j0;
+
+                for( int k=k0; k<k1; ++k )
+                {
+                    Type a = (trans == 'N') ? A[i*lda+k]
+                                            : conjOp( trans, A[k*lda+i] );
+                    const Type *bk = B + k*ldb + j0;
+                    for( int j=0; j<nb; ++j )
+                        bi[j] -= a*bk[j];
+                }
+
+                if( diag != 'U' )
+                {
+                    Type d = conjOp( trans, A[i*lda+i] );
+                    for( int j=0; j<nb; ++j )
+                        bi[j] /= d;
+                }
+            }
+        }
+    }
+    else
+    {
+        // x*op(A) = b, op(A) upper: forward, lower: backward
+        #pragma omp parallel for
+        for( int r=0; r<M; ++r )
+        {
+            Type *x = B + r*ldb;
+
+            for( int s=0; s<N; ++s )
+            {
+                int j = lower ? N-1-s : s,
+                    k0 = lower ? j+1 : 0,
+                    k1 = lower ? N : j;
+                Type t = x[j];
+
+                if( trans == 'N' )
+                    for( int k=k0; k<k1; ++k )
+                        t -= x[k] * A[k*lda+j];
+                else
+                {
+                    const Type *aj = A + j*lda;
+                    for( int k=k0; k<k1; ++k )
+                        t -= x[k] * conjOp( trans, aj[k] );
+                }
+
+                if( diag != 'U' )
+                    t /= conjOp( trans, A[j*lda+j] );
+                x[j] = t;
+            }
+        }
+    }
+}
+
+
+/**
+ * The element of op(A), conjugated if "trans" is 'C' for complex matrices.
+ */
+template <typename Type>
+inline Type conjOp( char, const Type &x )
+{
+    return x;
+}
+
+template <typename Type>
+inline complex<Type> conjOp( char trans, const complex<Type> &x )
+{
+    return (trans == 'C') ? conj(x) : x;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                   blas3.h
+ *
+ * Blocked matrix-matrix kernels on row-major arrays.
+ *
+ * The routines work on parts of matrices given by a pointer to the first
+ * element and the leading dimension (the distance between two rows), like
+ * the level 3 BLAS, so that the blocked factorizations can update the
+ * blocks of a "Matrix" in place:
+ *      gemm : C = alpha*op(A)*op(B) + beta*C;
+ *      syrk : C = alpha*op(A)*op(A)^H + beta*C, the lower triangle only;
+ *      trsm : op(A)*X = B (left side) or X*op(A) = B (right side) by a
+ *             triangular A, X overwrites B;
+ * where op(X) is X ('N'), X^T ('T') or X^H ('C', the same as 'T' for real
+ * matrices).
+ *
+ * "gemm" splits C into tiles, which are computed in parallel if OpenMP is
+ * enabled. For each tile the parts of op(A) and op(B) are packed into
+ * contiguous buffers of the thread in panels of KC columns, and then the
+ * tile is updated four rows at a time by rank-1 updates of contiguous rows,
+ * which can be vectorized by the compiler. Each element of C is computed
+ * by one thread in a fixed order, so the results don't depend on the number
+ * of threads. "syrk" computes the tiles of the lower triangle in the same
+ * way.
+ *
+ * "trsm" is recursive: the triangular matrix is split into halves, one half
+ * of the unknowns is solved, and the other right hand sides are updated by
+ * "gemm". The small triangles are solved by substitution, the right hand
+ * sides are split into chunks for the threads.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef BLAS3_H
+#define BLAS3_H
+
+
+#include <vector.h>
+
+
+namespace splab
+{
+
+    template<typename Type>
+    void gemm( char transA, char transB, int M, int N, int K,
+               const Type &alpha, const Type *A, int lda,
+               const Type *B, int ldb, const Type &beta, Type *C, int ldc );
+
+    template<typename Type>
+    void syrk( char trans, int N, int K, const Type &alpha,
+               const Type *A, int lda, const Type &beta, Type *C, int ldc );
+
+    template<typename Type>
+    void trsm( char side, char uplo, char trans, char diag, int M, int N,
+               const Type *A, int lda, Type *B, int ldb );
+
+
+    template<typename Type>
+    static void gemmTile( char transA, char transB, int M, int N, int K,
+                          const Type &alpha, const Type *A, int lda,
+                          const Type *B, int ldb, const Type &beta,
+                          Type *C, int ldc, Type *packA, Type *packB );
+
+    template<typename Type>
+    static void trsmSmall( char side, char uplo, char trans, char diag,
+                           int M, int N, const Type *A, int lda,
+                           Type *B, int ldb );
+
+    template<typename Type>
+    static Type conjOp( char trans, const Type &x );
+
+    template<typename Type>
+    static complex<Type> conjOp( char trans, const complex<Type> &x );
+
+
+    #include <blas3-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// BLAS3_H
@@ -72,32 +72,74 @@ void CCholesky<Type>::dec( const Matrix<Type> &A )
     if( !spd )
         return;
 
-    L = Matrix<Type>(A.cols(),A.cols());
-
-    // main loop
-    for( int j=0; j<A.rows(); ++j )
+    for( int j=0; j<n && spd; ++j )
     {
-        Type d = 0;
         spd = spd && (imag(A[j][j]) == 0);
-
         for( int k=0; k<j; ++k )
-        {
-            Type s = 0;
-            for( int i=0; i<k; ++i )
-                s += L[k][i] * conj(L[j][i]);
-
-            L[j][k] = s = (A[j][k]-s) / L[k][k];
-            d = d + s*conj(s);
             spd = spd && (A[k][j] == conj(A[j][k]));
+    }
+
+    L = A;
+
+    // right-looking blocked loop
+    for( int j=0; j<n; j+=NB )
+    {
+        int jb = ( n-j < NB ) ? n-j : NB,
+            j1 = j + jb;
+
+        if( !decBlock( j, jb ) )
+        {
+            spd = false;
+            break;
         }
 
-        d = A[j][j] - d;
-        spd = spd && ( real(d) > 0 );
+        if( j1 < n )
+        {
+            // L21 = A21 * L11^{-H}, A22 -= L21 * L21^H
+            trsm( 'R', 'L', 'C', 'N', n-j1, jb, &L[j][j], n, &L[j1][j], n );
+            syrk( 'N', n-j1, jb, Type(-1), &L[j1][j], n,
+                  Type(1), &L[j1][j1], n );
+        }
+    }
 
-        L[j][j] = sqrt( real(d) > 0 ? d : 0 );
-        for( int k=j+1; k<A.rows(); ++k )
+    for( int j=0; j<n; ++j )
+        for( int k=j+1; k<n; ++k )
             L[j][k] = 0;
+}
+
+
+/**
+ * Unblocked factorization of the diagonal block of rows and columns j, ...,
+ * j+jb-1 in place, return false if it's not positive definite.
+ */
+template <typename Type>
+bool CCholesky<Type>::decBlock( int j, int jb )
+{
+    for( int c=j; c<j+jb; ++c )
+    {
+        Type *Lc = L[c],
+             d = Lc[c];
+        for( int k=j; k<c; ++k )
+            d -= Lc[k]*conj(Lc[k]);
+
+        if( !(real(d) > 0) )
+        {
+            Lc[c] = 0;
+            return false;
+        }
+        Lc[c] = sqrt( real(d) );
+
+        for( int i=c+1; i<j+jb; ++i )
+        {
+            Type *Li = L[i],
+                 s = Li[c];
+            for( int k=j; k<c; ++k )
+                s -= Li[k]*conj(Lc[k]);
+            Li[c] = s / Lc[c];
+        }
     }
+
+    return true;
 }
 
 
@@ -160,25 +202,9 @@ Matrix<Type> CCholesky<Type>::solve( const Matrix<Type> &B )
     Matrix<Type> X = B;
     int nx = B.cols();
 
-    // solve L*Y = B
-    for( int j=0; j<nx; ++j )
-        for( int k=0; k<n; ++k )
-        {
-            for( int i=0; i<k; ++i )
-                X[k][j] -= X[i][j]*L[k][i];
-
-            X[k][j] /= L[k][k];
-        }
-
-    // solve L^H*x = y
-    for( int j=0; j<nx; ++j )
-        for( int k=n-1; k>=0; --k )
-        {
-            for( int i=k+1; i<n; ++i )
-                X[k][j] -= X[i][j]*conj(L[i][k]);
-
-            X[k][j] /= L[k][k];
-        }
+    // solve L*Y = B and L^H*X = Y
+    trsm( 'L', 'L', 'N', 'N', n, nx, &L[0][0], n, &X[0][0], nx );
+    trsm( 'L', 'L', 'C', 'N', n, nx, &L[0][0], n, &X[0][0], nx );
 
     return X;
 }
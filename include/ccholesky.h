@@ -34,6 +34,10 @@
  * definite, the class computes only a partial decomposition. This can be
  * tested with the isSpd() flag.
  *
+ * The decomposition is blocked in the same way as "Cholesky", the trailing
+ * lower triangle is updated by the Hermitian rank-k update "syrk" (see
+ * "blas3.h"), and multiple right hand sides are solved by "trsm".
+ *
  * Zhang Ming, 2010-12, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -43,6 +47,7 @@
 
 
 #include <matrix.h>
+#include <blas3.h>
 
 
 namespace splab
@@ -66,9 +71,13 @@ namespace splab
 
     private:
 
+        static const int NB = 128;
+
         bool spd;
         Matrix<Type> L;
 
+        bool decBlock( int j, int jb );
+
     };
     //	class CCholesky
 
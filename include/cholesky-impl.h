@@ -72,30 +72,71 @@ void Cholesky<Type>::dec( const Matrix<Type> &A )
     if( !spd )
         return;
 
-    L = Matrix<Type>(n,n);
+    for( int j=0; j<n && spd; ++j )
+        for( int k=0; k<j; ++k )
+            spd = spd && (A[k][j] == A[j][k]);
 
-    // main loop.
-    for( int j=0; j<n; ++j )
+    L = A;
+
+    // right-looking blocked loop
+    for( int j=0; j<n; j+=NB )
     {
-        Type d = 0;
-        for( int k=0; k<j; ++k )
-        {
-            Type s = 0;
-            for( int i=0; i<k; ++i )
-                s += L[k][i]*L[j][i];
+        int jb = ( n-j < NB ) ? n-j : NB,
+            j1 = j + jb;
 
-            L[j][k] = s = (A[j][k]-s) / L[k][k];
-            d = d + s*s;
-            spd = spd && (A[k][j] == A[j][k]);
+        if( !choleskyBlock( &L[j][j], jb, n ) )
+        {
+            spd = false;
+            break;
         }
 
-        d = A[j][j] - d;
-        spd = spd && ( d > 0 );
+        if( j1 < n )
+        {
+            // L21 = A21 * L11^{-T}, A22 -= L21 * L21^T
+            trsm( 'R', 'L', 'C', 'N', n-j1, jb, &L[j][j], n, &L[j1][j], n );
+            syrk( 'N', n-j1, jb, Type(-1), &L[j1][j], n,
+                  Type(1), &L[j1][j1], n );
+        }
+    }
 
-        L[j][j] = sqrt( d > 0 ? d : 0 );
+    for( int j=0; j<n; ++j )
         for( int k=j+1; k<n; ++k )
             L[j][k] = 0;
+}
+
+
+/**
+ * Unblocked Cholesky factorization of the lower triangle of a small block
+ * in place, return false if it's not positive definite.
+ */
+template <typename Type>
+bool choleskyBlock( Type *a, int n, int lda )
+{
+    for( int j=0; j<n; ++j )
+    {
+        Type *aj = a + j*lda,
+             d = aj[j];
+        for( int k=0; k<j; ++k )
+            d -= aj[k]*aj[k];
+
+        if( !(d > 0) )
+        {
+            aj[j] = 0;
+            return false;
+        }
+        aj[j] = sqrt(d);
+
+        for( int i=j+1; i<n; ++i )
+        {
+            Type *ai = a + i*lda,
+                 s = ai[j];
+            for( int k=0; k<j; ++k )
+                s -= ai[k]*aj[k];
+            ai[j] = s / aj[j];
+        }
     }
+
+    return true;
 }
 
 
@@ -158,27 +199,84 @@ Matrix<Type> Cholesky<Type>::solve( const Matrix<Type> &B )
     Matrix<Type> X = B;
     int nx = B.cols();
 
-    // solve L*Y = B
-    for( int j=0; j<nx; ++j )
-        for( int k=0; k<n; ++k )
-        {
-            for( int i=0; i<k; ++i )
-                X[k][j] -= X[i][j]*L[k][i];
+    // solve L*Y = B and L'*X = Y
+    trsm( 'L', 'L', 'N', 'N', n, nx, &L[0][0], n, &X[0][0], nx );
+    trsm( 'L', 'L', 'C', 'N', n, nx, &L[0][0], n, &X[0][0], nx );
 
-            X[k][j] /= L[k][k];
-        }
+    return X;
+}
 
-    // solve L'*X = Y
-    for( int j=0; j<nx; ++j )
-        for( int k=n-1; k>=0; --k )
+
+/**
+ * Rank-one update, L*L' = A + x*x'. For k = 0, ..., n-1 a rotation of
+ * L(:,k) and x zeroes x[k]. The diagonal of L is real, so the same
+ * rotations serve a complex factor with x' the conjugate transpose.
+ */
+template <typename Type>
+void Cholesky<Type>::update( const Vector<Type> &x )
+{
+    int n = L.rows();
+    assert( spd );
+    assert( x.dim() == n );
+
+    Vector<Type> w = x;
+    for( int k=0; k<n; ++k )
+    {
+        Type r = sqrt( L[k][k]*L[k][k] + w[k]*conjOp('C',w[k]) ),
+             c = r / L[k][k],
+             s = w[k] / L[k][k];
+        L[k][k] = r;
+
+        for( int i=k+1; i<n; ++i )
         {
-            for( int i=k+1; i<n; ++i )
-                X[k][j] -= X[i][j]*L[i][k];
+            L[i][k] = ( L[i][k] + conjOp('C',s)*w[i] ) / c;
+            w[i] = c*w[i] - s*L[i][k];
+        }
+    }
+}
+
 
-            X[k][j] /= L[k][k];
+/**
+ * Rank-one downdate, L*L' = A - x*x', by hyperbolic rotations. If
+ * A - x*x' is not positive definite, i.e. norm(inv(L)*x) >= 1, L is not
+ * changed and false is returned.
+ */
+template <typename Type>
+bool Cholesky<Type>::downdate( const Vector<Type> &x )
+{
+    int n = L.rows();
+    assert( spd );
+    assert( x.dim() == n );
+
+    // p = inv(L)*x
+    Vector<Type> w = x;
+    Type pp = 0;
+    for( int k=0; k<n; ++k )
+    {
+        for( int i=0; i<k; ++i )
+            w[k] -= L[k][i]*w[i];
+        w[k] /= L[k][k];
+        pp += w[k]*conjOp('C',w[k]);
+    }
+    if( !( abs(pp) < 1 ) )
+        return false;
+
+    w = x;
+    for( int k=0; k<n; ++k )
+    {
+        Type r = sqrt( (L[k][k]-abs(w[k])) * (L[k][k]+abs(w[k])) ),
+             c = r / L[k][k],
+             s = w[k] / L[k][k];
+        L[k][k] = r;
+
+        for( int i=k+1; i<n; ++i )
+        {
+            L[i][k] = ( L[i][k] - conjOp('C',s)*w[i] ) / c;
+            w[i] = c*w[i] - s*L[i][k];
         }
+    }
 
-    return X;
+    return true;
 }
 
 
@@ -204,7 +302,7 @@ Matrix<Type> Cholesky<Type>::solve( const Matrix<Type> &B )
         {                                               \
             s = 0;                                      \
             for( int i=0; i<k; ++i )                    \
-                s += L[k][i] * conj(L[j][i]);           \
+                s += L[j][i] * conj(L[k][i]);           \
                                                         \
             L[j][k] = s = (A[j][k]-s) / L[k][k];        \
             d = d + norm(s);                            \
@@ -34,6 +34,23 @@
  * function computes only a partial decomposition. This can be tested with
  * the isSpd() flag.
  *
+ * The decomposition of a real matrix is right-looking and blocked: the
+ * diagonal block of NB columns is factorized by the unblocked algorithm,
+ * the block column below it is solved by "trsm", and the trailing lower
+ * triangle is updated by "syrk" (see "blas3.h"), which runs in parallel if
+ * OpenMP is enabled. Only the lower triangle of A is used in the blocked
+ * part, the symmetry is checked at first. A system of multiple right hand
+ * sides is solved by two blocked triangular solvers.
+ *
+ * The factor of a positive definite A can be modified in O(n^2) operations
+ * when A changes by a rank-one term: "update" computes the factor of
+ * A + x*x' by Givens rotations, and "downdate" that of A - x*x' by
+ * hyperbolic rotations, which fails (and keeps L) if A - x*x' is not
+ * positive definite. For a complex matrix x' is the conjugate transpose.
+ * A sliding window of rows of [A, b] is tracked by updating with the new
+ * row and downdating with the old one: the transpose of the factor of
+ * [A, b]'*[A, b] is the R factor of [A, b], and x is found as in "QRD".
+ *
  * This class also supports factorization of complex matrix by specializing
  * some member functions.
  *
@@ -48,6 +65,7 @@
 
 
 #include <matrix.h>
+#include <blas3.h>
 
 
 namespace splab
@@ -69,8 +87,13 @@ namespace splab
         Vector<Type> solve( const Vector<Type> &b );
         Matrix<Type> solve( const Matrix<Type> &B );
 
+        void update( const Vector<Type> &x );
+        bool downdate( const Vector<Type> &x );
+
     private:
 
+        static const int NB = 128;
+
         bool spd;
 
         Matrix<Type> L;
@@ -79,6 +102,10 @@ namespace splab
     //	class Cholesky
 
 
+    template<typename Type>
+    static bool choleskyBlock( Type *a, int n, int lda );
+
+
     #include <cholesky-impl.h>
 
 }
@@ -114,6 +114,60 @@ inline Vector<Type> fastCorr( const Vector<Type> &xn, const Vector<Type> &yn,
 }
 
 
+/**
+ * Auto-correlation of lags 0, 1, ..., p. Padding "xn" with zeros to at least
+ * N+p points avoids the circular aliasing of these lags, so the FFT can be
+ * much shorter than that of "fastCorr" when p << N.
+ */
+template<typename Type>
+Vector<Type> corrLags( const Vector<Type> &xn, int p, const string &opt )
+{
+    int N = xn.size();
+    assert( 0 <= p && p < N );
+
+    Vector<Type> rn(p+1);
+
+    int L = 1;
+    while( L < N+p )
+        L *= 2;
+
+    if( (p+1)*double(N) <= 4.0*L*fastLog2(L) )
+    {
+        for( int i=0; i<=p; ++i )
+        {
+            Type sum = 0;
+            for( int k=0; k<N-i; ++k )
+                sum += xn[k+i]*xn[k];
+            rn[i] = sum;
+        }
+    }
+    else
+    {
+        Vector<Type> xPad(L);
+        Vector< complex<Type> > Xk(L);
+        for( int i=0; i<N; ++i )
+            xPad[i] = xn[i];
+
+        FFTMR<Type> dft;
+        dft.fft( xPad, Xk );
+        for( int k=0; k<L; ++k )
+            Xk[k] = norm( Xk[k] );
+        dft.ifft( Xk, xPad );
+
+        for( int i=0; i<=p; ++i )
+            rn[i] = xPad[i];
+    }
+
+    if( opt == "biased" )
+        rn /= Type(N);
+    else if( opt == "unbiased" )
+        for( int i=0; i<=p; ++i )
+            rn[i] /= Type(N-i);
+
+    return rn;
+}
+
+
 /**
  * Biase processing for correlation.
  */
@@ -46,6 +46,11 @@
  * R2[x(t),y(t)] = sum{ x(u)*y(u+t) } = Conv[x(-t),y(t)]
  * And here we use the first defination.
  *
+ * If only the lags 0, 1, ..., p of the auto-correlation are needed, such as
+ * in AR model estimation, "corrLags" returns them in a length p+1 vector.
+ * It is computed directly for small "p", and by FFT with N+p points zero
+ * padding for large "p".
+ *
  * Zhang Ming, 2010-10, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -73,6 +78,9 @@ namespace splab
                                                    const Vector<Type>&,
                                                    const string &opt="none" );
 
+    template<typename Type> Vector<Type> corrLags( const Vector<Type>&, int,
+                                                   const string &opt="none" );
+
     template<typename Type> static void biasedProcessing( Vector<Type> &,
                                                           const string &opt );
 
@@ -56,41 +56,23 @@ void CQRD<Type>::dec( const Matrix<complex<Type> > &A )
         n = A.cols(),
         p = min(m,n);
 
-    Type absV0, normV, beta;
-    complex<Type> alpha;
-
     diagR = Vector<complex<Type> >(p);
     betaR = Vector<Type>(p);
-	QR = A;
+    T = Matrix<complex<Type> >( (p < NB) ? p : NB, p );
+    QR = A;
 
-    // main loop.
-    for( int k=0; k<p; ++k )
+    // main loop over the panels of NB columns.
+    for( int j=0; j<p; j+=NB )
     {
-		// Form k-th Householder vector.
-		normV = 0;
-		for( int i=k; i<m; ++i )
-			normV += norm(QR[i][k]);
-        normV = sqrt(normV);
-
-		absV0 = abs(QR[k][k]);
-		alpha = -normV * QR[k][k]/absV0;
-		beta  = 1 / ( normV * (normV+absV0) );
-		QR[k][k] -= alpha;
-
-		// Apply transformation to remaining columns.
-		for( int j=k+1; j<n; ++j )
-		{
-			complex<Type> s = 0;
-			for( int i=k; i<m; ++i )
-				s += conj(QR[i][k]) * QR[i][j];
-            s *= beta;
-			for( int i=k; i<m; ++i )
-				QR[i][j] -= s*QR[i][k];
-		}
-
-		diagR[k] = alpha;
-		betaR[k] = beta;
-	}
+        int jb = ( p-j < NB ) ? p-j : NB;
+        panel( j, jb );
+        formT( j, jb, &T[0][j], p );
+
+        // Apply the block reflector to the remaining columns.
+        if( j+jb < n )
+            applyBlockReflector( 'C', m-j, n-j-jb, jb, &QR[j][j], n,
+                                 &T[0][j], p, &QR[j][j+jb], n );
+    }
 
 //    int m = A.rows(),
 //        n = A.cols(),
@@ -160,29 +142,12 @@ Matrix<complex<Type> > CQRD<Type>::getQ()
         p = betaR.dim();
 
     Matrix<complex<Type> >Q( m, p );
-//	for( int i=0; i<p; ++i )
-//		Q[i][i] = 1;
-
-    for( int k=p-1; k>=0; --k )
-    {
-		Q[k][k] = 1 - betaR[k]*norm(QR[k][k]);
-		for( int i=k+1; i<m; ++i )
-			Q[i][k] = -betaR[k]*QR[i][k]*conj(QR[k][k]);
-
-		for( int j=k+1; j<p; ++j )
-		{
-			complex<Type> s = 0;
-			for( int i=k; i<m; ++i )
-				s += conj(QR[i][k])*Q[i][j];
-            s *= betaR[k];
-
-			for( int i=k; i<m; ++i )
-				Q[i][j] -= s * QR[i][k];
-
-		}
-	}
+    for( int i=0; i<p; ++i )
+        Q[i][i] = 1;
+    if( p > 0 )
+        applyBlocks( 'N', &Q[0][0], p );
 
-	return Q;
+    return Q;
 }
 
 
@@ -197,17 +162,76 @@ Matrix<complex<Type> > CQRD<Type>::getR()
     Matrix<complex<Type> > R( p, n );
 
     for( int i=0; i<p; ++i )
-	{
-		R[i][i] = diagR[i];
+    {
+        R[i][i] = diagR[i];
 
         for( int j=i+1; j<n; ++j )
             R[i][j] = QR[i][j];
-	}
+    }
 
     return R;
 }
 
 
+/**
+ * Return Q*b, where Q is the m-by-m product of the Householder reflectors
+ * and b has m elements.
+ */
+template <typename Type>
+Vector<complex<Type> > CQRD<Type>::applyQ( const Vector<complex<Type> > &b )
+{
+    assert( b.dim() == QR.rows() );
+
+    Vector<complex<Type> > x = b;
+    if( x.dim() > 0 )
+        applyBlocks( 'N', &x[0], 1 );
+
+    return x;
+}
+
+template <typename Type>
+Matrix<complex<Type> > CQRD<Type>::applyQ( const Matrix<complex<Type> > &B )
+{
+    assert( B.rows() == QR.rows() );
+
+    Matrix<complex<Type> > X = B;
+    if( X.rows() > 0 && X.cols() > 0 )
+        applyBlocks( 'N', &X[0][0], X.cols() );
+
+    return X;
+}
+
+
+/**
+ * Return Q^H*b, where Q is the m-by-m product of the Householder reflectors
+ * and b has m elements. The first p elements correspond to the columns of
+ * the economic Q.
+ */
+template <typename Type>
+Vector<complex<Type> > CQRD<Type>::applyQH( const Vector<complex<Type> > &b )
+{
+    assert( b.dim() == QR.rows() );
+
+    Vector<complex<Type> > x = b;
+    if( x.dim() > 0 )
+        applyBlocks( 'C', &x[0], 1 );
+
+    return x;
+}
+
+template <typename Type>
+Matrix<complex<Type> > CQRD<Type>::applyQH( const Matrix<complex<Type> > &B )
+{
+    assert( B.rows() == QR.rows() );
+
+    Matrix<complex<Type> > X = B;
+    if( X.rows() > 0 && X.cols() > 0 )
+        applyBlocks( 'C', &X[0][0], X.cols() );
+
+    return X;
+}
+
+
 /**
  * Least squares solution of A*x = b, where A and b are complex.
  * Return x: a n-length vector that minimizes the two norm
@@ -226,19 +250,8 @@ Vector<complex<Type> > CQRD<Type>::solve( const Vector<complex<Type> > &b )
     if( !isFullRank() )
         return Vector<complex<Type> >();
 
-    Vector<complex<Type> > x = b;
-
     // compute y = Q^H * b
-    for( int k=0; k<n; ++k )
-    {
-        complex<Type> s = 0;
-        for( int i=k; i<m; ++i )
-            s += conj(QR[i][k])*x[i];
-
-        s *= betaR[k];
-        for( int i=k; i<m; ++i )
-            x[i] -= s * QR[i][k];
-    }
+    Vector<complex<Type> > x = applyQH( b );
 
     // solve R*x = y;
     for( int k=n-1; k>=0; --k )
@@ -275,21 +288,9 @@ Matrix<complex<Type> > CQRD<Type>::solve( const Matrix<complex<Type> > &B )
     if( !isFullRank() )
         return Matrix<complex<Type> >(0,0);
 
-    int nx = B.cols();
-    Matrix<complex<Type> > X = B;
-
     // compute Y = Q^H*B
-    for( int k=0; k<n; ++k )
-        for( int j=0; j<nx; ++j )
-        {
-            complex<Type> s = 0;
-            for( int i=k; i<m; ++i )
-                s += conj(QR[i][k])*X[i][j];
-
-            s *= betaR[k];
-            for( int i=k; i<m; ++i )
-                X[i][j] -= s*QR[i][k];
-        }
+    int nx = B.cols();
+    Matrix<complex<Type> > X = applyQH( B );
 
     // solve R*X = Y;
     for( int k=n-1; k>=0; --k )
@@ -310,3 +311,110 @@ Matrix<complex<Type> > CQRD<Type>::solve( const Matrix<complex<Type> > &B )
 
      return X_;
 }
+
+
+/**
+ * Form the k-th Householder vector and apply it to the columns k+1 to
+ * jEnd-1.
+ */
+template <typename Type>
+void CQRD<Type>::householder( int k, int jEnd )
+{
+    int m = QR.rows();
+
+    Type absV0, normV, beta;
+    complex<Type> alpha;
+
+    // Form k-th Householder vector.
+    normV = 0;
+    for( int i=k; i<m; ++i )
+        normV += norm(QR[i][k]);
+    normV = sqrt(normV);
+
+    absV0 = abs(QR[k][k]);
+    alpha = -normV * QR[k][k]/absV0;
+    beta  = 1 / ( normV * (normV+absV0) );
+    QR[k][k] -= alpha;
+
+    // Apply transformation to remaining columns.
+    for( int j=k+1; j<jEnd; ++j )
+    {
+        complex<Type> s = 0;
+        for( int i=k; i<m; ++i )
+            s += conj(QR[i][k]) * QR[i][j];
+        s *= beta;
+        for( int i=k; i<m; ++i )
+            QR[i][j] -= s*QR[i][k];
+    }
+
+    diagR[k] = alpha;
+    betaR[k] = beta;
+}
+
+
+/**
+ * Factorize the panel of columns j to j+w-1 recursively: the left half is
+ * factorized, its block reflector is applied to the right half, and then
+ * the right half is factorized.
+ */
+template <typename Type>
+void CQRD<Type>::panel( int j, int w )
+{
+    if( w <= 4 )
+    {
+        for( int k=j; k<j+w; ++k )
+            householder( k, j+w );
+        return;
+    }
+
+    int m = QR.rows(),
+        n = QR.cols(),
+        w1 = w/2;
+
+    panel( j, w1 );
+
+    Matrix<complex<Type> > T1( w1, w1 );
+    formT( j, w1, &T1[0][0], w1 );
+    applyBlockReflector( 'C', m-j, w-w1, w1, &QR[j][j], n, &T1[0][0], w1,
+                         &QR[j][j+w1], n );
+
+    panel( j+w1, w-w1 );
+}
+
+
+/**
+ * Form the triangular factor of the reflectors j to j+w-1, the k-th
+ * reflector is H = I - betaR[k]*v*v^H.
+ */
+template <typename Type>
+void CQRD<Type>::formT( int j, int w, complex<Type> *Tj, int ldt )
+{
+    Vector<complex<Type> > tau( w );
+    for( int k=0; k<w; ++k )
+        tau[k] = betaR[j+k];
+
+    blockReflector( QR.rows()-j, w, &QR[j][j], QR.cols(), &tau[0],
+                    Tj, ldt );
+}
+
+
+/**
+ * X(m x nx) = Q*X if "trans" is 'N', or X = Q^H*X if "trans" is 'C', by
+ * the block reflectors of the panels.
+ */
+template <typename Type>
+void CQRD<Type>::applyBlocks( char trans, complex<Type> *X, int nx )
+{
+    int m = QR.rows(),
+        n = QR.cols(),
+        p = betaR.dim(),
+        nb = (p+NB-1) / NB;
+
+    for( int t=0; t<nb; ++t )
+    {
+        int j = ( trans == 'N' ) ? (nb-1-t)*NB : t*NB,
+            jb = ( p-j < NB ) ? p-j : NB;
+        applyBlockReflector( trans, m-j, nx, jb, &QR[j][j], n,
+                             &T[0][j], p, X+j*nx, nx );
+    }
+}
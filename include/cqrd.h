@@ -40,6 +40,10 @@
  * is provided to find the least squares solution of Ax=b or AX=B using the
  * QR factors.
  *
+ * As in "QRD", the decomposition is blocked by the compact WY form of the
+ * Householder reflectors, I - V*T*V^H, and Q or Q^H can be applied to
+ * right hand sides by "applyQ" and "applyQH" without forming Q.
+ *
  * Zhang Ming, 2010-12, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -49,6 +53,7 @@
 
 
 #include <matrix.h>
+#include <householder.h>
 
 
 namespace splab
@@ -69,11 +74,18 @@ namespace splab
 		Matrix<complex<Type> > getQ();
 		Matrix<complex<Type> > getR();
 
+		Vector<complex<Type> > applyQ( const Vector<complex<Type> > &b );
+		Matrix<complex<Type> > applyQ( const Matrix<complex<Type> > &B );
+		Vector<complex<Type> > applyQH( const Vector<complex<Type> > &b );
+		Matrix<complex<Type> > applyQH( const Matrix<complex<Type> > &B );
+
 		Vector<complex<Type> > solve( const Vector<complex<Type> > &b );
 		Matrix<complex<Type> > solve( const Matrix<complex<Type> > &B );
 
     private:
 
+		static const int NB = 32;
+
 		// internal storage of QR
 		Matrix<complex<Type> > QR;
 
@@ -83,6 +95,13 @@ namespace splab
 		// constants for generating Householder vector
 		Vector<Type> betaR;
 
+		// triangular factors of the block reflectors, NB columns each
+		Matrix<complex<Type> > T;
+
+		void householder( int k, int jEnd );
+		void panel( int j, int w );
+		void formT( int j, int w, complex<Type> *Tj, int ldt );
+		void applyBlocks( char trans, complex<Type> *X, int nx );
 
 	};
 	// class CQRD
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 csd-impl.h
+ *
+ * Implementation for CSD class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructor and destructor
+ * C        : the number of channels
+ * wn       : window function, the segment length is wn.size()
+ * K        : the step between two adjacent segments
+ * L        : the number of FFT points, L >= wn.size()
+ */
+template <typename Type>
+CSD<Type>::CSD( int C, const Vector<Type> &wn, int K, int L )
+: nChan(C), nPairs(C*(C+1)/2), nFreq(L/2+1), nFFT(L), step(K),
+  win(wn), pairI(C*(C+1)/2), pairJ(C*(C+1)/2),
+  Xre(BLOCK*C,L/2+1), Xim(BLOCK*C,L/2+1),
+  Sre(C*(C+1)/2,L/2+1), Sim(C*(C+1)/2,L/2+1)
+{
+    assert( C > 0 );
+    assert( K > 0 );
+    assert( L >= wn.size() );
+
+    winPow = sum( wn*wn );
+
+    for( int i=0, p=0; i<C; ++i )
+        for( int j=i; j<C; ++j, ++p )
+        {
+            pairI[p] = i;
+            pairJ[p] = j;
+        }
+
+    reset();
+}
+
+template <typename Type>
+CSD<Type>::~CSD()
+{
+}
+
+
+/**
+ * Discard the accumulated spectra.
+ */
+template <typename Type>
+void CSD<Type>::reset()
+{
+    Sre = Type(0);
+    Sim = Type(0);
+    nSegs = 0;
+}
+
+
+/**
+ * Accumulate the cross spectra of the multi-channel signal "xn", where each
+ * row of "xn" is a channel. This routine can be called repeatly for several
+ * records, and the estimation is the average over all of them.
+ */
+template <typename Type>
+void CSD<Type>::estimate( const Matrix<Type> &xn )
+{
+    int C = nChan,
+        M = win.size(),
+        N = xn.cols();
+
+    assert( xn.rows() == C );
+    if( N < M )
+        return;
+
+    int S = (N-M)/step + 1,
+        maxB = BLOCK;
+
+    for( int s0=0; s0<S; s0+=maxB )
+    {
+        int B = min( maxB, S-s0 );
+
+        // transform each channel of each segment once
+        #pragma omp parallel
+        {
+            Vector<Type> buf(nFFT);
+            Vector< complex<Type> > Xk(nFFT);
+            FFTMR<Type> dftmr;
+            FFTPF<Type> dftpf;
+
+            #pragma omp for
+            for( int t=0; t<B*C; ++t )
+            {
+                int b = t/C,
+                    c = t%C;
+                const Type *xs = &xn[c][(s0+b)*step];
+
+                for( int i=0; i<M; ++i )
+                    buf[i] = xs[i] * win[i];
+                for( int i=M; i<nFFT; ++i )
+                    buf[i] = 0;
+
+                if( isPower2(nFFT) )
+                    dftmr.fft( buf, Xk );
+                else
+                    dftpf.fft( buf, Xk );
+
+                Type *xr = Xre[t],
+                     *xi = Xim[t];
+                for( int k=0; k<nFreq; ++k )
+                {
+                    xr[k] = Xk[k].real();
+                    xi[k] = Xk[k].imag();
+                }
+            }
+        }
+
+        // Sij += Xi*conj(Xj) for all pairs in the upper triangle
+        #pragma omp parallel for schedule(dynamic)
+        for( int p=0; p<nPairs; ++p )
+        {
+            Type *sr = Sre[p],
+                 *si = Sim[p];
+
+            for( int b=0; b<B; ++b )
+            {
+                const Type *ar = Xre[b*C+pairI[p]],
+                           *ai = Xim[b*C+pairI[p]],
+                           *br = Xre[b*C+pairJ[p]],
+                           *bi = Xim[b*C+pairJ[p]];
+
+                for( int k=0; k<nFreq; ++k )
+                {
+                    sr[k] += ar[k]*br[k] + ai[k]*bi[k];
+                    si[k] += ai[k]*br[k] - ar[k]*bi[k];
+                }
+            }
+        }
+    }
+
+    nSegs += S;
+}
+
+
+/**
+ * Return the number of channels.
+ */
+template <typename Type>
+inline int CSD<Type>::channels() const
+{
+    return nChan;
+}
+
+
+/**
+ * Return the number of frequencies, the k-th one is w = 2*pi*k/L.
+ */
+template <typename Type>
+inline int CSD<Type>::freqs() const
+{
+    return nFreq;
+}
+
+
+/**
+ * Return the number of segments that have been averaged.
+ */
+template <typename Type>
+inline int CSD<Type>::segments() const
+{
+    return nSegs;
+}
+
+
+/**
+ * Index of channel pair (i,j), i <= j, in the upper triangle.
+ */
+template <typename Type>
+inline int CSD<Type>::pairIndex( int i, int j ) const
+{
+    return i*nChan - i*(i-1)/2 + j-i;
+}
+
+
+/**
+ * Auto power spectral density of channel "i".
+ */
+template <typename Type>
+Vector<Type> CSD<Type>::getPSD( int i ) const
+{
+    assert( 0 <= i && i < nChan );
+
+    Vector<Type> Pxx(nFreq);
+    if( nSegs == 0 )
+        return Pxx;
+
+    Type scale = 1 / (nSegs*winPow);
+    const Type *sr = Sre[pairIndex(i,i)];
+    for( int k=0; k<nFreq; ++k )
+        Pxx[k] = sr[k] * scale;
+
+    return Pxx;
+}
+
+
+/**
+ * Cross power spectral density between channel "i" and channel "j".
+ */
+template <typename Type>
+Vector< complex<Type> > CSD<Type>::getCSD( int i, int j ) const
+{
+    assert( 0 <= i && i < nChan );
+    assert( 0 <= j && j < nChan );
+
+    Vector< complex<Type> > Pxy(nFreq);
+    if( nSegs == 0 )
+        return Pxy;
+
+    Type scale = 1 / (nSegs*winPow);
+    int p = ( i <= j ) ? pairIndex(i,j) : pairIndex(j,i);
+    const Type *sr = Sre[p],
+               *si = Sim[p];
+
+    // Sji = conj(Sij)
+    Type sign = ( i <= j ) ? Type(1) : Type(-1);
+    for( int k=0; k<nFreq; ++k )
+        Pxy[k] = complex<Type>( sr[k]*scale, sign*si[k]*scale );
+
+    return Pxy;
+}
+
+
+/**
+ * The C-by-C Hermitian cross spectral matrix at the k-th frequency.
+ */
+template <typename Type>
+Matrix< complex<Type> > CSD<Type>::getCSM( int k ) const
+{
+    assert( 0 <= k && k < nFreq );
+
+    Matrix< complex<Type> > Sk( nChan, nChan );
+    if( nSegs == 0 )
+        return Sk;
+
+    Type scale = 1 / (nSegs*winPow);
+    for( int p=0; p<nPairs; ++p )
+    {
+        int i = pairI[p],
+            j = pairJ[p];
+        Sk[i][j] = complex<Type>( Sre[p][k]*scale, Sim[p][k]*scale );
+        Sk[j][i] = conj( Sk[i][j] );
+    }
+
+    return Sk;
+}
+
+
+/**
+ * Magnitude squared coherence between channel "i" and channel "j".
+ */
+template <typename Type>
+Vector<Type> CSD<Type>::getCoherence( int i, int j ) const
+{
+    assert( 0 <= i && i < nChan );
+    assert( 0 <= j && j < nChan );
+
+    Vector<Type> Cxy(nFreq);
+    int p = ( i <= j ) ? pairIndex(i,j) : pairIndex(j,i);
+    const Type *sr = Sre[p],
+               *si = Sim[p],
+               *pi = Sre[pairIndex(i,i)],
+               *pj = Sre[pairIndex(j,j)];
+
+    for( int k=0; k<nFreq; ++k )
+    {
+        Type den = pi[k]*pj[k];
+        Cxy[k] = ( den > 0 ) ? (sr[k]*sr[k]+si[k]*si[k])/den : Type(0);
+    }
+
+    return Cxy;
+}
+
+
+/**
+ * Phase (radian) of the cross spectral density between channel "i" and
+ * channel "j".
+ */
+template <typename Type>
+Vector<Type> CSD<Type>::getPhase( int i, int j ) const
+{
+    assert( 0 <= i && i < nChan );
+    assert( 0 <= j && j < nChan );
+
+    Vector<Type> phase(nFreq);
+    int p = ( i <= j ) ? pairIndex(i,j) : pairIndex(j,i);
+    Type sign = ( i <= j ) ? Type(1) : Type(-1);
+    const Type *sr = Sre[p],
+               *si = Sim[p];
+
+    for( int k=0; k<nFreq; ++k )
+        phase[k] = atan2( sign*si[k], sr[k] );
+
+    return phase;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                    csd.h
+ *
+ * Multi-channel cross power spectral density and coherence.
+ *
+ * For a C-channel signal, this class estimates the C-by-C cross spectral
+ * matrix S(f) by the Welch method, i.e. the averaged products of the Fourier
+ * transforms of the windowed segments, Sij(f) = E{ Xi(f)*conj(Xj(f)) }.
+ * Each channel segment is transformed only once, and because S(f) is
+ * Hermitian, only the upper triangle (C*(C+1)/2 channel pairs) is
+ * accumulated. From S(f) the magnitude squared coherence
+ *      Cij(f) = |Sij(f)|^2 / ( Sii(f)*Sjj(f) )
+ * and the cross phase arg(Sij(f)) are obtained.
+ *
+ * The spectra are stored as separated real and imaginary arrays, and several
+ * segments are accumulated together for each channel pair, so the inner
+ * loops run over contiguous memory and can be vectorized by the compiler.
+ * If OpenMP is enabled, the FFTs and the channel pairs are computed in
+ * parallel.
+ *
+ * The signals are real, so only the frequencies w = 0, 2*pi/L, ..., pi are
+ * kept, and Sii(f) is the same as "welchPSE" at these frequencies.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef CSD_H
+#define CSD_H
+
+
+#include <vector.h>
+#include <matrix.h>
+#include <fft.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class CSD
+    {
+
+    public:
+
+        CSD( int C, const Vector<Type> &wn, int K, int L );
+        ~CSD();
+
+        void reset();
+        void estimate( const Matrix<Type> &xn );
+
+        int channels() const;
+        int freqs() const;
+        int segments() const;
+
+        Vector<Type> getPSD( int i ) const;
+        Vector< complex<Type> > getCSD( int i, int j ) const;
+        Matrix< complex<Type> > getCSM( int k ) const;
+        Vector<Type> getCoherence( int i, int j ) const;
+        Vector<Type> getPhase( int i, int j ) const;
+
+    private:
+
+        // the number of segments accumulated together
+        static const int BLOCK = 8;
+
+        int nChan;
+        int nPairs;
+        int nFreq;
+        int nFFT;
+        int step;
+        int nSegs;
+
+        Vector<Type> win;
+        Type winPow;
+
+        // channel indices of each pair in the upper triangle
+        Vector<int> pairI, pairJ;
+
+        // spectra of a block of segments, row b*C+c is the channel c
+        // of the b-th segment
+        Matrix<Type> Xre, Xim;
+
+        // accumulated cross spectra, one row for one channel pair
+        Matrix<Type> Sre, Sim;
+
+        int pairIndex( int i, int j ) const;
+
+    };
+    // class CSD
+
+
+    #include <csd-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// CSD_H
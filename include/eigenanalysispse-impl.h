@@ -79,6 +79,46 @@ Vector<Type> caponPSE( const Vector<Type> &xn, int M, int L )
 }
 
 
+/**
+ * Sum of the power spectrum of the jth (j0 <= j < j1) column of V,
+ *      Sv[k] = sum_j | sum_i V[i][j]*exp(-j*2*pi*k*i/L) |^2
+ * at L frequencies. The columns are folded modulo L, and two real columns
+ * are packed into one complex sequence, thus only one FFT of length L is
+ * needed for every two eigenvectors.
+ */
+template <typename Type>
+static Vector<Type> eigvecSpectrum( const Matrix<Type> &V, int j0, int j1,
+                                    int L )
+{
+    int M = V.rows();
+    Vector<Type> Sv(L);
+    Vector< complex<Type> > zn(L), Zk(L);
+
+    for( int j=j0; j<j1; j+=2 )
+    {
+        bool pair = ( j+1 < j1 );
+
+        zn = complex<Type>(0);
+        for( int i=0; i<M; ++i )
+            zn[i%L] += complex<Type>( V[i][j], pair ? V[i][j+1] : Type(0) );
+        Zk = fft(zn);
+
+        if( pair )
+        {
+            // |Va[k]|^2 + |Vb[k]|^2 = ( |Z[k]|^2 + |Z[L-k]|^2 ) / 2
+            Sv[0] += norm(Zk[0]);
+            for( int k=1; k<L; ++k )
+                Sv[k] += Type(0.5) * ( norm(Zk[k]) + norm(Zk[L-k]) );
+        }
+        else
+            for( int k=0; k<L; ++k )
+                Sv[k] += norm(Zk[k]);
+    }
+
+    return Sv;
+}
+
+
 /**
  * The MUSIC method for spectral estimation.
  * xn       : input signal
@@ -96,47 +136,36 @@ Vector<Type> musicPSE( const Vector<Type> &xn, int M, int p, int L )
     assert( M < N );
     assert( p < M );
 
-    Type  Tre, Tim, sum;
-    Vector<Type> rm(M), tm(M),
-                 Ere(M), Eim(M), Vi(M),
-                 wk(M), Px(L);
+    Vector<Type> Px(L);
 
     // auto-correlation matrix R
-    for( int i=0; i<M; ++i )
-    {
-        tm[i] = Type(i);
-        for( int k=0; k<N-i; ++k )
-            rm[i] += xn[k+i]*xn[k];
-    }
-    rm /= Type(N-M);
+    Vector<Type> rm = corrLags( xn, M-1, "none" ) / Type(N-M);
     Matrix<Type> Rx = toeplitz(rm);
 
-    SVD<Type> svd;
-    svd.dec(Rx);
-    Matrix<Type> U = svd.getU();
-
-    for( int k=0; k<L; ++k )
+    // Because the eigenvectors form an orthonormal basis and ||E(omega)||^2
+    // = M, the noise-subspace projection equals M minus the signal-subspace
+    // one. So only the smaller one of the two subspaces is computed.
+    Lanczos<Type> lcz;
+    if( p <= M-p )
     {
-        // real part and imaginary part of E(omega)
-        wk = Type( TWOPI*k/L ) * tm;
-        Ere = cos( wk );
-        Eim = sin( wk );
-
-        // Tre = Ere*Vi, Tim = Eim*Vi;
-        sum = 0;
-        for( int i=p; i<M; ++i )
+        if( p > 0 )
         {
-            Vi = U.getColumn(i);
-            Tre = dotProd( Ere, Vi );
-            Tim = dotProd( Eim, Vi );
-            sum += Tre*Tre + Tim*Tim;
+            lcz.dec( Rx, p, "largest" );
+            Px = eigvecSpectrum( lcz.getV(), 0, p, L );
         }
-
-        // spectrum
-//        Px[k] = 1 / ( sum );
-        Px[k] = -10*log10(sum);
+        Px = Type(M) - Px;
+    }
+    else
+    {
+        lcz.dec( Rx, M-p, "smallest" );
+        Px = eigvecSpectrum( lcz.getV(), 0, M-p, L );
     }
 
+    // spectrum
+    Type floor = Type(M) * Type(EPS);
+    for( int k=0; k<L; ++k )
+        Px[k] = -10*log10( max( Px[k], floor ) );
+
     return Px;
 }
 
@@ -158,41 +187,29 @@ Vector<Type> pisarenkoPSE( const Vector<Type> &xn, int M, int p, int L )
     assert( M < N );
     assert( p < M );
 
-    Type  Tre, Tim;
-    Vector<Type> rm(M), tm(M),
-                 Ere(M), Eim(M), Vi(M),
-                 wk(M), Px(L);
+    Vector<Type> Px(L);
 
     // auto-correlation matrix R
-    for( int i=0; i<M; ++i )
-    {
-        tm[i] = Type(i);
-        for( int k=0; k<N-i; ++k )
-            rm[i] += xn[k+i]*xn[k];
-    }
-    rm /= Type(N-M);
+    Vector<Type> rm = corrLags( xn, M-1, "none" ) / Type(N-M);
     Matrix<Type> Rx = toeplitz(rm);
 
-    SVD<Type> svd;
-    svd.dec(Rx);
-    Matrix<Type> U = svd.getU();
-
-    for( int k=0; k<L; ++k )
+    // the (p+1)th largest eigenvector, computed from the nearer end
+    Lanczos<Type> lcz;
+    if( p+1 <= M-p )
     {
-        // real part and imaginary part of E(omega)
-        wk = Type( TWOPI*k/L ) * tm;
-        Ere = cos( wk );
-        Eim = sin( wk );
-
-        // Tre = Ere*Vi, Tim = Eim*Vi;
-        Vi = U.getColumn(p);
-        Tre = dotProd( Ere, Vi );
-        Tim = dotProd( Eim, Vi );
-
-        // spectrum
-//        Px[k] = 1 / ( Tre*Tre + Tim*Tim );
-        Px[k] = -10*log10(Tre*Tre+Tim*Tim);
+        lcz.dec( Rx, p+1, "largest" );
+        Px = eigvecSpectrum( lcz.getV(), p, p+1, L );
     }
+    else
+    {
+        lcz.dec( Rx, M-p, "smallest" );
+        Px = eigvecSpectrum( lcz.getV(), M-p-1, M-p, L );
+    }
+
+    // spectrum
+    Type floor = Type(EPS);
+    for( int k=0; k<L; ++k )
+        Px[k] = -10*log10( max( Px[k], floor ) );
 
     return Px;
 }
@@ -213,20 +230,17 @@ Vector<Type> espritPSE( Vector<Type> &xn, int M, int p )
     assert( M < N );
     assert( p < M );
 
-    Vector<Type> rm(M), fk(p);
+    Vector<Type> fk(p);
     Matrix<Type> S1(M-1,p), S2(M-1,p);
 
     // get the auto-correlation matrix
-    for( int i=0; i<M; ++i )
-        for( int k=0; k<N-i; ++k )
-            rm[i] += xn[k+i]*xn[k];
-    rm /= Type(N-M);
+    Vector<Type> rm = corrLags( xn, M-1, "none" ) / Type(N-M);
     Matrix<Type> Rx = toeplitz(rm);
 
-    // get the eigendecomposition of R, use svd because it sorts eigenvalues
-    SVD<Type> svd;
-    svd.dec(Rx);
-    Matrix<Type> U = svd.getU();
+    // only the signal-subspace, sorted in descending order, is needed
+    Lanczos<Type> lcz;
+    lcz.dec( Rx, p, "largest" );
+    Matrix<Type> U = lcz.getV();
 
     // compute S1 and S2
     for( int i=0; i<M-1; ++i )
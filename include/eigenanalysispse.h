@@ -42,6 +42,10 @@
  * This file also provide the Capon's maximum likehood method or minimum
  * variance method for specturm estimation.
  *
+ * Only the few eigenvectors of the signal-subspace (or the noise-subspace,
+ * whichever is smaller) are computed by Lanczos algorithm, and the
+ * pseudo-spectrum is evaluated by FFTs of these eigenvectors.
+ *
  * Zhang Ming, 2010-11, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -55,6 +59,9 @@
 #include <linequs1.h>
 #include <svd.h>
 #include <evd.h>
+#include <lanczos.h>
+#include <fft.h>
+#include <correlation.h>
 
 
 namespace splab
@@ -71,6 +78,9 @@ namespace splab
 
     template<typename Type> int orderEst( const Vector<Type>&, int );
 
+    template<typename Type> static Vector<Type> eigvecSpectrum( const Matrix<Type>&,
+                                                                int, int, int );
+
 
     #include <eigenanalysispse-impl.h>
 
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                fdaf-impl.h
+ *
+ * Implementation for FDAF class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * length      : the number of taps
+ * blockLen    : block length, must be a power of 2
+ * mu          : normalized step size, 0 < mu < 2/P
+ * beta        : forgetting factor of the per-bin power estimate
+ * delta       : regularization of the per-bin power
+ * constrained : keep the gradient constraint or not
+ */
+template <typename Type>
+FDAF<Type>::FDAF( int length, int blockLen, const Type &mu,
+                  const Type &beta, const Type &delta, bool constrained )
+           : L(length), B(blockLen), N(2*blockLen),
+             P( (length+blockLen-1)/blockLen ),
+             mu(mu), beta(beta), delta(delta), constrained(constrained),
+             head(0), nBlocks(0), xbuf(2*blockLen)
+{
+    assert( L > 0 );
+    assert( isPower2(B) );
+    assert( 0 <= beta && beta < 1 );
+
+    Xk.resize( P, B+1 );
+    Wk.resize( P, B+1 );
+    Pk.resize( B+1 );
+    Ek.resize( B+1 );
+    zn.resize( N );
+
+    reset();
+}
+
+template <typename Type>
+FDAF<Type>::~FDAF()
+{
+}
+
+
+/**
+ * Clear the weights and all the internal states.
+ */
+template <typename Type>
+void FDAF<Type>::reset()
+{
+    head = 0;
+    nBlocks = 0;
+
+    xbuf = Type(0);
+    Xk = complex<Type>(0);
+    Wk = complex<Type>(0);
+    Pk = Type(0);
+}
+
+
+/**
+ * Get the filter length and the block length.
+ */
+template <typename Type>
+inline int FDAF<Type>::length() const
+{
+    return L;
+}
+
+template <typename Type>
+inline int FDAF<Type>::blockLength() const
+{
+    return B;
+}
+
+
+/**
+ * Filtering the input "xn" and updating the weights by the desired signal
+ * "dn", the output is stored in "yn". The length of "xn" must be a multiple
+ * of the block length.
+ */
+template <typename Type>
+void FDAF<Type>::adapt( const Vector<Type> &xn, const Vector<Type> &dn,
+                        Vector<Type> &yn )
+{
+    int len = xn.size();
+
+    assert( dn.size() == len );
+    assert( len%B == 0 );
+
+    if( yn.size() != len )
+        yn.resize(len);
+
+    for( int i=0; i<len; i+=B )
+        block( &xn[i], &dn[i], &yn[i] );
+}
+
+
+/**
+ * Process one block of B samples.
+ */
+template <typename Type>
+void FDAF<Type>::block( const Type *x, const Type *d, Type *y )
+{
+    // update the last 2*B input samples
+    for( int i=0; i<B; ++i )
+    {
+        xbuf[i] = xbuf[i+B];
+        xbuf[i+B] = x[i];
+    }
+
+    // spectrum of the input, which is the newest in the delay line
+    for( int i=0; i<N; ++i )
+        zn[i] = xbuf[i];
+    fft.fft(zn);
+
+    head = ( head == 0 ) ? P-1 : head-1;
+    complex<Type> *X0 = Xk[head];
+    for( int k=0; k<=B; ++k )
+        X0[k] = zn[k];
+
+    // recursive power estimate, with the bias of zero initial value removed
+    nBlocks++;
+    Type scale = 1 / ( 1 - pow(beta,Type(nBlocks)) );
+    for( int k=0; k<=B; ++k )
+        Pk[k] = beta*Pk[k] + (1-beta)*norm(X0[k]);
+
+    // output spectrum, Y = sum_p W_p .* X_p
+    for( int k=0; k<=B; ++k )
+        Ek[k] = 0;
+    for( int p=0; p<P; ++p )
+    {
+        const complex<Type> *Xp = Xk[(head+p)%P],
+                            *Wp = Wk[p];
+        for( int k=0; k<=B; ++k )
+            Ek[k] += Wp[k]*Xp[k];
+    }
+
+    // the last B samples of the circular convolution are the output
+    for( int k=0; k<=B; ++k )
+        zn[k] = Ek[k];
+    for( int k=1; k<B; ++k )
+        zn[N-k] = conj(Ek[k]);
+    fft.ifft(zn);
+    for( int i=0; i<B; ++i )
+        y[i] = zn[i+B].real();
+
+    // error spectrum E = fft([0, e]), normalized by the power
+    for( int i=0; i<B; ++i )
+    {
+        zn[i] = 0;
+        zn[i+B] = d[i]-y[i];
+    }
+    fft.fft(zn);
+    for( int k=0; k<=B; ++k )
+        Ek[k] = mu * zn[k] / ( scale*Pk[k] + delta );
+
+    // gradients, G_p = conj(X_p) .* E, are accumulated into the weights
+    for( int p=0; p<P; ++p )
+    {
+        const complex<Type> *Xp = Xk[(head+p)%P];
+        complex<Type> *Wp = Wk[p];
+        for( int k=0; k<=B; ++k )
+            Wp[k] += conj(Xp[k]) * Ek[k];
+    }
+
+    // keep the last B taps of each partition zero
+    if( constrained )
+        for( int p=0; p<P; p+=2 )
+            constrain( p, ( p+1 < P ) ? p+1 : -1 );
+}
+
+
+/**
+ * Apply the gradient constraint to partitions p and q (q = -1 means none).
+ * The weight spectra are real sequences' half spectra, so two of them are
+ * transformed by one complex FFT pair as Z = W_p + j*W_q.
+ */
+template <typename Type>
+void FDAF<Type>::constrain( int p, int q )
+{
+    complex<Type> *Wp = Wk[p],
+                  *Wq = ( q < 0 ) ? 0 : Wk[q];
+    complex<Type> J( 0, 1 );
+
+    zn[0] = Wp[0];
+    zn[B] = Wp[B];
+    for( int k=1; k<B; ++k )
+    {
+        zn[k] = Wp[k];
+        zn[N-k] = conj(Wp[k]);
+    }
+    if( Wq )
+    {
+        zn[0] += J*Wq[0];
+        zn[B] += J*Wq[B];
+        for( int k=1; k<B; ++k )
+        {
+            zn[k] += J*Wq[k];
+            zn[N-k] += J*conj(Wq[k]);
+        }
+    }
+
+    // w_p + j*w_q in time domain, cut the last B taps
+    fft.ifft(zn);
+    for( int i=B; i<N; ++i )
+        zn[i] = 0;
+    fft.fft(zn);
+
+    // separate the two spectra
+    Wp[0] = zn[0].real();
+    Wp[B] = zn[B].real();
+    for( int k=1; k<B; ++k )
+        Wp[k] = Type(0.5) * ( zn[k] + conj(zn[N-k]) );
+    if( Wq )
+    {
+        Wq[0] = zn[0].imag();
+        Wq[B] = zn[B].imag();
+        for( int k=1; k<B; ++k )
+            Wq[k] = Type(-0.5) * J * ( zn[k] - conj(zn[N-k]) );
+    }
+}
+
+
+/**
+ * Get the time domain weights (the impulse response) of the filter.
+ */
+template <typename Type>
+Vector<Type> FDAF<Type>::getWeights() const
+{
+    Vector<Type> wn(L);
+    Vector< complex<Type> > Zk(N);
+    FFTMR<Type> ft;
+
+    for( int p=0; p<P; ++p )
+    {
+        const complex<Type> *Wp = Wk[p];
+        Zk[0] = Wp[0];
+        Zk[B] = Wp[B];
+        for( int k=1; k<B; ++k )
+        {
+            Zk[k] = Wp[k];
+            Zk[N-k] = conj(Wp[k]);
+        }
+        ft.ifft(Zk);
+
+        for( int i=0; i<B && p*B+i<L; ++i )
+            wn[p*B+i] = Zk[i].real();
+    }
+
+    return wn;
+}
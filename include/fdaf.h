@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                   fdaf.h
+ *
+ * Frequency-Domain (partitioned block) LMS Adaptive Filter.
+ *
+ * For long filters, such as the acoustic echo paths of thousands of taps,
+ * the per-sample updating of "lms" is too expensive. The frequency-domain
+ * adaptive filter processes the signal in blocks of B samples: both the
+ * filtering and the gradient correlation are done by overlap-save with
+ * FFTs of length 2*B, so the cost per sample is O(log B) instead of O(L).
+ *
+ * The L taps are split into P = ceil(L/B) partitions of B taps, and the
+ * spectra of the last P input blocks are kept in a frequency-domain delay
+ * line. Choosing B = L gives the classical FDAF, while a small B reduces
+ * the latency (one block) at the price of P products per frequency bin.
+ *
+ * The step size of each frequency bin is normalized by a recursive
+ * estimate of the input power in that bin, which makes the convergence
+ * nearly independent of the input spectrum. The gradient constraint (the
+ * weights of a partition are kept B taps long) can be switched off to save
+ * two FFTs per partition, at the expense of a slightly biased solution.
+ *
+ * The block length must be a power of 2, and the input signals must be
+ * given in multiples of the block length.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef FDAF_H
+#define FDAF_H
+
+
+#include <vector.h>
+#include <matrix.h>
+#include <fftmr.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class FDAF
+    {
+
+    public:
+
+        FDAF( int length, int blockLen, const Type &mu,
+              const Type &beta=Type(0.9), const Type &delta=Type(1.0e-6),
+              bool constrained=true );
+        ~FDAF();
+
+        void reset();
+
+        void adapt( const Vector<Type> &xn, const Vector<Type> &dn,
+                    Vector<Type> &yn );
+
+        int length() const;
+        int blockLength() const;
+        Vector<Type> getWeights() const;
+
+    private:
+
+        // filter length, block length, FFT length and partition number
+        int L,
+            B,
+            N,
+            P;
+
+        // step size, forgetting factor of power, regularization
+        Type mu,
+             beta,
+             delta;
+        bool constrained;
+
+        // the index of the latest block in the spectra delay line, and the
+        // number of blocks have been processed
+        int head;
+        long nBlocks;
+
+        // the last 2*B input samples
+        Vector<Type> xbuf;
+
+        // half spectra (B+1 bins) of input blocks and weight partitions
+        Matrix< complex<Type> > Xk;
+        Matrix< complex<Type> > Wk;
+
+        // per-bin input power, error spectrum and FFT work buffer
+        Vector<Type> Pk;
+        Vector< complex<Type> > Ek;
+        Vector< complex<Type> > zn;
+
+        FFTMR<Type> fft;
+
+        void block( const Type *x, const Type *d, Type *y );
+        void constrain( int p, int q );
+
+    };
+    // class FDAF
+
+
+    #include <fdaf-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// FDAF_H
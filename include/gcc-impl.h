@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                  gcc-impl.h
+ *
+ * Implementation for GCC class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * C        : the number of channels
+ * N        : frame length
+ * M        : the maximum lag, the lags -M, ..., M are computed
+ * weight   : "none", "phat", "scot" or "roth"
+ * a        : averaging factor of spectra, 0 <= a < 1
+ */
+template <typename Type>
+GCC<Type>::GCC( int C, int N, int M, const string &weight, const Type &a )
+: nChan(C), nPairs(C*(C-1)/2), frameLen(N), maxLag(M), alpha(a)
+{
+    assert( C >= 2 );
+    assert( 0 <= M && M < N );
+    assert( Type(0) <= a && a < Type(1) );
+
+    if( weight == "none" )
+        wType = 0;
+    else if( weight == "phat" )
+        wType = 1;
+    else if( weight == "scot" )
+        wType = 2;
+    else if( weight == "roth" )
+        wType = 3;
+    else
+    {
+        cerr << "No such weighting function, \"phat\" is used!" << endl;
+        wType = 1;
+    }
+
+    // the lags -M, ..., M are free of circular aliasing if L >= N+M
+    nFFT = 2;
+    while( nFFT < N+M )
+        nFFT *= 2;
+    nFreq = nFFT/2 + 1;
+
+    pairI.resize(nPairs);
+    pairJ.resize(nPairs);
+    for( int i=0, p=0; i<C; ++i )
+        for( int j=i+1; j<C; ++j, ++p )
+        {
+            pairI[p] = i;
+            pairJ[p] = j;
+        }
+
+    Xre.resize( C, nFreq );
+    Xim.resize( C, nFreq );
+    Pxx.resize( C, nFreq );
+    Gre.resize( nPairs, nFreq );
+    Gim.resize( nPairs, nFreq );
+    Rxy.resize( nPairs, 2*M+1 );
+
+    // a short lag window is cheaper to sum up than an inverse FFT
+    direct = ( 2*(M+1) <= fastLog2(nFFT) );
+    if( direct )
+    {
+        cosT.resize( M+1, nFreq );
+        sinT.resize( M+1, nFreq );
+        for( int t=0; t<=M; ++t )
+            for( int k=0; k<nFreq; ++k )
+            {
+                Type c = ( k == 0 || k == nFFT/2 ) ? Type(1) : Type(2),
+                     w = Type(TWOPI) * ((k*t)%nFFT) / nFFT;
+                cosT[t][k] = c * cos(w) / nFFT;
+                sinT[t][k] = c * sin(w) / nFFT;
+            }
+    }
+
+    reset();
+}
+
+template <typename Type>
+GCC<Type>::~GCC()
+{
+}
+
+
+/**
+ * Clear the averaged spectra.
+ */
+template <typename Type>
+void GCC<Type>::reset()
+{
+    Pxx = Type(0);
+    Gre = Type(0);
+    Gim = Type(0);
+    Rxy = Type(0);
+    first = true;
+}
+
+
+/**
+ * Estimate the generalized cross-correlations of all channel pairs from a
+ * C-by-N frame, each row is one channel.
+ */
+template <typename Type>
+void GCC<Type>::estimate( const Matrix<Type> &xn )
+{
+    assert( xn.rows() == nChan );
+    assert( xn.cols() == frameLen );
+
+    int C = nChan,
+        N = frameLen,
+        L = nFFT,
+        H = nFreq,
+        M = maxLag;
+    Type a = first ? Type(0) : alpha,
+         b = 1 - a;
+
+    // transform two channels by one complex FFT
+    #pragma omp parallel
+    {
+        Vector< complex<Type> > zn(L);
+        FFTMR<Type> dft;
+
+        #pragma omp for
+        for( int c=0; c<C; c+=2 )
+        {
+            bool two = ( c+1 < C );
+            for( int i=0; i<N; ++i )
+                zn[i] = complex<Type>( xn[c][i], two ? xn[c+1][i] : 0 );
+            for( int i=N; i<L; ++i )
+                zn[i] = 0;
+            dft.fft( zn );
+
+            // X0 = ( Z(k)+conj(Z(L-k)) )/2, X1 = ( Z(k)-conj(Z(L-k)) )/(2j)
+            Type *x0r = Xre[c], *x0i = Xim[c], *p0 = Pxx[c];
+            for( int k=0; k<H; ++k )
+            {
+                Type zr = zn[k].real(),
+                     zi = zn[k].imag(),
+                     cr = zn[(L-k)%L].real(),
+                     ci = -zn[(L-k)%L].imag();
+                x0r[k] = (zr+cr) / 2;
+                x0i[k] = (zi+ci) / 2;
+                p0[k] = a*p0[k] + b*( x0r[k]*x0r[k] + x0i[k]*x0i[k] );
+                if( two )
+                {
+                    Type *x1r = Xre[c+1], *x1i = Xim[c+1], *p1 = Pxx[c+1];
+                    x1r[k] = (zi-ci) / 2;
+                    x1i[k] = (cr-zr) / 2;
+                    p1[k] = a*p1[k] + b*( x1r[k]*x1r[k] + x1i[k]*x1i[k] );
+                }
+            }
+        }
+    }
+
+    // weighted cross spectra and the lags, two pairs a time
+    #pragma omp parallel
+    {
+        Vector< complex<Type> > zn(L);
+        Vector<Type> wr(2*H), wi(2*H);
+        FFTMR<Type> dft;
+
+        #pragma omp for schedule(dynamic)
+        for( int p0=0; p0<nPairs; p0+=2 )
+        {
+            int np = min( 2, nPairs-p0 );
+
+            for( int s=0; s<np; ++s )
+            {
+                int p = p0+s;
+                const Type *ar = Xre[pairI[p]], *ai = Xim[pairI[p]],
+                           *br = Xre[pairJ[p]], *bi = Xim[pairJ[p]],
+                           *pa = Pxx[pairI[p]], *pb = Pxx[pairJ[p]];
+                Type *gr = Gre[p], *gi = Gim[p],
+                     *vr = &wr[s*H], *vi = &wi[s*H];
+
+                for( int k=0; k<H; ++k )
+                {
+                    gr[k] = a*gr[k] + b*( ar[k]*br[k] + ai[k]*bi[k] );
+                    gi[k] = a*gi[k] + b*( ai[k]*br[k] - ar[k]*bi[k] );
+                }
+
+                for( int k=0; k<H; ++k )
+                {
+                    Type den = 1;
+                    if( wType == 1 )
+                        den = sqrt( gr[k]*gr[k] + gi[k]*gi[k] );
+                    else if( wType == 2 )
+                        den = sqrt( pa[k]*pb[k] );
+                    else if( wType == 3 )
+                        den = pa[k];
+
+                    Type w = ( den > 0 ) ? 1/den : Type(0);
+                    vr[k] = w * gr[k];
+                    vi[k] = w * gi[k];
+                }
+            }
+
+            if( direct )
+            {
+                for( int s=0; s<np; ++s )
+                {
+                    const Type *vr = &wr[s*H], *vi = &wi[s*H];
+                    Type *r = Rxy[p0+s] + M;
+                    for( int t=0; t<=M; ++t )
+                    {
+                        const Type *ct = cosT[t], *st = sinT[t];
+                        Type re = 0,
+                             im = 0;
+                        for( int k=0; k<H; ++k )
+                        {
+                            re += vr[k]*ct[k];
+                            im += vi[k]*st[k];
+                        }
+                        r[t] = re - im;
+                        r[-t] = re + im;
+                    }
+                }
+            }
+            else
+            {
+                // Z = W0 + j*W1, the real and imaginary parts of its inverse
+                // transform are the two correlations
+                const Type *v0r = &wr[0], *v0i = &wi[0],
+                           *v1r = &wr[H], *v1i = &wi[H];
+                if( np == 1 )
+                    for( int k=0; k<H; ++k )
+                        wr[H+k] = wi[H+k] = 0;
+
+                for( int k=0; k<H; ++k )
+                    zn[k] = complex<Type>( v0r[k]-v1i[k], v0i[k]+v1r[k] );
+                for( int k=1; k<H-1; ++k )
+                    zn[L-k] = complex<Type>( v0r[k]+v1i[k], v1r[k]-v0i[k] );
+                dft.ifft( zn );
+
+                for( int s=0; s<np; ++s )
+                {
+                    Type *r = Rxy[p0+s] + M;
+                    for( int t=-M; t<=M; ++t )
+                    {
+                        const complex<Type> &z = zn[ (t<0) ? L+t : t ];
+                        r[t] = ( s == 0 ) ? z.real() : z.imag();
+                    }
+                }
+            }
+        }
+    }
+
+    first = false;
+}
+
+
+/**
+ * Get the number of channels, channel pairs and lags.
+ */
+template <typename Type>
+inline int GCC<Type>::channels() const
+{
+    return nChan;
+}
+
+template <typename Type>
+inline int GCC<Type>::pairs() const
+{
+    return nPairs;
+}
+
+template <typename Type>
+inline int GCC<Type>::lags() const
+{
+    return 2*maxLag+1;
+}
+
+
+/**
+ * The row of channel pair (i,j), i < j.
+ */
+template <typename Type>
+inline int GCC<Type>::pairIndex( int i, int j ) const
+{
+    return i*nChan - i*(i+1)/2 + j-i-1;
+}
+
+
+/**
+ * Get the generalized cross-correlation Rij(t), t = -maxLag, ..., maxLag.
+ */
+template <typename Type>
+Vector<Type> GCC<Type>::getCorr( int i, int j ) const
+{
+    assert( 0 <= i && i < nChan );
+    assert( 0 <= j && j < nChan );
+    assert( i != j );
+
+    int L = 2*maxLag+1;
+    Vector<Type> rn(L);
+
+    if( i < j )
+    {
+        const Type *r = Rxy[pairIndex(i,j)];
+        for( int t=0; t<L; ++t )
+            rn[t] = r[t];
+    }
+    else
+    {
+        const Type *r = Rxy[pairIndex(j,i)];
+        for( int t=0; t<L; ++t )
+            rn[t] = r[L-1-t];
+    }
+
+    return rn;
+}
+
+
+/**
+ * The lag of the peak of the p-th pair, refined by fitting a parabola
+ * through the peak and its two neighbours.
+ */
+template <typename Type>
+Type GCC<Type>::peakDelay( int p, bool interp ) const
+{
+    const Type *r = Rxy[p];
+    int L = 2*maxLag+1,
+        m = 0;
+    for( int t=1; t<L; ++t )
+        if( r[t] > r[m] )
+            m = t;
+
+    Type d = Type( m-maxLag );
+    if( interp && 0 < m && m < L-1 )
+    {
+        Type den = r[m-1] - 2*r[m] + r[m+1];
+        if( den < 0 )
+            d += ( r[m-1]-r[m+1] ) / (2*den);
+    }
+
+    return d;
+}
+
+
+/**
+ * Get the delay of the channel i relative to the channel j in samples.
+ */
+template <typename Type>
+Type GCC<Type>::getDelay( int i, int j, bool interp ) const
+{
+    assert( 0 <= i && i < nChan );
+    assert( 0 <= j && j < nChan );
+    assert( i != j );
+
+    if( i < j )
+        return peakDelay( pairIndex(i,j), interp );
+    else
+        return -peakDelay( pairIndex(j,i), interp );
+}
+
+
+/**
+ * Get the delays of all pairs (0,1), (0,2), ..., (0,C-1), (1,2), ...
+ */
+template <typename Type>
+Vector<Type> GCC<Type>::getDelays( bool interp ) const
+{
+    Vector<Type> dn(nPairs);
+    for( int p=0; p<nPairs; ++p )
+        dn[p] = peakDelay( p, interp );
+
+    return dn;
+}
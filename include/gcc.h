@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                    gcc.h
+ *
+ * Generalized cross-correlation for multi-channel time delay estimation.
+ *
+ * For the channel pair (i,j), the generalized cross-correlation is
+ *      Rij(t) = IDFT{ W(f) * Gij(f) },     Gij(f) = Xi(f)*conj(Xj(f)),
+ * where Rij(t) = sum{ xi(u)*xj(u-t) } for W(f) = 1, the same definition as
+ * "fastCorr", and the weighting function W(f) is one of
+ * "none"   : 1, the plain cross-correlation;
+ * "phat"   : 1 / |Gij(f)|, phase transform;
+ * "scot"   : 1 / sqrt( Gii(f)*Gjj(f) ), smoothed coherence transform;
+ * "roth"   : 1 / Gii(f), Roth processor.
+ * The spectra can be averaged over frames exponentially (Gij <- alpha*Gij +
+ * (1-alpha)*Xi*conj(Xj)), or computed from the current frame (alpha = 0).
+ * The delay of a pair is the lag of the peak of Rij(t), which is positive if
+ * the channel i lags behind the channel j, and can be refined to fractional
+ * samples by parabolic interpolation.
+ *
+ * Each channel frame is transformed only once for all C*(C-1)/2 pairs (two
+ * real channels by one complex FFT), and only the lags -maxLag, ..., maxLag
+ * are computed: directly from the half spectrum for a short lag window, or
+ * by inverse FFT with two pairs packed into one complex FFT. The spectra are
+ * stored as separated real and imaginary arrays so that the inner loops can
+ * be vectorized by the compiler. If OpenMP is enabled, the FFTs and the
+ * channel pairs are computed in parallel.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef GCC_H
+#define GCC_H
+
+
+#include <string>
+#include <vector.h>
+#include <matrix.h>
+#include <fftmr.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class GCC
+    {
+
+    public:
+
+        GCC( int C, int N, int maxLag, const string &weight="phat",
+             const Type &alpha=Type(0) );
+        ~GCC();
+
+        void reset();
+        void estimate( const Matrix<Type> &xn );
+
+        int channels() const;
+        int pairs() const;
+        int lags() const;
+
+        Vector<Type> getCorr( int i, int j ) const;
+        Type getDelay( int i, int j, bool interp=true ) const;
+        Vector<Type> getDelays( bool interp=true ) const;
+
+    private:
+
+        int nChan;
+        int nPairs;
+        int frameLen;
+        int maxLag;
+        int nFFT;
+        int nFreq;
+
+        // weighting function, 0 to 3 for "none", "phat", "scot" and "roth"
+        int wType;
+        Type alpha;
+        bool first;
+
+        // computing the lags directly or by inverse FFT
+        bool direct;
+
+        // channel indices of each pair in the upper triangle
+        Vector<int> pairI, pairJ;
+
+        // spectra of current frames and the averaged auto-spectra, one row
+        // for one channel
+        Matrix<Type> Xre, Xim, Pxx;
+
+        // averaged cross spectra, one row for one channel pair
+        Matrix<Type> Gre, Gim;
+
+        // weighted cross-correlation, column maxLag+t is the lag t
+        Matrix<Type> Rxy;
+
+        // cos(2*pi*k*t/L)*c(k)/L and sin(2*pi*k*t/L)*c(k)/L for t >= 0,
+        // where c(k) is 1 for k = 0, L/2 and 2 otherwise
+        Matrix<Type> cosT, sinT;
+
+        int pairIndex( int i, int j ) const;
+        Type peakDelay( int p, bool interp ) const;
+
+    };
+    // class GCC
+
+
+    #include <gcc-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// GCC_H
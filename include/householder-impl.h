@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                            householder-impl.h
+ *
+ * Implementation for blocked Householder reflectors.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * Form the upper triangular factor T(KxK) of the block reflector
+ * Q = I - V*T*V^H, where V(MxK), M >= K, holds the Householder vectors
+ * and tau their scalar factors.
+ */
+template <typename Type>
+void blockReflector( int M, int K, const Type *V, int ldv,
+                     const Type *tau, Type *T, int ldt )
+{
+    Vector<Type> V1( K*K ),
+                 G( K*K );
+
+    // G = V^H*V, only the upper triangle is used
+    copyLowerV( K, V, ldv, &V1[0] );
+    gemm( 'C', 'N', K, K, K, Type(1), &V1[0], K, &V1[0], K,
+          Type(0), &G[0], K );
+    if( M > K )
+        gemm( 'C', 'N', K, K, M-K, Type(1), V+K*ldv, ldv, V+K*ldv, ldv,
+              Type(1), &G[0], K );
+
+    // T(0:i,i) = -tau(i) * T(0:i,0:i) * V(:,0:i)^H * v(i)
+    for( int i=0; i<K; ++i )
+    {
+        for( int r=0; r<i; ++r )
+        {
+            Type s = 0;
+            for( int q=r; q<i; ++q )
+                s += T[r*ldt+q] * G[q*K+i];
+            T[r*ldt+i] = -tau[i] * s;
+        }
+
+        T[i*ldt+i] = tau[i];
+        for( int r=i+1; r<K; ++r )
+            T[r*ldt+i] = 0;
+    }
+}
+
+
+/**
+ * Apply the block reflector Q = I - V*T*V^H to C(MxN) from the left,
+ * C = Q*C if "trans" is 'N', or C = Q^H*C if "trans" is 'C' (or 'T').
+ */
+template <typename Type>
+void applyBlockReflector( char trans, int M, int N, int K,
+                          const Type *V, int ldv, const Type *T, int ldt,
+                          Type *C, int ldc )
+{
+    if( M <= 0 || N <= 0 || K <= 0 )
+        return;
+
+    Vector<Type> V1( K*K ),
+                 W( K*N ),
+                 TW( K*N );
+
+    // W = V^H*C
+    copyLowerV( K, V, ldv, &V1[0] );
+    gemm( 'C', 'N', K, N, K, Type(1), &V1[0], K, C, ldc,
+          Type(0), &W[0], N );
+    if( M > K )
+        gemm( 'C', 'N', K, N, M-K, Type(1), V+K*ldv, ldv, C+K*ldc, ldc,
+              Type(1), &W[0], N );
+
+    // TW = op(T)*W
+    gemm( (trans == 'N') ? 'N' : 'C', 'N', K, N, K, Type(1), T, ldt,
+          &W[0], N, Type(0), &TW[0], N );
+
+    // C = C - V*TW
+    gemm( 'N', 'N', K, N, K, Type(-1), &V1[0], K, &TW[0], N,
+          Type(1), C, ldc );
+    if( M > K )
+        gemm( 'N', 'N', M-K, N, K, Type(-1), V+K*ldv, ldv, &TW[0], N,
+              Type(1), C+K*ldc, ldc );
+}
+
+
+/**
+ * Copy the first K rows of V to V1(KxK), with zeros above the diagonal.
+ */
+template <typename Type>
+void copyLowerV( int K, const Type *V, int ldv, Type *V1 )
+{
+    for( int i=0; i<K; ++i )
+        for( int j=0; j<K; ++j )
+            V1[i*K+j] = (j <= i) ? V[i*ldv+j] : Type(0);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                               householder.h
+ *
+ * Blocked Householder reflectors in the compact WY form.
+ *
+ * The product of K Householder reflectors H(k) = I - tau(k)*v(k)*v(k)^H,
+ * k = 0, ..., K-1, can be written as
+ *      Q = H(0)*H(1)*...*H(K-1) = I - V*T*V^H,
+ * where V = [ v(0), ..., v(K-1) ] is M-by-K and T is a K-by-K upper
+ * triangular matrix. Applying Q or Q^H to a block C then takes three
+ * matrix-matrix products, W = V^H*C, W = op(T)*W and C = C - V*W, which are
+ * done by "gemm".
+ *
+ * The vector v(k) has zeros above its k-th element, so V is stored in the
+ * lower trapezoid of a row-major array like the "QR" member of the QR
+ * decompositions, and the elements above the diagonal are not referenced.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef HOUSEHOLDER_H
+#define HOUSEHOLDER_H
+
+
+#include <blas3.h>
+
+
+namespace splab
+{
+
+    template<typename Type>
+    void blockReflector( int M, int K, const Type *V, int ldv,
+                         const Type *tau, Type *T, int ldt );
+
+    template<typename Type>
+    void applyBlockReflector( char trans, int M, int N, int K,
+                              const Type *V, int ldv, const Type *T, int ldt,
+                              Type *C, int ldc );
+
+
+    template<typename Type>
+    static void copyLowerV( int K, const Type *V, int ldv, Type *V1 );
+
+
+    #include <householder-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// HOUSEHOLDER_H
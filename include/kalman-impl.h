@@ -72,3 +72,428 @@ Vector<Type> kalman( const Matrix<Type> &A, const Matrix<Type> &C,
     // return the estimation of the state vector
     return xPred + KGain * alpha;
 }
+
+
+/**
+ * Prediction step of the Kalman filter on raw arrays (row-major).
+ *      x = A*x,    P = A*P*A' + Q
+ * "T" is a work array of n*n. Only the upper triangle of P is computed and
+ * then mirrored, so P remains exactly symmetric.
+ */
+template <typename Type>
+inline void kalmanPredict( int n, const Type *A, const Type *Q,
+                           Type *x, Type *P, Type *T )
+{
+    // x = A*x
+    for( int i=0; i<n; ++i )
+    {
+        Type sum = 0;
+        for( int k=0; k<n; ++k )
+            sum += A[i*n+k] * x[k];
+        T[i] = sum;
+    }
+    for( int i=0; i<n; ++i )
+        x[i] = T[i];
+
+    // T = A*P
+    for( int i=0; i<n; ++i )
+        for( int j=0; j<n; ++j )
+        {
+            Type sum = 0;
+            for( int k=0; k<n; ++k )
+                sum += A[i*n+k] * P[k*n+j];
+            T[i*n+j] = sum;
+        }
+
+    // P = T*A' + Q
+    for( int i=0; i<n; ++i )
+        for( int j=i; j<n; ++j )
+        {
+            Type sum = Q[i*n+j];
+            for( int k=0; k<n; ++k )
+                sum += T[i*n+k] * A[j*n+k];
+            P[i*n+j] = sum;
+            P[j*n+i] = sum;
+        }
+}
+
+
+/**
+ * Correction step of the Kalman filter on raw arrays (row-major).
+ *      v = y - C*x,    S = C*P*C' + R,     K = P*C'*inv(S)
+ *      x = x + K*v,    P = (I-K*C)*P*(I-K*C)' + K*R*K'
+ * The gain is solved by Cholesky factorization of S, and the covariance is
+ * updated in Joseph form. Since P is symmetric, (I-K*C)*P = P-K*U' with
+ * U = P*C', and the Joseph form is T-(T*C'-K*R)*K' with T = P-K*U', whose
+ * upper triangle is computed in O(n^2*m) instead of the O(n^3) products
+ * by I-K*C. K*S = U is not used, so the update keeps the robustness of
+ * the Joseph form to errors in K. "work" is an array of m+m*m+4*n*m+n*n.
+ * Return false (and leave x and P unchanged) if S is not positive definite.
+ */
+template <typename Type>
+inline bool kalmanCorrect( int n, int m, const Type *C, const Type *R,
+                           const Type *y, Type *x, Type *P, Type *work )
+{
+    Type *v  = work,
+         *S  = v + m,
+         *U  = S + m*m,
+         *K  = U + n*m,
+         *KR = K + n*m,
+         *W  = KR + n*m,
+         *T  = W + n*m;
+
+    // innovation v = y - C*x
+    for( int l=0; l<m; ++l )
+    {
+        Type sum = y[l];
+        for( int k=0; k<n; ++k )
+            sum -= C[l*n+k] * x[k];
+        v[l] = sum;
+    }
+
+    // U = P*C'
+    for( int i=0; i<n; ++i )
+        for( int l=0; l<m; ++l )
+        {
+            Type sum = 0;
+            for( int k=0; k<n; ++k )
+                sum += P[i*n+k] * C[l*n+k];
+            U[i*m+l] = sum;
+        }
+
+    // lower triangle of S = C*U + R
+    for( int l=0; l<m; ++l )
+        for( int r=0; r<=l; ++r )
+        {
+            Type sum = R[l*m+r];
+            for( int k=0; k<n; ++k )
+                sum += C[l*n+k] * U[k*m+r];
+            S[l*m+r] = sum;
+        }
+
+    // Cholesky factorization S = L*L', L overwrites the lower triangle
+    for( int j=0; j<m; ++j )
+    {
+        Type d = S[j*m+j];
+        for( int k=0; k<j; ++k )
+            d -= S[j*m+k] * S[j*m+k];
+        if( d <= 0 )
+            return false;
+        d = sqrt(d);
+        S[j*m+j] = d;
+
+        for( int i=j+1; i<m; ++i )
+        {
+            Type sum = S[i*m+j];
+            for( int k=0; k<j; ++k )
+                sum -= S[i*m+k] * S[j*m+k];
+            S[i*m+j] = sum / d;
+        }
+    }
+
+    // K = U*inv(S), each row of K solves S*k = u by L and L'
+    for( int i=0; i<n; ++i )
+    {
+        Type *ki = K + i*m;
+        const Type *ui = U + i*m;
+        for( int l=0; l<m; ++l )
+        {
+            Type sum = ui[l];
+            for( int k=0; k<l; ++k )
+                sum -= S[l*m+k] * ki[k];
+            ki[l] = sum / S[l*m+l];
+        }
+        for( int l=m-1; l>=0; --l )
+        {
+            Type sum = ki[l];
+            for( int k=l+1; k<m; ++k )
+                sum -= S[k*m+l] * ki[k];
+            ki[l] = sum / S[l*m+l];
+        }
+    }
+
+    // x = x + K*v
+    for( int i=0; i<n; ++i )
+    {
+        Type sum = 0;
+        for( int l=0; l<m; ++l )
+            sum += K[i*m+l] * v[l];
+        x[i] += sum;
+    }
+
+    // T = (I-K*C)*P = P - K*U',  KR = K*R
+    for( int i=0; i<n; ++i )
+    {
+        for( int j=0; j<n; ++j )
+        {
+            Type sum = P[i*n+j];
+            for( int l=0; l<m; ++l )
+                sum -= K[i*m+l] * U[j*m+l];
+            T[i*n+j] = sum;
+        }
+        for( int r=0; r<m; ++r )
+        {
+            Type sum = 0;
+            for( int l=0; l<m; ++l )
+                sum += K[i*m+l] * R[l*m+r];
+            KR[i*m+r] = sum;
+        }
+    }
+
+    // W = T*C' - KR
+    for( int i=0; i<n; ++i )
+        for( int l=0; l<m; ++l )
+        {
+            Type sum = -KR[i*m+l];
+            for( int k=0; k<n; ++k )
+                sum += T[i*n+k] * C[l*n+k];
+            W[i*m+l] = sum;
+        }
+
+    // P = T*(I-K*C)' + KR*K' = T - W*K', upper triangle only
+    for( int i=0; i<n; ++i )
+        for( int j=i; j<n; ++j )
+        {
+            Type sum = T[i*n+j];
+            for( int l=0; l<m; ++l )
+                sum -= W[i*m+l] * K[j*m+l];
+            P[i*n+j] = sum;
+            P[j*n+i] = sum;
+        }
+
+    return true;
+}
+
+
+/**
+ * constructors and destructor of the fixed-size Kalman filter
+ */
+template <typename Type, int N, int M>
+KalmanFilter<Type,N,M>::KalmanFilter()
+{
+    for( int i=0; i<N; ++i )
+        x[i] = 0;
+    for( int i=0; i<N*N; ++i )
+        P[i] = 0;
+}
+
+template <typename Type, int N, int M>
+KalmanFilter<Type,N,M>::~KalmanFilter()
+{
+}
+
+
+/**
+ * Initialize the state vector and its covariance matrix.
+ */
+template <typename Type, int N, int M>
+void KalmanFilter<Type,N,M>::init( const Vector<Type> &x0,
+                                   const Matrix<Type> &P0 )
+{
+    assert( x0.size() == N );
+    assert( P0.rows() == N && P0.cols() == N );
+
+    for( int i=0; i<N; ++i )
+        x[i] = x0[i];
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<N; ++j )
+            P[i*N+j] = P0[i][j];
+}
+
+
+/**
+ * Prediction by the system matrix "A" and the process noise covariance "Q".
+ */
+template <typename Type, int N, int M>
+inline void KalmanFilter<Type,N,M>::predict( const Matrix<Type> &A,
+                                             const Matrix<Type> &Q )
+{
+    assert( A.rows() == N && A.cols() == N );
+    assert( Q.rows() == N && Q.cols() == N );
+
+    Type T[N*N];
+    kalmanPredict( N, (const Type*)A, (const Type*)Q, x, P, T );
+}
+
+
+/**
+ * Correction by the measurement "y", the measurement matrix "C" and the
+ * measurement noise covariance "R". Return false if the innovation
+ * covariance is not positive definite.
+ */
+template <typename Type, int N, int M>
+inline bool KalmanFilter<Type,N,M>::correct( const Matrix<Type> &C,
+                                             const Matrix<Type> &R,
+                                             const Type *y )
+{
+    assert( C.rows() == M && C.cols() == N );
+    assert( R.rows() == M && R.cols() == M );
+
+    Type work[M+M*M+4*N*M+N*N];
+    return kalmanCorrect( N, M, (const Type*)C, (const Type*)R, y,
+                          x, P, work );
+}
+
+template <typename Type, int N, int M>
+inline bool KalmanFilter<Type,N,M>::correct( const Matrix<Type> &C,
+                                             const Matrix<Type> &R,
+                                             const Vector<Type> &y )
+{
+    assert( y.size() == M );
+    return correct( C, R, &y[0] );
+}
+
+
+/**
+ * Get the state dimension, state vector and its covariance matrix.
+ */
+template <typename Type, int N, int M>
+inline int KalmanFilter<Type,N,M>::dim() const
+{
+    return N;
+}
+
+template <typename Type, int N, int M>
+inline Vector<Type> KalmanFilter<Type,N,M>::getState() const
+{
+    return Vector<Type>( N, x );
+}
+
+template <typename Type, int N, int M>
+inline Matrix<Type> KalmanFilter<Type,N,M>::getCovariance() const
+{
+    return Matrix<Type>( N, N, P );
+}
+
+
+/**
+ * constructors and destructor of the run-time sized Kalman filter
+ */
+template <typename Type>
+KalmanFilter<Type,0,0>::KalmanFilter()
+{
+}
+
+template <typename Type>
+KalmanFilter<Type,0,0>::~KalmanFilter()
+{
+}
+
+
+/**
+ * Initialize the state vector and its covariance matrix.
+ */
+template <typename Type>
+void KalmanFilter<Type,0,0>::init( const Vector<Type> &x0,
+                                   const Matrix<Type> &P0 )
+{
+    assert( P0.rows() == x0.size() && P0.cols() == x0.size() );
+
+    x = x0;
+    P = P0;
+}
+
+
+/**
+ * Prediction by the system matrix "A" and the process noise covariance "Q".
+ */
+template <typename Type>
+void KalmanFilter<Type,0,0>::predict( const Matrix<Type> &A,
+                                      const Matrix<Type> &Q )
+{
+    int n = x.size();
+    assert( A.rows() == n && A.cols() == n );
+    assert( Q.rows() == n && Q.cols() == n );
+
+    if( work.size() < n*n )
+        work.resize(n*n);
+    kalmanPredict( n, (const Type*)A, (const Type*)Q, &x[0], (Type*)P,
+                   &work[0] );
+}
+
+
+/**
+ * Correction by the measurement "y", the measurement matrix "C" and the
+ * measurement noise covariance "R". Return false if the innovation
+ * covariance is not positive definite.
+ */
+template <typename Type>
+bool KalmanFilter<Type,0,0>::correct( const Matrix<Type> &C,
+                                      const Matrix<Type> &R,
+                                      const Type *y )
+{
+    int n = x.size(),
+        m = C.rows();
+    assert( C.cols() == n );
+    assert( R.rows() == m && R.cols() == m );
+
+    int len = m + m*m + 4*n*m + n*n;
+    if( work.size() < len )
+        work.resize(len);
+    return kalmanCorrect( n, m, (const Type*)C, (const Type*)R, y,
+                          &x[0], (Type*)P, &work[0] );
+}
+
+template <typename Type>
+inline bool KalmanFilter<Type,0,0>::correct( const Matrix<Type> &C,
+                                             const Matrix<Type> &R,
+                                             const Vector<Type> &y )
+{
+    assert( y.size() == C.rows() );
+    return correct( C, R, &y[0] );
+}
+
+
+/**
+ * Get the state dimension, state vector and its covariance matrix.
+ */
+template <typename Type>
+inline int KalmanFilter<Type,0,0>::dim() const
+{
+    return x.size();
+}
+
+template <typename Type>
+inline Vector<Type> KalmanFilter<Type,0,0>::getState() const
+{
+    return x;
+}
+
+template <typename Type>
+inline Matrix<Type> KalmanFilter<Type,0,0>::getCovariance() const
+{
+    return P;
+}
+
+
+/**
+ * One predict-correct step for K filters sharing the same model, the kth
+ * row of "Y" is the measurement of the kth filter. The filters are
+ * processed in parallel if OpenMP is enabled. Return the number of filters
+ * whose correction failed, if "ok" is given, ok[k] is set to the result
+ * of the kth correction.
+ */
+template <typename Type, int N, int M>
+int kalmanBatch( KalmanFilter<Type,N,M> *filters, int K,
+                 const Matrix<Type> &A, const Matrix<Type> &C,
+                 const Matrix<Type> &Q, const Matrix<Type> &R,
+                 const Matrix<Type> &Y, bool *ok )
+{
+    assert( Y.rows() == K );
+    assert( Y.cols() == C.rows() );
+
+    int fails = 0;
+
+    #pragma omp parallel for reduction(+:fails)
+    for( int k=0; k<K; ++k )
+    {
+        filters[k].predict( A, Q );
+        bool good = filters[k].correct( C, R, Y[k] );
+        if( ok )
+            ok[k] = good;
+        if( !good )
+            ++fails;
+    }
+
+    return fails;
+}
@@ -40,6 +40,18 @@
  * filter, Schmidt's extended filter, the information filter, and a variety
  * of square-root filters that were developed by Bierman, Thornton and so on.
  *
+ * The function "kalman" keeps the covariance matrix in a static variable,
+ * so it can track only one system. The class "KalmanFilter" owns its state
+ * vector and covariance matrix, solves the innovation covariance by
+ * Cholesky factorization instead of inverting it, and updates the
+ * covariance in the symmetric Joseph form, computing only its upper
+ * triangle in O(n^2*m) by the symmetry of the prior covariance. For small
+ * systems the dimensions can be given as template parameters,
+ * KalmanFilter<Type,N,M>, then all data are stored in the object or on the
+ * stack and the loops have constant trip counts, while KalmanFilter<Type>
+ * has run-time dimensions. "kalmanBatch" updates a large group of filters
+ * sharing the same model in parallel.
+ *
  * Zhang Ming, 2010-10, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -63,6 +75,97 @@ namespace splab
                          const Vector<Type>& );
 
 
+    /**
+     * Kalman filter with state dimension N and measurement dimension M
+     * fixed at compile time, both must be positive (KalmanFilter<Type>,
+     * i.e. N = M = 0, is the run-time sized filter below).
+     */
+    template <typename Type, int N=0, int M=0>
+    class KalmanFilter
+    {
+
+    public:
+
+        KalmanFilter();
+        ~KalmanFilter();
+
+        void init( const Vector<Type> &x0, const Matrix<Type> &P0 );
+
+        void predict( const Matrix<Type> &A, const Matrix<Type> &Q );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Type *y );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Vector<Type> &y );
+
+        int dim() const;
+        Vector<Type> getState() const;
+        Matrix<Type> getCovariance() const;
+
+    private:
+
+        // fails to compile unless N > 0 and M > 0, which also rules out
+        // the zero-size arrays
+        typedef char dimensionsMustBePositive[(N>0 && M>0) ? 1 : -1];
+
+        // state vector and its covariance matrix
+        Type x[N];
+        Type P[N*N];
+
+    };
+    // class KalmanFilter
+
+
+    /**
+     * Kalman filter with dimensions given at run time.
+     */
+    template <typename Type>
+    class KalmanFilter<Type,0,0>
+    {
+
+    public:
+
+        KalmanFilter();
+        ~KalmanFilter();
+
+        void init( const Vector<Type> &x0, const Matrix<Type> &P0 );
+
+        void predict( const Matrix<Type> &A, const Matrix<Type> &Q );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Type *y );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Vector<Type> &y );
+
+        int dim() const;
+        Vector<Type> getState() const;
+        Matrix<Type> getCovariance() const;
+
+    private:
+
+        // state vector and its covariance matrix
+        Vector<Type> x;
+        Matrix<Type> P;
+
+        // work space, allocated once for the given dimensions
+        Vector<Type> work;
+
+    };
+    // class KalmanFilter
+
+
+    template<typename Type, int N, int M>
+    int kalmanBatch( KalmanFilter<Type,N,M>*, int,
+                     const Matrix<Type>&, const Matrix<Type>&,
+                     const Matrix<Type>&, const Matrix<Type>&,
+                     const Matrix<Type>&, bool *ok=0 );
+
+    template<typename Type>
+    static void kalmanPredict( int, const Type*, const Type*,
+                               Type*, Type*, Type* );
+    template<typename Type>
+    static bool kalmanCorrect( int, int, const Type*, const Type*,
+                               const Type*, Type*, Type*, Type* );
+
+
     #include <kalman-impl.h>
 
 }
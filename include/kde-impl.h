@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 kde-impl.h
+ *
+ * Implementation for KDE class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type>
+KDE<Type>::KDE( const Type &lo, const Type &hi, int M,
+                const Type &bandwidth )
+: xLo(lo), xHi(hi), kb(bandwidth), counts(M)
+{
+    assert( lo < hi );
+    assert( M > 1 );
+    assert( bandwidth >= 0 );
+
+    dx = (hi-lo) / (M-1);
+}
+
+template <typename Type>
+KDE<Type>::~KDE()
+{
+}
+
+
+/**
+ * Clear all the samples.
+ */
+template <typename Type>
+void KDE<Type>::reset()
+{
+    counts = 0.0;
+    moms.reset();
+}
+
+
+/**
+ * Add a sample.
+ */
+template <typename Type>
+inline void KDE<Type>::add( const Type &x )
+{
+    bin( &x, 1, counts.begin() );
+    moms.add( x );
+}
+
+
+/**
+ * Add a block of samples.
+ */
+template <typename Type>
+void KDE<Type>::add( const Vector<Type> &xn )
+{
+    int N = xn.size(),
+        M = counts.size(),
+        nChunks = (N+CHUNK-1) / CHUNK,
+        P = ( nChunks < PARTS ) ? nChunks : PARTS;
+
+    if( P <= 1 )
+        bin( xn.begin(), N, counts.begin() );
+    else
+    {
+        Matrix<double> part( P, M );
+
+        #pragma omp parallel for
+        for( int p=0; p<P; ++p )
+        {
+            int i0 = int( (long long)N*p/P ),
+                i1 = int( (long long)N*(p+1)/P );
+            bin( &xn[i0], i1-i0, part[p] );
+        }
+
+        for( int p=0; p<P; ++p )
+        {
+            const double *c = part[p];
+            for( int j=0; j<M; ++j )
+                counts[j] += c[j];
+        }
+    }
+
+    moms.add( xn );
+}
+
+
+/**
+ * Merge the estimator of another part of data on the same grid.
+ */
+template <typename Type>
+void KDE<Type>::merge( const KDE<Type> &rhs )
+{
+    assert( counts.size() == rhs.counts.size() );
+    assert( xLo == rhs.xLo && xHi == rhs.xHi );
+
+    counts += rhs.counts;
+    moms.merge( rhs.moms );
+}
+
+
+/**
+ * The number of samples, including those out of the grid.
+ */
+template <typename Type>
+inline double KDE<Type>::count() const
+{
+    return moms.count();
+}
+
+
+/**
+ * The kernel bandwidth, which is given or chosen by Silverman's rule.
+ */
+template <typename Type>
+Type KDE<Type>::getBandwidth() const
+{
+    if( kb > 0 || moms.count() < 2 )
+        return kb;
+    else
+        return Type( 1.06 * moms.getStdVar() * pow(moms.count(), -0.2) );
+}
+
+
+/**
+ * The grid points.
+ */
+template <typename Type>
+Vector<Type> KDE<Type>::getGrid() const
+{
+    int M = counts.size();
+    Vector<Type> g(M);
+
+    for( int j=0; j<M; ++j )
+        g[j] = xLo + j*dx;
+    g[M-1] = xHi;
+
+    return g;
+}
+
+
+/**
+ * The linear bin counts.
+ */
+template <typename Type>
+Vector<Type> KDE<Type>::getCounts() const
+{
+    int M = counts.size();
+    Vector<Type> c(M);
+    for( int j=0; j<M; ++j )
+        c[j] = Type( counts[j] );
+
+    return c;
+}
+
+
+/**
+ * The density at the grid points, i.e. the bin counts convoluted with the
+ * Gaussian kernel truncated at 4 bandwidths and divided by the number of
+ * samples. If the bandwidth is zero (less than two samples or all of them
+ * are the same), the counts divided by n*dx are returned.
+ */
+template <typename Type>
+Vector<Type> KDE<Type>::getDensity() const
+{
+    int M = counts.size();
+    double n = count();
+    Type h = getBandwidth();
+
+    if( n == 0 )
+        return Vector<Type>( M );
+    if( h <= 0 )
+        return getCounts() / Type(n*dx);
+
+    int L = int( ceil(4*h/dx) );
+    if( L > M-1 )
+        L = M-1;
+
+    Vector<Type> kn( 2*L+1 );
+    Type c = Type( 1 / (n*h*sqrt(TWOPI)) );
+    for( int l=-L; l<=L; ++l )
+    {
+        Type u = l*dx / h;
+        kn[l+L] = c * exp( -u*u/2 );
+    }
+
+    return wkeep( fastConv(getCounts(),kn), M, L );
+}
+
+
+/**
+ * Distribute "N" samples into the grid counts "c" by linear binning.
+ */
+template <typename Type>
+void KDE<Type>::bin( const Type *x, int N, double *c ) const
+{
+    int M = counts.size();
+    Type scale = 1 / dx;
+
+    for( int i=0; i<N; ++i )
+    {
+        Type t = (x[i]-xLo) * scale;
+        if( t < 0 || t > M-1 )
+            continue;
+
+        int j = int(t);
+        if( j == M-1 )
+            c[j] += 1;
+        else
+        {
+            Type r = t - j;
+            c[j]   += 1-r;
+            c[j+1] += r;
+        }
+    }
+}
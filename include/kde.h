@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                    kde.h
+ *
+ * Binned kernel density estimation.
+ *
+ * The samples are distributed into "M" equispaced points lo = g(0) < ... <
+ * g(M-1) = hi of a fixed grid by linear binning, i.e. a sample between g(j)
+ * and g(j+1) gives the weights (1-r) and r to the two points, where r is
+ * its relative distance to g(j). The Gaussian kernel density at the grid
+ * points is the convolution of the bin counts with the sampled kernel,
+ * which is computed by "fastConv" in O(M*log(M)) time whatever the number
+ * of samples is.
+ *
+ * The counts are kept in the object, so the estimation can be updated as
+ * the data arrives, and two estimators of the same grid can be merged. A
+ * block of samples is binned by a fixed number of parts, each into its own
+ * histogram (in parallel if OpenMP is enabled), and the histograms are
+ * added in order. The samples out of [lo, hi] are counted but not binned.
+ *
+ * The bandwidth is chosen by Silverman's rule, h = 1.06*std*n^(-1/5), if
+ * it is not given.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef KDE_H
+#define KDE_H
+
+
+#include <cmath>
+#include <constants.h>
+#include <vector.h>
+#include <matrix.h>
+#include <convolution.h>
+#include <moments.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class KDE
+    {
+
+    public:
+
+        KDE( const Type &lo, const Type &hi, int M,
+             const Type &bandwidth=Type(0) );
+        ~KDE();
+
+        void reset();
+        void add( const Type &x );
+        void add( const Vector<Type> &xn );
+        void merge( const KDE<Type> &rhs );
+
+        double count() const;
+        Type getBandwidth() const;
+        Vector<Type> getGrid() const;
+        Vector<Type> getCounts() const;
+        Vector<Type> getDensity() const;
+
+    private:
+
+        static const int PARTS = 16;
+        static const int CHUNK = 4096;
+
+        Type xLo,
+             xHi,
+             dx,
+             kb;
+
+        // the bin counts are kept in double, as the sample count
+        Vector<double> counts;
+        Moments<Type> moms;
+
+        void bin( const Type *x, int N, double *c ) const;
+
+    };
+    // class KDE
+
+
+    #include <kde-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// KDE_H
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                               lanczos-impl.h
+ *
+ * Implementation for Lanczos class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructor and destructor
+ */
+template<typename Real>
+Lanczos<Real>::Lanczos() : nSteps(0)
+{
+}
+
+template<typename Real>
+Lanczos<Real>::~Lanczos()
+{
+}
+
+
+/**
+ * Compute the "k" largest (which = "largest") or smallest (which =
+ * "smallest") eigenvalues and eigenvectors of symmetric matrix "A". The
+ * iteration stops when the residuals of all the wanted Ritz pairs are less
+ * than "tol" relative to the largest Ritz value, or the Krylov subspace
+ * becomes the whole space. If k > n/3, the full decomposition is cheaper
+ * and used instead.
+ */
+template <typename Real>
+void Lanczos<Real>::dec( const Matrix<Real> &A, int k, const string &which,
+                         Real tol )
+{
+    int n = A.rows();
+
+    assert( A.cols() == n );
+    assert( 0 < k && k <= n );
+
+    bool largest = ( which != "smallest" );
+
+    if( 3*k > n )
+    {
+        fullDec( A, k, largest );
+        return;
+    }
+
+    // row j of Q is the jth Lanczos vector, the rows are allocated as
+    // needed
+    int cap = min( n, 2*k+16 );
+    Vector<Real> Q( cap*n ), alpha(n), beta(n), w(n), h(n);
+    Random rg( 1 );
+
+    // random start vector, which is not orthogonal to any eigenvector
+    // with probability 1
+    Real nrm = 0;
+    for( int i=0; i<n; ++i )
+    {
+        Q[i] = rg.random() / Real(rg.getM()) - Real(0.5);
+        nrm += Q[i]*Q[i];
+    }
+    nrm = sqrt(nrm);
+    for( int i=0; i<n; ++i )
+        Q[i] /= nrm;
+
+    // the convergence is checked at the steps k, next, ..., which grow by
+    // an eighth, so the O(log m) checks of O(m^2) cost O(m^2*log(m))
+    int next = k;
+
+    Real anrm = 0;
+    for( int j=0; j<n; ++j )
+    {
+        const Real *q = &Q[j*n];
+
+        // w = A*q
+        for( int i=0; i<n; ++i )
+        {
+            const Real *Ai = A[i];
+            Real sum = 0;
+            for( int l=0; l<n; ++l )
+                sum += Ai[l]*q[l];
+            w[i] = sum;
+        }
+
+        // full reorthogonalization by twice classical Gram-Schmidt, the
+        // coefficient of q itself is the diagonal of T
+        alpha[j] = 0;
+        for( int pass=0; pass<2; ++pass )
+        {
+            for( int r=0; r<=j; ++r )
+            {
+                const Real *qr = &Q[r*n];
+                Real sum = 0;
+                for( int i=0; i<n; ++i )
+                    sum += qr[i]*w[i];
+                h[r] = sum;
+            }
+            for( int r=0; r<=j; ++r )
+            {
+                const Real *qr = &Q[r*n];
+                for( int i=0; i<n; ++i )
+                    w[i] -= h[r]*qr[i];
+            }
+            alpha[j] += h[j];
+        }
+
+        nrm = 0;
+        for( int i=0; i<n; ++i )
+            nrm += w[i]*w[i];
+        beta[j] = nrm = sqrt(nrm);
+        anrm = max( anrm, abs(alpha[j])+nrm );
+
+        nSteps = j+1;
+        if( nSteps == n )
+            break;
+        if( nSteps >= next )
+        {
+            if( ritz( &Q[0], n, alpha, beta, nSteps, k, largest, tol,
+                      false ) )
+                return;
+            next = nSteps + max( 1, nSteps/8 );
+        }
+
+        if( nSteps == cap )
+        {
+            cap = min( n, 2*cap );
+            Vector<Real> Qn( cap*n );
+            for( int i=0; i<nSteps*n; ++i )
+                Qn[i] = Q[i];
+            Q = Qn;
+        }
+        Real *qn = &Q[(j+1)*n];
+
+        if( nrm > n*Real(EPS)*anrm )
+            for( int i=0; i<n; ++i )
+                qn[i] = w[i] / nrm;
+        else
+        {
+            // an invariant subspace is found, so restart with a random
+            // vector orthogonal to it
+            beta[j] = 0;
+            for( int i=0; i<n; ++i )
+                w[i] = rg.random() / Real(rg.getM()) - Real(0.5);
+            for( int pass=0; pass<2; ++pass )
+                for( int r=0; r<=j; ++r )
+                {
+                    const Real *qr = &Q[r*n];
+                    Real sum = 0;
+                    for( int i=0; i<n; ++i )
+                        sum += qr[i]*w[i];
+                    for( int i=0; i<n; ++i )
+                        w[i] -= sum*qr[i];
+                }
+
+            nrm = 0;
+            for( int i=0; i<n; ++i )
+                nrm += w[i]*w[i];
+            nrm = sqrt(nrm);
+            for( int i=0; i<n; ++i )
+                qn[i] = w[i] / nrm;
+        }
+    }
+
+    ritz( &Q[0], n, alpha, beta, nSteps, k, largest, tol, true );
+}
+
+
+/**
+ * Take the k wanted eigenpairs from the full decomposition of A.
+ */
+template <typename Real>
+void Lanczos<Real>::fullDec( const Matrix<Real> &A, int k, bool largest )
+{
+    int n = A.rows();
+
+    // the eigenvalues are in ascending order
+    EVD<Real> eig;
+    eig.dec( A );
+    Matrix<Real> S = eig.getV();
+    Vector<Real> theta = eig.getD();
+
+    nSteps = 0;
+    V.resize( n, k );
+    d.resize( k );
+    for( int c=0; c<k; ++c )
+    {
+        int idx = largest ? n-1-c : c;
+        d[c] = theta[idx];
+        for( int i=0; i<n; ++i )
+            V[i][c] = S[i][idx];
+    }
+}
+
+
+/**
+ * Check the residuals of the wanted Ritz pairs of the m-by-m tridiagonal
+ * matrix T, which are |beta(m)*s(m,i)|. Only the eigenvalues and the last
+ * row of the eigenvectors s are needed, which cost O(m^2). If they are
+ * converged or "final" is true, the Ritz pairs are computed from the full
+ * decomposition of T and stored, and true is returned. The rows of the
+ * m-by-n array "Q" are the Lanczos vectors.
+ */
+template <typename Real>
+bool Lanczos<Real>::ritz( const Real *Q, int n, const Vector<Real> &alpha,
+                          const Vector<Real> &beta, int m, int k,
+                          bool largest, Real tol, bool final )
+{
+    if( !final )
+    {
+        Vector<Real> theta(m), e(m), z(m);
+        for( int i=0; i<m; ++i )
+        {
+            theta[i] = alpha[i];
+            e[i] = ( i+1 < m ) ? beta[i] : Real(0);
+        }
+        z[m-1] = 1;
+        tridiagLastRow( m, &theta[0], &e[0], &z[0] );
+
+        Real scale = max( abs(theta[0]), abs(theta[m-1]) );
+        for( int c=0; c<k; ++c )
+        {
+            int idx = largest ? m-1-c : c;
+            if( abs(beta[m-1]*z[idx]) > tol*scale )
+                return false;
+        }
+    }
+
+    Matrix<Real> T( m, m );
+    for( int i=0; i<m; ++i )
+    {
+        T[i][i] = alpha[i];
+        if( i+1 < m )
+            T[i][i+1] = T[i+1][i] = beta[i];
+    }
+
+    // the eigenvalues are in ascending order
+    EVD<Real> eig;
+    eig.dec( T );
+    Matrix<Real> S = eig.getV();
+    Vector<Real> theta = eig.getD();
+
+    // Ritz vectors V = Q'*S
+    V.resize( n, k );
+    d.resize( k );
+    for( int c=0; c<k; ++c )
+    {
+        int idx = largest ? m-1-c : c;
+        d[c] = theta[idx];
+
+        for( int i=0; i<n; ++i )
+            V[i][c] = 0;
+        for( int r=0; r<m; ++r )
+        {
+            Real s = S[r][idx];
+            const Real *qr = Q + r*n;
+            for( int i=0; i<n; ++i )
+                V[i][c] += s*qr[i];
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Eigenvalues of the symmetric tridiagonal matrix with diagonal "d" and
+ * off-diagonal "e" (e[m-1] = 0) by the implicit QL algorithm of "EVD",
+ * with the rotations applied to the row vector "z" only. Starting with
+ * z = [0 ... 0 1], z becomes the last row of the eigenvectors. The
+ * eigenvalues are sorted in ascending order, d and e are overwritten.
+ */
+template <typename Real>
+void tridiagLastRow( int m, Real *d, Real *e, Real *z )
+{
+    Real f = 0,
+         tst1 = 0,
+         eps = Real(EPS);
+
+    for( int l=0; l<m; ++l )
+    {
+        // find small subdiagonal element
+        tst1 = max( tst1, abs(d[l])+abs(e[l]) );
+        int j = l;
+        while( j < m && abs(e[j]) > eps*tst1 )
+            j++;
+
+        // if j == l, d[l] is an eigenvalue, otherwise, iterate
+        if( j > l )
+        {
+            do
+            {
+                // compute implicit shift
+                Real g = d[l],
+                     p = (d[l+1] - g) / (2 * e[l]),
+                     r = hypot( p, Real(1) );
+                if( p < 0 )
+                    r = -r;
+
+                d[l] = e[l] / ( p + r );
+                d[l+1] = e[l] * ( p + r );
+                Real dl1 = d[l+1],
+                     h = g - d[l];
+
+                for( int i=l+2; i<m; ++i )
+                    d[i] -= h;
+                f += h;
+
+                // implicit QL transformation
+                p = d[j];
+                Real c = 1, c2 = 1, c3 = 1,
+                     el1 = e[l+1],
+                     s = 0, s2 = 0;
+
+                for( int i=j-1; i>=l; --i )
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = hypot( p, e[i] );
+                    e[i+1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i+1] = h + s * ( c * g + s * d[i] );
+
+                    h = z[i+1];
+                    z[i+1] = s * z[i] + c * h;
+                    z[i] = c * z[i] - s * h;
+                }
+
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+
+            } while( abs(e[l]) > eps*tst1 );
+        }
+
+        d[l] += f;
+        e[l] = 0;
+    }
+
+    // sort the eigenvalues and the components
+    for( int i=0; i<m-1; ++i )
+    {
+        int k = i;
+        for( int l=i+1; l<m; ++l )
+            if( d[l] < d[k] )
+                k = l;
+        if( k != i )
+        {
+            swap( d[i], d[k] );
+            swap( z[i], z[k] );
+        }
+    }
+}
+
+
+/**
+ * Return the eigenvector matrix, the kth column is the kth eigenvector.
+ */
+template <typename Real>
+inline Matrix<Real> Lanczos<Real>::getV() const
+{
+    return V;
+}
+
+
+/**
+ * Return the eigenvalues.
+ */
+template <typename Real>
+inline Vector<Real> Lanczos<Real>::getD() const
+{
+    return d;
+}
+
+
+/**
+ * Return the number of Lanczos steps, i.e. matrix-vector products, which
+ * is 0 if the full decomposition is used.
+ */
+template <typename Real>
+inline int Lanczos<Real>::steps() const
+{
+    return nSteps;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                  lanczos.h
+ *
+ * Class template of partial eigenvalue decomposition for real symmetric
+ * matrix by Lanczos algorithm.
+ *
+ * Many applications, such as the subspace methods of spectrum estimation,
+ * only need the k largest (or smallest) eigenvalues and the corresponding
+ * eigenvectors of an n-by-n symmetric matrix A, where k << n. The Lanczos
+ * algorithm builds an orthonormal basis Q of the Krylov subspace
+ *      span{ q, A*q, A^2*q, ... }
+ * in which Q'*A*Q = T is tridiagonal, and the eigenpairs of the small
+ * matrix T (Ritz pairs) converge to the extreme eigenpairs of A after only
+ * a few steps. The basis is reorthogonalized fully, so there is no spurious
+ * copies of the converged eigenvalues. Each step needs one matrix-vector
+ * product, thus the cost is O(n^2*m) for m steps, instead of O(n^3) of the
+ * full decomposition "EVD". The Lanczos vectors are allocated as the steps
+ * go. The convergence is checked first at step k and then each time the
+ * number of steps has grown by about an eighth, by the QL iteration of T
+ * that tracks only the last row of its eigenvectors, in O(m^2) per check,
+ * and T is decomposed fully only once at the end. When k > n/3, the Lanczos
+ * iteration is not cheaper than "EVD", which is then used instead.
+ *
+ * The eigenvalues returned by getD() are sorted in descending order for the
+ * "largest" option, and ascending order for the "smallest" option, and the
+ * kth column of getV() is the corresponding eigenvector.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef LANCZOS_H
+#define LANCZOS_H
+
+
+#include <matrix.h>
+#include <evd.h>
+#include <random.h>
+
+
+namespace splab
+{
+
+    template <typename Real>
+    class Lanczos
+    {
+
+    public:
+
+        Lanczos();
+        ~Lanczos();
+
+        void dec( const Matrix<Real> &A, int k,
+                  const string &which="largest",
+                  Real tol=Real(1.0e-10) );
+
+        Matrix<Real> getV() const;
+        Vector<Real> getD() const;
+        int steps() const;
+
+    private:
+
+        // number of Lanczos steps taken
+        int nSteps;
+
+        // eigenvectors and eigenvalues
+        Matrix<Real> V;
+        Vector<Real> d;
+
+        void fullDec( const Matrix<Real> &A, int k, bool largest );
+        bool ritz( const Real *Q, int n, const Vector<Real> &alpha,
+                   const Vector<Real> &beta, int m, int k, bool largest,
+                   Real tol, bool final );
+
+    };
+    // class Lanczos
+
+
+    template<typename Real>
+    static void tridiagLastRow( int, Real*, Real*, Real* );
+
+
+    #include <lanczos-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// LANCZOS_H
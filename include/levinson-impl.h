@@ -43,52 +43,12 @@ Vector<Type> levinson( const Vector<Type> &t, const Vector<Type> &b )
     assert( t.size() == b.size() );
 
     int n = t.size();
-	Type alpha, beta, q, c, omega;
-	Vector<Type> y(n), yy(n), x(n);
-
-	alpha = t[0];
-	if( abs(alpha) < EPS )
-	{
-		cerr << "The matrix is ill-conditioned!" << endl;
-		return x;
-	}
-	y[0] = 1;
-	x[0] = b[0] / alpha;
-
-	for( int k=1; k<n; ++k )
-	{
-		q = 0;
-		beta = 0;
-		for( int j=0; j<k; ++j )
-		{
-			q += x[j] * t[k-j];
-			beta += y[j] * t[j+1];
-		}
-		c = -beta / alpha;
-
-		yy[0] = c * y[k-1];
-		y[k] = y[k-1];
-		for( int i=1; i<k; ++i )
-			yy[i] = y[i-1] + c*y[k-i-1];
-		yy[k] = y[k-1];
-
-		alpha += c*beta;
-		if( abs(alpha) < EPS )
-		{
-			cerr << "The matrix is ill-conditioned!" << endl;
-			return x;
-		}
-
-		omega = (b[k]-q) / alpha;
-		for( int i=0; i<k; ++i )
-		{
-			x[i] += omega*yy[i];
-			y[i] = yy[i];
-		}
-		x[k] = omega*y[k];
-	}
-
-	return x;
+    Vector<Type> x(n), work(2*n);
+
+    if( !levinson( n, &t[0], &b[0], &x[0], &work[0] ) )
+        cerr << "The matrix is ill-conditioned!" << endl;
+
+    return x;
 }
 
 
@@ -101,28 +61,287 @@ template <typename Type>
 Vector<Type> levinson( const Vector<Type> &rn, Type &sigma2 )
 {
     int p = rn.size()-1;
-    Type tmp;
-    Vector<Type> ak(p+1), akPrev(p+1);
+    Vector<Type> ak(p+1);
 
-    ak[0] = Type(1.0);
-    sigma2 = rn[0];
-    ak[1] = -rn[1]/sigma2;
-    sigma2 *= 1 - ak[1]*ak[1];
+    if( !levinsonDurbin( p, &rn[0], &ak[0], (Type*)0, sigma2 ) )
+        cerr << "The matrix is ill-conditioned!" << endl;
+
+    return ak;
+}
+
+
+/**
+ * Levinson algorithm for solving Toeplitz equations on raw arrays.
+ * n        : the order of equations
+ * t        : t(0), t(1), ..., t(n-1) of Toeplitz coefficient matrix
+ * b        : constant vector
+ * x        : solution (output)
+ * work     : work space of 2*n
+ * return   : false if the matrix is ill-conditioned, then x is partial
+ */
+template <typename Type>
+bool levinson( int n, const Type *t, const Type *b, Type *x, Type *work )
+{
+    Type alpha, beta, q, c, omega;
+    Type *y = work,
+         *yy = work+n;
+
+    for( int i=0; i<n; ++i )
+        x[i] = 0;
 
-    for( int k=2; k<=p; ++k )
+    alpha = t[0];
+    if( abs(alpha) < EPS )
+        return false;
+    y[0] = 1;
+    x[0] = b[0] / alpha;
+
+    for( int k=1; k<n; ++k )
     {
-        tmp = 0;
-        for( int i=0; i<k; ++i )
-            tmp += ak[i]*rn[k-i];
-        ak[k] = -tmp/sigma2;
+        q = 0;
+        beta = 0;
+        for( int j=0; j<k; ++j )
+        {
+            q += x[j] * t[k-j];
+            beta += y[j] * t[j+1];
+        }
+        c = -beta / alpha;
 
+        yy[0] = c * y[k-1];
+        y[k] = y[k-1];
         for( int i=1; i<k; ++i )
-            akPrev[i] = ak[i] + ak[k]*ak[k-i];
+            yy[i] = y[i-1] + c*y[k-i-1];
+        yy[k] = y[k-1];
+
+        alpha += c*beta;
+        if( abs(alpha) < EPS )
+            return false;
+
+        omega = (b[k]-q) / alpha;
+        for( int i=0; i<k; ++i )
+        {
+            x[i] += omega*yy[i];
+            y[i] = yy[i];
+        }
+        x[k] = omega*y[k];
+    }
+
+    return true;
+}
+
+
+/**
+ * Levinson-Durbin algorithm for solving Youle-Walker equations on raw
+ * arrays, the predictor is updated in place.
+ * p        : the order
+ * rn       : r(0), r(1), ..., r(p)
+ * ak       : a(0) = 1, a(1), ..., a(p) (output)
+ * kn       : reflection coefficients k(1), ..., k(p) (output), may be null
+ * sigma2   : the variance of exciting white noise (output)
+ * return   : false if the prediction error power becomes nonpositive
+ */
+template <typename Type>
+bool levinsonDurbin( int p, const Type *rn, Type *ak, Type *kn, Type &sigma2 )
+{
+    ak[0] = Type(1);
+    sigma2 = rn[0];
+    if( sigma2 <= 0 )
+        return false;
+
+    for( int k=1; k<=p; ++k )
+    {
+        Type acc = rn[k];
         for( int i=1; i<k; ++i )
-            ak[i] = akPrev[i];
+            acc += ak[i]*rn[k-i];
+        Type g = -acc/sigma2;
+
+        // a(i) += g*a(k-i), updated by symmetric pairs
+        for( int i=1, j=k-1; i<j; ++i, --j )
+        {
+            Type ai = ak[i];
+            ak[i] += g*ak[j];
+            ak[j] += g*ai;
+        }
+        if( k%2 == 0 )
+            ak[k/2] *= 1+g;
+
+        ak[k] = g;
+        if( kn )
+            kn[k-1] = g;
+
+        sigma2 *= 1 - g*g;
+        if( sigma2 <= 0 )
+            return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Split Levinson algorithm for solving Youle-Walker equations. With the
+ * symmetric polynomials P(k) = A(k-1) + z^(-1)*A~(k-1), where A~ is the
+ * reversed predictor polynomial,
+ *      P(k+1) = (1+z^(-1))*P(k) - alpha(k)*z^(-1)*P(k-1),
+ *      alpha(k) = tau(k)/tau(k-1) = (1-k(k))*(1+k(k-1)),
+ * where tau(k) is the inner product of P(k) and r. Only half of each
+ * symmetric polynomial is computed. At last the predictor is recovered by
+ *      A~(p)*(1-z^(-1)) = (1+k(p))*P(p) - P(p+1).
+ * The arguments are the same as "levinsonDurbin", and "work" is the work
+ * space of 2*(p+2).
+ */
+template <typename Type>
+bool splitLevinson( int p, const Type *rn, Type *ak, Type *kn, Type &sigma2,
+                    Type *work )
+{
+    ak[0] = Type(1);
+    sigma2 = rn[0];
+    if( sigma2 <= 0 )
+        return false;
+    if( p == 0 )
+        return true;
+
+    // P(k-1) and P(k), the buffers are swapped after each step
+    Type *P0 = work,
+         *P1 = work+p+2;
+    P0[0] = 2;
+    P1[0] = 1;
+    P1[1] = 1;
 
-        sigma2 *= 1 - ak[k]*ak[k];
+    Type tau0 = rn[0],
+         tau1,
+         alpha,
+         g = 0,
+         gPrev;
+
+    for( int k=1; k<=p; ++k )
+    {
+        // tau(k) = <P(k),r>, P(k) is symmetric of degree k
+        tau1 = 0;
+        for( int i=0, j=k; i<j; ++i, --j )
+            tau1 += P1[i] * ( rn[i]+rn[j] );
+        if( k%2 == 0 )
+            tau1 += P1[k/2] * rn[k/2];
+
+        if( tau0 == 0 )
+            return false;
+        alpha = tau1/tau0;
+
+        // reflection coefficient and the prediction error power
+        gPrev = g;
+        g = 1 - alpha/(1+gPrev);
+        if( kn )
+            kn[k-1] = g;
+        sigma2 *= 1 - g*g;
+        if( sigma2 <= 0 )
+            return false;
+
+        // P(k+1) overwrites P(k-1), from the middle to the beginning
+        for( int i=(k+1)/2; i>=1; --i )
+            P0[i] = P1[i] + P1[i-1] - alpha*P0[i-1];
+        P0[0] = 1;
+        for( int i=0; i<=(k+1)/2; ++i )
+            P0[k+1-i] = P0[i];
+
+        Type *tmp = P0;
+        P0 = P1;
+        P1 = tmp;
+        tau0 = tau1;
+    }
+
+    // A~(p)*(1-z^(-1)) = (1+k(p))*P(p) - P(p+1), solved by cumulative sum,
+    // then a(i) = a~(p-i)
+    Type sum = 0;
+    for( int i=0; i<p; ++i )
+    {
+        sum += (1+g)*P0[i] - P1[i];
+        ak[p-i] = sum;
     }
+    ak[0] = 1;
 
-	return ak;
+    return true;
+}
+
+
+/**
+ * Solve K Youle-Walker equations of order p by Levinson-Durbin algorithm.
+ * rn       : K-by-(p+1) row-major array, each row is r(0), ..., r(p)
+ * ak       : K-by-(p+1) row-major array of predictors (output)
+ * kn       : K-by-p row-major array of reflection coefficients (output),
+ *            may be null
+ * sigma2   : K variances of exciting white noise (output), a nonpositive
+ *            one indicates an ill-conditioned system
+ */
+template <typename Type>
+void levinsonBatch( int K, int p, const Type *rn, Type *ak, Type *kn,
+                    Type *sigma2 )
+{
+    const int BS = 8;
+    int nBlocks = (K+BS-1) / BS;
+
+    #pragma omp parallel
+    {
+        // interleaved r(i) and a(i) of a group: element (i,s) is [i*BS+s]
+        Vector<Type> wr((p+1)*BS), wa((p+1)*BS);
+        Type E[BS], g[BS];
+
+        #pragma omp for
+        for( int blk=0; blk<nBlocks; ++blk )
+        {
+            int s0 = blk*BS,
+                bs = ( s0+BS <= K ) ? BS : K-s0;
+            Type *r = &wr[0],
+                 *a = &wa[0];
+
+            // the unused lanes are filled by a trivial system
+            for( int i=0; i<=p; ++i )
+                for( int s=0; s<BS; ++s )
+                    r[i*BS+s] = ( s < bs ) ? rn[(s0+s)*(p+1)+i]
+                                           : Type( i == 0 );
+
+            for( int s=0; s<BS; ++s )
+            {
+                a[s] = 1;
+                E[s] = r[s];
+            }
+
+            for( int k=1; k<=p; ++k )
+            {
+                for( int s=0; s<BS; ++s )
+                    g[s] = r[k*BS+s];
+                for( int i=1; i<k; ++i )
+                    for( int s=0; s<BS; ++s )
+                        g[s] += a[i*BS+s] * r[(k-i)*BS+s];
+                for( int s=0; s<BS; ++s )
+                    g[s] = ( E[s] > 0 ) ? -g[s]/E[s] : Type(0);
+
+                for( int i=1, j=k-1; i<j; ++i, --j )
+                    for( int s=0; s<BS; ++s )
+                    {
+                        Type ai = a[i*BS+s];
+                        a[i*BS+s] += g[s]*a[j*BS+s];
+                        a[j*BS+s] += g[s]*ai;
+                    }
+                if( k%2 == 0 )
+                    for( int s=0; s<BS; ++s )
+                        a[(k/2)*BS+s] *= 1+g[s];
+
+                for( int s=0; s<BS; ++s )
+                {
+                    a[k*BS+s] = g[s];
+                    E[s] *= 1 - g[s]*g[s];
+                }
+                if( kn )
+                    for( int s=0; s<bs; ++s )
+                        kn[(s0+s)*p+k-1] = g[s];
+            }
+
+            for( int s=0; s<bs; ++s )
+            {
+                Type *as = ak + (s0+s)*(p+1);
+                for( int i=0; i<=p; ++i )
+                    as[i] = a[i*BS+s];
+                sigma2[s0+s] = E[s];
+            }
+        }
+    }
 }
@@ -32,6 +32,16 @@
  * -Hopf equeations in Wiener filtring and Yule- Walker equations in
  * parametric spectrum estimation, respectively.
  *
+ * Besides the vector interface, the solvers can work on caller's buffers
+ * without any memory allocation. The split Levinson algorithm (Delsarte and
+ * Genin) solves the Yule-Walker equations by symmetric polynomials, which
+ * needs about half the multiplications of Levinson-Durbin algorithm. And
+ * "levinsonBatch" solves many Yule-Walker equations of the same order (such
+ * as the LPC analysis of all frames), where the systems are processed in
+ * interleaved groups so that the inner loops run across the systems and can
+ * be vectorized by the compiler, and the groups run in parallel if OpenMP
+ * is enabled.
+ *
  * Zhang Ming, 2010-11, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -52,6 +62,18 @@ namespace splab
     template<typename Type>
     Vector<Type> levinson( const Vector<Type>&, Type& );
 
+    template<typename Type>
+    bool levinson( int, const Type*, const Type*, Type*, Type* );
+
+    template<typename Type>
+    bool levinsonDurbin( int, const Type*, Type*, Type*, Type& );
+
+    template<typename Type>
+    bool splitLevinson( int, const Type*, Type*, Type*, Type&, Type* );
+
+    template<typename Type>
+    void levinsonBatch( int, int, const Type*, Type*, Type*, Type* );
+
 
     #include <levinson-impl.h>
 
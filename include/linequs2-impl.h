@@ -46,12 +46,19 @@ Vector<Type> lsSolver( const Matrix<Type> &A, const Vector<Type> &b )
     assert( A.rows() == b.size() );
     assert( A.rows() > A.cols() );
 
+    int m = A.rows(),
+        n = A.cols();
+    Matrix<Type> AtA = normalMatrix( A );
+    Vector<Type> Atb( n );
+    gemm( 'C', 'N', n, 1, m, Type(1), &A[0][0], n, &b[0], 1,
+          Type(0), &Atb[0], 1 );
+
     Cholesky<Type> cho;
-    cho.dec( trMult(A,A) );
+    cho.dec( AtA );
     if( cho.isSpd() )
-        return cho.solve( trMult(A,b) );
+        return cho.solve( Atb );
     else
-        return luSolver( trMult(A,A), trMult(A,b) );
+        return luSolver( AtA, Atb );
 }
 
 
@@ -67,7 +74,7 @@ Vector<Real> qrLsSolver( const Matrix<Real> &A, const Vector<Real> &b )
     assert( A.rows() == b.size() );
     assert( A.rows() > A.cols() );
 
-    QRD<Real> qr;
+    TSQR<Real> qr;
     qr.dec( A );
     if( !qr.isFullRank() )
     {
@@ -205,11 +212,12 @@ Vector<Real> qrLnSolver( const Matrix<Real> &A, const Vector<Real> &b )
     }
     else
     {
-        Matrix<Real> Q, R;
-        Q = qr.getQ();
-        R = qr.getR();
-        Vector<Real> y( ltSolver( trT( R ), b ) );
-        return Q * y;
+        Matrix<Real> R = qr.getR();
+        Vector<Real> y( ltSolver( trT( R ), b ) ),
+                     z( At.rows() );
+        for( int i=0; i<y.size(); ++i )
+            z[i] = y[i];
+        return qr.applyQ( z );
     }
 }
 
@@ -267,11 +275,12 @@ Vector<complex<Type> > qrLnSolver( const Matrix<complex<Type> > &A,
     }
     else
     {
-        Matrix<complex<Type> > Q, R;
-        Q = qr.getQ();
-        R = qr.getR();
-        Vector<complex<Type> > y( ltSolver( trH( R ), b ) );
-        return Q * y;
+        Matrix<complex<Type> > R = qr.getR();
+        Vector<complex<Type> > y( ltSolver( trH( R ), b ) ),
+                               z( At.rows() );
+        for( int i=0; i<y.size(); ++i )
+            z[i] = y[i];
+        return qr.applyQ( z );
     }
 }
 
@@ -304,3 +313,44 @@ Vector<complex<Type> > svdLnSolver( const Matrix<complex<Type> > &A,
 
     return V * ( trMult(U,b) / complexVector(s) );
 }
+
+
+/**
+ * The normal matrix A^H*A of the least squares problem. The rows of A are
+ * split into at most PARTS parts, whose products are computed by "syrk" in
+ * parallel and summed in order.
+ */
+template <typename Type>
+Matrix<Type> normalMatrix( const Matrix<Type> &A )
+{
+    const int PARTS = 16;
+
+    int m = A.rows(),
+        n = A.cols(),
+        parts = max( 1, min( PARTS, m/(4*n) ) ),
+        mp = (m+parts-1) / parts;
+
+    Matrix<Type> AtA( n, n );
+    Vector< Matrix<Type> > G;
+    G.resize( parts );
+
+    #pragma omp parallel for
+    for( int k=0; k<parts; ++k )
+    {
+        int r0 = k*mp,
+            mk = max( 0, min( mp, m-r0 ) );
+        G[k] = Matrix<Type>( n, n );
+        if( mk > 0 )
+            syrk( 'C', n, mk, Type(1), &A[r0][0], n,
+                  Type(0), &G[k][0][0], n );
+    }
+
+    for( int k=0; k<parts; ++k )
+        AtA += G[k];
+
+    for( int i=0; i<n; ++i )
+        for( int j=i+1; j<n; ++j )
+            AtA[i][j] = conjOp( 'C', AtA[j][i] );
+
+    return AtA;
+}
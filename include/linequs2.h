@@ -36,6 +36,10 @@
  *
  * These functions can be used for both REAL or COMPLEX linear equations.
  *
+ * "lsSolver" forms the normal equations by blocked rank-k updates of row
+ * parts of A, and the real "qrLsSolver" uses the tall-skinny QR ("TSQR"),
+ * so both run in parallel over the rows if OpenMP is enabled.
+ *
  * Zhang Ming, 2010-07 (revised 2010-12), Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -45,6 +49,7 @@
 
 
 #include <qrd.h>
+#include <tsqr.h>
 #include <svd.h>
 #include <cqrd.h>
 #include <csvd.h>
@@ -80,6 +85,9 @@ namespace splab
 	Vector<complex<Type> > svdLnSolver( const Matrix<complex<Type> >&,
                                         const Vector<complex<Type> >& );
 
+	template<typename Type>
+	static Matrix<Type> normalMatrix( const Matrix<Type>& );
+
 
 	#include <linequs2-impl.h>
 
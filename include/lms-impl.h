@@ -133,3 +133,132 @@ Type lmsNormalize( const Type &xk, const Type &dk, Vector<Type> &wn,
 
     return yk;
 }
+
+
+/**
+ * constructors of the LMS filter objects, the parameters are the same as
+ * the functions "lms", "lmsNewton" and "lmsNormalize".
+ */
+template <typename Type>
+LMS<Type>::LMS( int length, const Type &mu )
+          : AdaptFilter<Type>(length), mu(mu)
+{
+}
+
+template <typename Type>
+LMSNewton<Type>::LMSNewton( int length, const Type &mu, const Type &alpha,
+                            const Type &delta )
+                : AdaptFilter<Type>(length), mu(mu), alpha(alpha),
+                  delta(delta), invR(length,length), vQ(length)
+{
+    assert( 0 < alpha );
+    assert( alpha <= Type(0.1) );
+
+    for( int i=0; i<length; ++i )
+        invR[i][i] = 1/delta;
+}
+
+template <typename Type>
+NLMS<Type>::NLMS( int length, const Type &rho, const Type &gamma )
+           : AdaptFilter<Type>(length), rho(rho), gamma(gamma)
+{
+    assert( 0 < rho );
+    assert( rho < 2 );
+}
+
+
+/**
+ * Conventional LMS update, return the a priori output.
+ */
+template <typename Type>
+Type LMS<Type>::update( const Type *xn, const Type &dk, const Type &yk )
+{
+    Type *wn = this->wn;
+    Type g = 2*mu*(dk-yk);
+
+    for( int i=0; i<this->L; ++i )
+        wn[i] += g*xn[i];
+
+    return yk;
+}
+
+
+/**
+ * Reset the LMS-Newton filter, including the inverse correlation matrix.
+ */
+template <typename Type>
+void LMSNewton<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    invR = Type(0);
+    for( int i=0; i<this->L; ++i )
+        invR[i][i] = 1/delta;
+}
+
+
+/**
+ * LMS-Newton update, return the a priori output. The inverse correlation
+ * matrix is symmetric, so only its upper triangle is updated.
+ */
+template <typename Type>
+Type LMSNewton<Type>::update( const Type *xn, const Type &dk, const Type &yk )
+{
+    int L = this->L;
+    Type *wn = this->wn;
+    Type beta = 1-alpha;
+
+    // vQ = invR * xn
+    for( int i=0; i<L; ++i )
+    {
+        const Type *Ri = invR[i];
+        Type sum = 0;
+        for( int j=0; j<L; ++j )
+            sum += Ri[j]*xn[j];
+        vQ[i] = sum;
+    }
+
+    Type r = 0;
+    for( int i=0; i<L; ++i )
+        r += vQ[i]*xn[i];
+    Type c = beta/alpha,
+         s = 1 / (c+r);
+
+    // invR = ( invR - vQ*vQ'/(c+r) ) / beta
+    for( int i=0; i<L; ++i )
+    {
+        Type *Ri = invR[i];
+        Type qi = vQ[i]*s;
+        for( int j=i; j<L; ++j )
+            Ri[j] = ( Ri[j] - qi*vQ[j] ) / beta;
+        for( int j=0; j<i; ++j )
+            Ri[j] = invR[j][i];
+    }
+
+    // the updated invR*xn equals vQ*c/((c+r)*beta)
+    Type g = 2*mu*(dk-yk) * c*s/beta;
+    for( int i=0; i<L; ++i )
+        wn[i] += g*vQ[i];
+
+    return yk;
+}
+
+
+/**
+ * Normalized LMS update, return the a priori output.
+ */
+template <typename Type>
+Type NLMS<Type>::update( const Type *xn, const Type &dk, const Type &yk )
+{
+    Type *wn = this->wn;
+
+    Type power = 0;
+    for( int i=0; i<this->L; ++i )
+        power += xn[i]*xn[i];
+
+    Type g = rho*(dk-yk) / (gamma+power);
+    for( int i=0; i<this->L; ++i )
+        wn[i] += g*xn[i];
+
+    return yk;
+}
@@ -38,6 +38,11 @@
  * This file implement three types of the LMS algorithm: conventional LMS,
  * algorithm, LMS-Newton algorhm and normalized LMS algorithm.
  *
+ * The functions keep the delay line in static variables, so only one filter
+ * of each kind can be used in a program. The classes "LMS", "LMSNewton" and
+ * "NLMS" (derived from "AdaptFilter") implement the same algorithms with
+ * per-object state and allocation-free updates.
+ *
  * Zhang Ming, 2010-10, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -48,6 +53,7 @@
 
 #include <vector.h>
 #include <matrix.h>
+#include <adaptfilter.h>
 
 
 namespace splab
@@ -65,6 +71,76 @@ namespace splab
                        const Type&, const Type& );
 
 
+    template <typename Type>
+    class LMS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        LMS( int length, const Type &mu );
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type mu;
+
+    };
+    // class LMS
+
+
+    template <typename Type>
+    class LMSNewton : public AdaptFilter<Type>
+    {
+
+    public:
+
+        LMSNewton( int length, const Type &mu, const Type &alpha,
+                   const Type &delta );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type mu,
+             alpha,
+             delta;
+
+        // inverse of the correlation matrix and the work vector
+        Matrix<Type> invR;
+        Vector<Type> vQ;
+
+    };
+    // class LMSNewton
+
+
+    template <typename Type>
+    class NLMS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        NLMS( int length, const Type &rho, const Type &gamma );
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type rho,
+             gamma;
+
+    };
+    // class NLMS
+
+
     #include <lms-impl.h>
 
 }
@@ -100,56 +100,88 @@ void LUD<Type>::dec(const Matrix<Type> &A)
     piv.resize(m);
     LU = A;
 
-    // Use a "left-looking", dot-product, Crout/Doolittle algorithm.
     for( int i=0; i<m; ++i )
         piv[i] = i;
-
     pivsign = 1;
-    Type *LUrowi = 0;
-    Vector<Type> LUcolj(m);
 
-    // outer loop
-    for( int j=0; j<n; ++j )
+    // Use a "right-looking", blocked algorithm.
+    int kmax = min( m, n );
+    for( int j=0; j<kmax; j+=NB )
     {
-        // Make a copy of the j-th column to localize references.
-        for( int i=0; i<m; ++i )
-            LUcolj[i] = LU[i][j];
-
-        // Apply previous transformations.
-        for( int i=0; i<m; ++i )
-        {
-            LUrowi = LU[i];
+        int jb = ( kmax-j < NB ) ? kmax-j : NB,
+            j1 = j + jb;
 
-            // Most of the time is spent in the following dot product.
-            int kmax = (i < j)? i : j;
-            Type s = 0;
+        panel( j, jb );
 
-            for( int k=0; k<kmax; ++k )
-                s += LUrowi[k]*LUcolj[k];
+        if( j1 < n )
+        {
+            // U12 = L11^{-1} * A12
+            trsm( 'L', 'L', 'N', 'U', jb, n-j1, &LU[j][j], n, &LU[j][j1], n );
 
-            LUrowi[j] = LUcolj[i] -= s;
+            // A22 -= L21 * U12
+            if( j1 < m )
+                gemm( 'N', 'N', m-j1, n-j1, jb, Type(-1), &LU[j1][j], n,
+                      &LU[j][j1], n, Type(1), &LU[j1][j1], n );
         }
+    }
+}
 
-        // Find pivot and exchange if necessary.
-        int p = j;
-        for( int i=j+1; i<m; ++i )
-            if( abs(LUcolj[i]) > abs(LUcolj[p]) )
-                p = i;
 
-        if( p != j )
+/**
+ * Factorize the panel of columns j, ..., j+w-1 (rows j, ..., m-1). The
+ * whole rows are exchanged by the pivoting, so the columns outside the
+ * panel are permuted at the same time.
+ */
+template <typename Type>
+void LUD<Type>::panel( int j, int w )
+{
+    if( w <= PS )
+    {
+        for( int c=j; c<j+w; ++c )
         {
-            int k=0;
-            for( k=0; k<n; ++k )
-                swap( LU[p][k], LU[j][k] );
-
-            swap( piv[p], piv[j] );
-            pivsign = -pivsign;
+            // Find pivot and exchange if necessary.
+            int p = c;
+            for( int i=c+1; i<m; ++i )
+                if( abs(LU[i][c]) > abs(LU[p][c]) )
+                    p = i;
+
+            if( p != c )
+            {
+                for( int k=0; k<n; ++k )
+                    swap( LU[p][k], LU[c][k] );
+
+                swap( piv[p], piv[c] );
+                pivsign = -pivsign;
+            }
+
+            // compute multipliers and update the rest of the panel
+            if( abs(LU[c][c]) != 0 )
+                for( int i=c+1; i<m; ++i )
+                    LU[i][c] /= LU[c][c];
+
+            for( int i=c+1; i<m; ++i )
+            {
+                Type *LUrowi = LU[i],
+                     l = LUrowi[c];
+                const Type *LUrowc = LU[c];
+                for( int k=c+1; k<j+w; ++k )
+                    LUrowi[k] -= l*LUrowc[k];
+            }
         }
+    }
+    else
+    {
+        int w1 = w / 2,
+            j1 = j + w1;
+
+        panel( j, w1 );
 
-        // compute multipliers
-        if( (j < m) && ( abs(LU[j][j]) != 0 ) )
-            for( int i=j+1; i<m; ++i )
-                LU[i][j] /= LU[j][j];
+        trsm( 'L', 'L', 'N', 'U', w1, w-w1, &LU[j][j], n, &LU[j][j1], n );
+        if( j1 < m )
+            gemm( 'N', 'N', m-j1, w-w1, w1, Type(-1), &LU[j1][j], n,
+                  &LU[j][j1], n, Type(1), &LU[j1][j1], n );
+
+        panel( j1, w-w1 );
     }
 }
 
@@ -271,22 +303,9 @@ Matrix<Type> LUD<Type>::solve( const Matrix<Type> &B )
     int nx = B.cols();
     Matrix<Type> X = permuteCopy( B, piv, 0, nx-1 );
 
-    // solve L*Y = B(piv,:)
-    for( int k=0; k<n; ++k )
-        for( int i=k+1; i<n; ++i )
-            for( int j=0; j<nx; ++j )
-                X[i][j] -= X[k][j]*LU[i][k];
-
-    // solve U*X = Y;
-    for( int k=n-1; k>=0; --k )
-    {
-        for( int j=0; j<nx; ++j )
-            X[k][j] /= LU[k][k];
-
-        for( int i=0; i<k; ++i )
-            for( int j=0; j<nx; ++j )
-                X[i][j] -= X[k][j]*LU[i][k];
-    }
+    // solve L*Y = B(piv,:) and U*X = Y
+    trsm( 'L', 'L', 'N', 'U', n, nx, &LU[0][0], n, &X[0][0], nx );
+    trsm( 'L', 'U', 'N', 'N', n, nx, &LU[0][0], n, &X[0][0], nx );
 
     return X;
 }
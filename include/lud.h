@@ -40,6 +40,14 @@
  * decomposition is in the solution of square systems of simultaneouslinear
  * equations. This will fail if isNonsingular() returns false.
  *
+ * The decomposition is right-looking and blocked: a panel of NB columns is
+ * factorized recursively (the left half of the panel, then the update of
+ * the right half by "trsm" and "gemm", then the right half), the rows of
+ * U right to the panel are solved by "trsm", and the trailing submatrix is
+ * updated by "gemm" (see "blas3.h"), which takes most of the time and runs
+ * in parallel if OpenMP is enabled. The pivots are the same as those of
+ * the unblocked algorithm, i.e. the largest element in the column.
+ *
  * Adapted from Template Numerical Toolkit.
  *
  * Zhang Ming, 2010-01 (revised 2010-12), Xi'an Jiaotong University.
@@ -51,6 +59,7 @@
 
 
 #include <matrix.h>
+#include <blas3.h>
 
 
 namespace splab
@@ -78,6 +87,10 @@ namespace splab
 
     private:
 
+        // panel width, and the width of unblocked panels
+        static const int NB = 128;
+        static const int PS = 16;
+
         // Array for internal storage of decomposition.
 		Matrix<Type> LU;
 		int m;
@@ -91,6 +104,8 @@ namespace splab
 		Matrix<Type> permuteCopy( const Matrix<Type> &A,
 		                          const Vector<int> &piv, int j0, int j1 );
 
+		void panel( int j, int w );
+
 	};
 	// class LUD
 
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              mcintegral-impl.h
+ *
+ * Implementation for MCIntegral class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type, typename Ftype>
+MCIntegral<Type, Ftype>::MCIntegral( const Vector<Type> &lower,
+                                     const Vector<Type> &upper,
+                                     const string &method, int replicas,
+                                     uint64 seed )
+: nDim(lower.size()), nRep(1), key(seed), lo(lower), width(upper-lower)
+{
+    assert( lower.size() == upper.size() );
+    assert( lower.size() > 0 );
+
+    if( method == "mc" )
+        type = 0;
+    else
+    {
+        assert( replicas > 0 );
+        type = ( method == "halton" ) ? 2 : 1;
+        nRep = replicas;
+    }
+
+    volume = 1;
+    for( int d=0; d<nDim; ++d )
+        volume *= width[d];
+
+    sums.resize( nRep );
+    reset();
+}
+
+template <typename Type, typename Ftype>
+MCIntegral<Type, Ftype>::~MCIntegral()
+{
+}
+
+
+/**
+ * Discard all the points, and start the sequences again.
+ */
+template <typename Type, typename Ftype>
+void MCIntegral<Type, Ftype>::reset()
+{
+    nPts = 0;
+    mu = 0;
+    m2 = 0;
+    sums = Type(0);
+}
+
+
+/**
+ * Evaluate "N" more points (of all the replicas), and return the current
+ * estimation of the integral.
+ */
+template <typename Type, typename Ftype>
+Type MCIntegral<Type, Ftype>::integrate( Ftype &func, int N )
+{
+    assert( N > 0 );
+
+    if( type == 0 )
+        mcChunks( func, N );
+    else if( type == 1 )
+        qmcChunks<Sobol>( func, (N+nRep-1)/nRep );
+    else
+        qmcChunks<Halton>( func, (N+nRep-1)/nRep );
+
+    return getValue();
+}
+
+
+/**
+ * Evaluate more points, doubling the number each time, until the error
+ * estimation is less than "tol" or "maxN" points have been evaluated.
+ */
+template <typename Type, typename Ftype>
+Type MCIntegral<Type, Ftype>::integrate( Ftype &func, const Type &tol,
+                                         int maxN )
+{
+    int N = CHUNK * nRep;
+    if( count() == 0 )
+        integrate( func, min(N,maxN) );
+
+    while( getError() > tol && count() < uint64(maxN) )
+    {
+        N = int( min( count(), uint64(maxN)-count() ) );
+        integrate( func, N );
+    }
+
+    return getValue();
+}
+
+
+/**
+ * The current estimation of the integral and its standard error.
+ */
+template <typename Type, typename Ftype>
+Type MCIntegral<Type, Ftype>::getValue() const
+{
+    if( nPts == 0 )
+        return 0;
+
+    if( type == 0 )
+        return volume * mu;
+    else
+        return volume * sum(sums) / (Type(nPts)*nRep);
+}
+
+template <typename Type, typename Ftype>
+Type MCIntegral<Type, Ftype>::getError() const
+{
+    if( type == 0 )
+    {
+        if( nPts < 2 )
+            return 0;
+        return volume * sqrt( m2 / ((nPts-1)*Type(nPts)) );
+    }
+    else
+    {
+        if( nPts == 0 || nRep < 2 )
+            return 0;
+
+        Type m = sum(sums) / (Type(nPts)*nRep),
+             s = 0;
+        for( int r=0; r<nRep; ++r )
+        {
+            Type e = sums[r]/Type(nPts) - m;
+            s += e*e;
+        }
+        return volume * sqrt( s / (nRep*(nRep-1)) );
+    }
+}
+
+
+/**
+ * The number of evaluated points.
+ */
+template <typename Type, typename Ftype>
+inline typename MCIntegral<Type, Ftype>::uint64
+MCIntegral<Type, Ftype>::count() const
+{
+    return nPts * nRep;
+}
+
+
+/**
+ * Evaluate the next "N" pseudo-random points. Point i takes the outputs
+ * i*nDim, ..., (i+1)*nDim-1 of the Philox stream, the mean and M2 of each
+ * chunk are merged in order.
+ */
+template <typename Type, typename Ftype>
+void MCIntegral<Type, Ftype>::mcChunks( Ftype &func, int N )
+{
+    int nChunks = (N+CHUNK-1) / CHUNK;
+    Matrix<Type> part( nChunks, 2 );
+
+    #pragma omp parallel
+    {
+        Ftype f( func );
+        Vector<Type> x( nDim );
+
+        #pragma omp for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int i0 = c*CHUNK,
+                i1 = min( N, i0+CHUNK );
+            Philox rng( key );
+            rng.jump( (nPts+i0)*nDim );
+
+            Type m = 0,
+                 s = 0;
+            for( int i=i0; i<i1; ++i )
+            {
+                for( int d=0; d<nDim; ++d )
+                    x[d] = lo[d] + width[d]*Type(rng.uniform());
+
+                Type y = f( x ),
+                     e = y - m;
+                m += e / (i-i0+1);
+                s += e * (y-m);
+            }
+            part[c][0] = m;
+            part[c][1] = s;
+        }
+    }
+
+    for( int c=0; c<nChunks; ++c )
+    {
+        Type na = Type(nPts),
+             nb = Type( ( N-c*CHUNK < CHUNK ) ? N-c*CHUNK : CHUNK ),
+             e = part[c][0] - mu;
+        mu += e * nb / (na+nb);
+        m2 += part[c][1] + e*e*na*nb/(na+nb);
+        nPts += uint64(nb);
+    }
+}
+
+
+/**
+ * Evaluate the next "N" points of each replica. Replica r is the sequence
+ * scrambled by stream r of the seed, the chunks of all replicas are shared
+ * by the threads, and the sums of each replica are added in order.
+ */
+template <typename Type, typename Ftype>
+template <typename Gen>
+void MCIntegral<Type, Ftype>::qmcChunks( Ftype &func, int N )
+{
+    int nChunks = (N+CHUNK-1) / CHUNK;
+    Vector<Type> part( nRep*nChunks );
+
+    #pragma omp parallel
+    {
+        Ftype f( func );
+        Vector<Type> x( nDim );
+        Gen base( nDim ),
+            g( base );
+        int rep = -1;
+
+        #pragma omp for
+        for( int t=0; t<nRep*nChunks; ++t )
+        {
+            int r = t / nChunks,
+                i0 = (t%nChunks) * CHUNK,
+                i1 = min( N, i0+CHUNK );
+            if( r != rep )
+            {
+                g = base;
+                g.scramble( key, uint64(r) );
+                rep = r;
+            }
+            g.setPosition( nPts+i0 );
+
+            Type s = 0;
+            for( int i=i0; i<i1; ++i )
+            {
+                g.next( x );
+                for( int d=0; d<nDim; ++d )
+                    x[d] = lo[d] + width[d]*x[d];
+                s += f( x );
+            }
+            part[t] = s;
+        }
+    }
+
+    for( int r=0; r<nRep; ++r )
+        for( int c=0; c<nChunks; ++c )
+            sums[r] += part[r*nChunks+c];
+    nPts += N;
+}
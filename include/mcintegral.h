@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 mcintegral.h
+ *
+ * Monte Carlo and quasi-Monte Carlo integration over a box.
+ *
+ * The integral of "func" over the box [lower, upper] is estimated by the
+ * mean of the function values at N points times the volume of the box. The
+ * function is an object like "ObjFunc", i.e. "Type operator()(Vector<Type>&)"
+ * computes the value at a point.
+ *
+ * The points are
+ *      "mc"     : pseudo-random points of a "Philox" stream, the error is
+ *                 estimated by std(f)/sqrt(N), which converges at N^(-1/2);
+ *      "sobol"  : "replicas" independently scrambled Sobol sequences, the
+ *                 estimation is the mean of the replicas, and the error is
+ *                 the standard deviation of the replicas' means divided by
+ *                 sqrt(replicas), which converges at nearly N^(-1) for
+ *                 smooth integrands;
+ *      "halton" : the same as "sobol" with scrambled Halton sequences.
+ *
+ * The points are evaluated in chunks, which run in parallel if OpenMP is
+ * enabled, each thread calls its own copy of the function object. The sums
+ * of the chunks are added in order, so the results don't depend on the
+ * number of threads. The estimation and error are updated by every call of
+ * "integrate", which continues the sequences, so the integration can be
+ * carried on until the error is small enough.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef MCINTEGRAL_H
+#define MCINTEGRAL_H
+
+
+#include <string>
+#include <cmath>
+#include <vector.h>
+#include <philox.h>
+#include <qmc.h>
+
+
+namespace splab
+{
+
+    template <typename Type, typename Ftype>
+    class MCIntegral
+    {
+
+    public:
+
+        typedef unsigned long long  uint64;
+
+        MCIntegral( const Vector<Type> &lower, const Vector<Type> &upper,
+                    const string &method="sobol", int replicas=8,
+                    uint64 seed=1 );
+        ~MCIntegral();
+
+        void reset();
+        Type integrate( Ftype &func, int N );
+        Type integrate( Ftype &func, const Type &tol, int maxN );
+
+        Type getValue() const;
+        Type getError() const;
+        uint64 count() const;
+
+    private:
+
+        static const int CHUNK = 1024;
+
+        int nDim,
+            nRep,
+            type;
+        uint64 key;
+
+        Vector<Type> lo,
+                     width;
+        Type volume;
+
+        // the number of points (of each replica), the mean and M2 of the
+        // function values ("mc"), and the sums of each replica (QMC)
+        uint64 nPts;
+        Type mu, m2;
+        Vector<Type> sums;
+
+        void mcChunks( Ftype &func, int N );
+        template<typename Gen> void qmcChunks( Ftype &func, int N );
+
+    };
+    // class MCIntegral
+
+
+    #include <mcintegral-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// MCINTEGRAL_H
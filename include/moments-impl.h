@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                               moments-impl.h
+ *
+ * Implementation for Moments and ColumnMoments classes.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * Merge the moments of "nb" samples into those of "na" samples:
+ *      d   = mub - mua,    n = na + nb
+ *      mu  = mua + d*nb/n
+ *      M2  = M2a + M2b + d^2*na*nb/n
+ *      M3  = M3a + M3b + d^3*na*nb*(na-nb)/n^2 + 3d*(na*M2b-nb*M2a)/n
+ *      M4  = M4a + M4b + d^4*na*nb*(na^2-na*nb+nb^2)/n^3
+ *            + 6d^2*(na^2*M2b+nb^2*M2a)/n^2 + 4d*(na*M3b-nb*M3a)/n
+ */
+template <typename Type>
+inline void mergeMoments( double na, Type &mua, Type &m2a, Type &m3a,
+                          Type &m4a, double nb, Type mub, Type m2b,
+                          Type m3b, Type m4b )
+{
+    if( nb == 0 )
+        return;
+    if( na == 0 )
+    {
+        mua = mub;
+        m2a = m2b;
+        m3a = m3b;
+        m4a = m4b;
+        return;
+    }
+
+    // the weights are computed in double, the counts may exceed the
+    // integer range of Type
+    double n = na + nb;
+    Type a = Type(na),
+         b = Type(nb),
+         d = mub - mua,
+         dn = Type( d / n ),
+         dn2 = dn*dn,
+         t = d*dn*a*b;
+
+    m4a += m4b + t*dn2*Type(na*na-na*nb+nb*nb)
+           + 6*dn2*(Type(na*na)*m2b+Type(nb*nb)*m2a) + 4*dn*(a*m3b-b*m3a);
+    m3a += m3b + t*dn*Type(na-nb) + 3*dn*(a*m2b-b*m2a);
+    m2a += m2b + t;
+    mua += dn*b;
+}
+
+
+/**
+ * Moments of "N" samples by two passes.
+ */
+template <typename Type>
+void chunkMoments( const Type *x, int N, Type &mu, Type &m2, Type &m3,
+                   Type &m4 )
+{
+    Type s = 0;
+    for( int i=0; i<N; ++i )
+        s += x[i];
+    mu = s / N;
+
+    Type s2 = 0,
+         s3 = 0,
+         s4 = 0;
+    for( int i=0; i<N; ++i )
+    {
+        Type d = x[i]-mu,
+             d2 = d*d;
+        s2 += d2;
+        s3 += d2*d;
+        s4 += d2*d2;
+    }
+
+    m2 = s2;
+    m3 = s3;
+    m4 = s4;
+}
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type>
+Moments<Type>::Moments()
+{
+    reset();
+}
+
+template <typename Type>
+Moments<Type>::~Moments()
+{
+}
+
+
+/**
+ * Clear the accumulator.
+ */
+template <typename Type>
+inline void Moments<Type>::reset()
+{
+    n = 0;
+    mu = 0;
+    m2 = 0;
+    m3 = 0;
+    m4 = 0;
+}
+
+
+/**
+ * Add one sample.
+ */
+template <typename Type>
+inline void Moments<Type>::add( const Type &x )
+{
+    mergeMoments( n, mu, m2, m3, m4, 1.0, x, Type(0), Type(0), Type(0) );
+    n += 1;
+}
+
+
+/**
+ * Add a block of samples.
+ */
+template <typename Type>
+void Moments<Type>::add( const Vector<Type> &xn )
+{
+    int N = xn.size(),
+        nChunks = (N+CHUNK-1) / CHUNK;
+    Matrix<Type> part( nChunks, 4 );
+
+    #pragma omp parallel for
+    for( int c=0; c<nChunks; ++c )
+    {
+        int i0 = c*CHUNK,
+            nb = ( N-i0 < CHUNK ) ? N-i0 : CHUNK;
+        chunkMoments( &xn[i0], nb,
+                      part[c][0], part[c][1], part[c][2], part[c][3] );
+    }
+
+    for( int c=0; c<nChunks; ++c )
+    {
+        double nb = ( N-c*CHUNK < CHUNK ) ? N-c*CHUNK : CHUNK;
+        mergeMoments( n, mu, m2, m3, m4, nb,
+                      part[c][0], part[c][1], part[c][2], part[c][3] );
+        n += nb;
+    }
+}
+
+
+/**
+ * Merge the accumulator of another part of data.
+ */
+template <typename Type>
+inline void Moments<Type>::merge( const Moments<Type> &rhs )
+{
+    mergeMoments( n, mu, m2, m3, m4, rhs.n, rhs.mu, rhs.m2, rhs.m3, rhs.m4 );
+    n += rhs.n;
+}
+
+
+/**
+ * Get and set the state: count, mean, M2, M3 and M4.
+ */
+template <typename Type>
+Vector<double> Moments<Type>::getState() const
+{
+    Vector<double> s(5);
+    s[0] = n;
+    s[1] = mu;
+    s[2] = m2;
+    s[3] = m3;
+    s[4] = m4;
+
+    return s;
+}
+
+template <typename Type>
+void Moments<Type>::setState( const Vector<double> &s )
+{
+    assert( s.size() == 5 );
+
+    n = s[0];
+    mu = Type( s[1] );
+    m2 = Type( s[2] );
+    m3 = Type( s[3] );
+    m4 = Type( s[4] );
+}
+
+
+/**
+ * Get the count, mean, variance, standard variance, skew and kurtosis.
+ */
+template <typename Type>
+inline double Moments<Type>::count() const
+{
+    return n;
+}
+
+template <typename Type>
+inline Type Moments<Type>::getMean() const
+{
+    return mu;
+}
+
+template <typename Type>
+inline Type Moments<Type>::getVar() const
+{
+    return ( n > 1 ) ? Type( m2 / (n-1) ) : Type(0);
+}
+
+template <typename Type>
+inline Type Moments<Type>::getStdVar() const
+{
+    return sqrt( getVar() );
+}
+
+template <typename Type>
+Type Moments<Type>::getSkew() const
+{
+    Type s = getStdVar();
+    return ( s > 0 ) ? Type( m3 / (n*s*s*s) ) : Type(0);
+}
+
+template <typename Type>
+Type Moments<Type>::getKurt() const
+{
+    Type d = getVar();
+    return ( d > 0 ) ? Type( m4 / (n*d*d) - 3 ) : Type(0);
+}
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type>
+ColumnMoments<Type>::ColumnMoments( int cols )
+: nCols(cols), mu(cols), m2(cols), m3(cols), m4(cols)
+{
+    assert( cols > 0 );
+
+    reset();
+}
+
+template <typename Type>
+ColumnMoments<Type>::~ColumnMoments()
+{
+}
+
+
+/**
+ * Clear the accumulator.
+ */
+template <typename Type>
+void ColumnMoments<Type>::reset()
+{
+    n = 0;
+    mu = Type(0);
+    m2 = Type(0);
+    m3 = Type(0);
+    m4 = Type(0);
+}
+
+
+/**
+ * Merge the moments of "nb" rows of each column.
+ */
+template <typename Type>
+void ColumnMoments<Type>::mergeRows( double nb, const Type *mub,
+                                     const Type *m2b, const Type *m3b,
+                                     const Type *m4b )
+{
+    for( int j=0; j<nCols; ++j )
+        mergeMoments( n, mu[j], m2[j], m3[j], m4[j],
+                      nb, mub[j], m2b[j], m3b[j], m4b[j] );
+    n += nb;
+}
+
+
+/**
+ * Add one row.
+ */
+template <typename Type>
+void ColumnMoments<Type>::add( const Vector<Type> &row )
+{
+    assert( row.size() == nCols );
+
+    for( int j=0; j<nCols; ++j )
+        mergeMoments( n, mu[j], m2[j], m3[j], m4[j], 1.0, row[j],
+                      Type(0), Type(0), Type(0) );
+    n += 1;
+}
+
+
+/**
+ * Add the rows of a matrix.
+ */
+template <typename Type>
+void ColumnMoments<Type>::add( const Matrix<Type> &A )
+{
+    assert( A.cols() == nCols );
+
+    int R = A.rows(),
+        C = nCols,
+        nChunks = (R+CHUNK-1) / CHUNK;
+    Matrix<Type> part( nChunks, 4*C );
+
+    #pragma omp parallel for
+    for( int c=0; c<nChunks; ++c )
+    {
+        int r0 = c*CHUNK,
+            r1 = min( R, r0+CHUNK );
+        Type *pm = part[c],
+             *p2 = pm+C,
+             *p3 = pm+2*C,
+             *p4 = pm+3*C;
+
+        for( int j=0; j<C; ++j )
+            pm[j] = 0;
+        for( int r=r0; r<r1; ++r )
+        {
+            const Type *a = A[r];
+            for( int j=0; j<C; ++j )
+                pm[j] += a[j];
+        }
+        for( int j=0; j<C; ++j )
+            pm[j] /= r1-r0;
+
+        for( int j=0; j<3*C; ++j )
+            p2[j] = 0;
+        for( int r=r0; r<r1; ++r )
+        {
+            const Type *a = A[r];
+            for( int j=0; j<C; ++j )
+            {
+                Type d = a[j]-pm[j],
+                     d2 = d*d;
+                p2[j] += d2;
+                p3[j] += d2*d;
+                p4[j] += d2*d2;
+            }
+        }
+    }
+
+    for( int c=0; c<nChunks; ++c )
+    {
+        const Type *pm = part[c];
+        int nb = ( R-c*CHUNK < CHUNK ) ? R-c*CHUNK : CHUNK;
+        mergeRows( nb, pm, pm+C, pm+2*C, pm+3*C );
+    }
+}
+
+
+/**
+ * Merge the accumulator of another part of rows.
+ */
+template <typename Type>
+void ColumnMoments<Type>::merge( const ColumnMoments<Type> &rhs )
+{
+    assert( rhs.nCols == nCols );
+
+    mergeRows( rhs.n, &rhs.mu[0], &rhs.m2[0], &rhs.m3[0], &rhs.m4[0] );
+}
+
+
+/**
+ * Get and set the state, a 5-by-cols matrix whose rows are count, mean,
+ * M2, M3 and M4.
+ */
+template <typename Type>
+Matrix<double> ColumnMoments<Type>::getState() const
+{
+    Matrix<double> s( 5, nCols );
+    for( int j=0; j<nCols; ++j )
+    {
+        s[0][j] = n;
+        s[1][j] = mu[j];
+        s[2][j] = m2[j];
+        s[3][j] = m3[j];
+        s[4][j] = m4[j];
+    }
+
+    return s;
+}
+
+template <typename Type>
+void ColumnMoments<Type>::setState( const Matrix<double> &s )
+{
+    assert( s.rows() == 5 );
+    assert( s.cols() == nCols );
+
+    n = s[0][0];
+    for( int j=0; j<nCols; ++j )
+    {
+        mu[j] = Type( s[1][j] );
+        m2[j] = Type( s[2][j] );
+        m3[j] = Type( s[3][j] );
+        m4[j] = Type( s[4][j] );
+    }
+}
+
+
+/**
+ * Get the number of columns, count, and the mean, variance, standard
+ * variance, skew and kurtosis of each column.
+ */
+template <typename Type>
+inline int ColumnMoments<Type>::cols() const
+{
+    return nCols;
+}
+
+template <typename Type>
+inline double ColumnMoments<Type>::count() const
+{
+    return n;
+}
+
+template <typename Type>
+inline Vector<Type> ColumnMoments<Type>::getMean() const
+{
+    return mu;
+}
+
+template <typename Type>
+Vector<Type> ColumnMoments<Type>::getVar() const
+{
+    Vector<Type> v(nCols);
+    if( n > 1 )
+        for( int j=0; j<nCols; ++j )
+            v[j] = Type( m2[j] / (n-1) );
+
+    return v;
+}
+
+template <typename Type>
+Vector<Type> ColumnMoments<Type>::getStdVar() const
+{
+    Vector<Type> v = getVar();
+    for( int j=0; j<nCols; ++j )
+        v[j] = sqrt( v[j] );
+
+    return v;
+}
+
+template <typename Type>
+Vector<Type> ColumnMoments<Type>::getSkew() const
+{
+    Vector<Type> v = getStdVar();
+    for( int j=0; j<nCols; ++j )
+        v[j] = ( v[j] > 0 ) ? Type( m3[j] / (n*v[j]*v[j]*v[j]) ) : Type(0);
+
+    return v;
+}
+
+template <typename Type>
+Vector<Type> ColumnMoments<Type>::getKurt() const
+{
+    Vector<Type> v = getVar();
+    for( int j=0; j<nCols; ++j )
+        v[j] = ( v[j] > 0 ) ? Type( m4[j] / (n*v[j]*v[j]) - 3 ) : Type(0);
+
+    return v;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                  moments.h
+ *
+ * Mergeable one-pass accumulators of statistical moments.
+ *
+ * "Moments" accumulates the count, mean and the sums of the 2nd, 3rd and 4th
+ * powers of the deviations (M2, M3, M4) of a sequence, and "ColumnMoments"
+ * does the same for each column of a matrix, whose rows are the samples.
+ * Two accumulators of disjoint data are merged by the pairwise formulas
+ * (Chan et al., 1979, and Pebay, 2008), so a large data set can be reduced
+ * chunk by chunk, by threads or by processes, and the results are merged.
+ * The state of an accumulator can be got and set as a vector (a matrix for
+ * columns), which makes it easy to be saved or transferred. The count is
+ * kept in double precision, so it is exact up to 2^53 samples even for
+ * float data, and so is the state.
+ *
+ * A block of samples is split into chunks, whose moments are computed by
+ * two passes over the chunk (in parallel if OpenMP is enabled), and then
+ * merged in order, so the result doesn't depend on the number of threads.
+ * The column moments of a chunk are computed row by row over contiguous
+ * memory, which can be vectorized by the compiler.
+ *
+ * The definitions of variance, skew and kurtosis are the same as "var",
+ * "skew" and "kurt" in "statistics.h".
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef MOMENTS_H
+#define MOMENTS_H
+
+
+#include <vector.h>
+#include <matrix.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class Moments
+    {
+
+    public:
+
+        Moments();
+        ~Moments();
+
+        void reset();
+        void add( const Type &x );
+        void add( const Vector<Type> &xn );
+        void merge( const Moments<Type> &rhs );
+
+        Vector<double> getState() const;
+        void setState( const Vector<double> &s );
+
+        double count() const;
+        Type getMean() const;
+        Type getVar() const;
+        Type getStdVar() const;
+        Type getSkew() const;
+        Type getKurt() const;
+
+    private:
+
+        static const int CHUNK = 4096;
+
+        double n;
+        Type mu, m2, m3, m4;
+
+    };
+    // class Moments
+
+
+    template <typename Type>
+    class ColumnMoments
+    {
+
+    public:
+
+        explicit ColumnMoments( int cols );
+        ~ColumnMoments();
+
+        void reset();
+        void add( const Vector<Type> &row );
+        void add( const Matrix<Type> &A );
+        void merge( const ColumnMoments<Type> &rhs );
+
+        Matrix<double> getState() const;
+        void setState( const Matrix<double> &s );
+
+        int cols() const;
+        double count() const;
+        Vector<Type> getMean() const;
+        Vector<Type> getVar() const;
+        Vector<Type> getStdVar() const;
+        Vector<Type> getSkew() const;
+        Vector<Type> getKurt() const;
+
+    private:
+
+        static const int CHUNK = 256;
+
+        int nCols;
+        double n;
+        Vector<Type> mu, m2, m3, m4;
+
+        void mergeRows( double nb, const Type *mub, const Type *m2b,
+                        const Type *m3b, const Type *m4b );
+
+    };
+    // class ColumnMoments
+
+
+    template<typename Type>
+    static void mergeMoments( double na, Type &mua, Type &m2a, Type &m3a,
+                              Type &m4a, double nb, Type mub, Type m2b,
+                              Type m3b, Type m4b );
+
+    template<typename Type>
+    static void chunkMoments( const Type *x, int N, Type &mu, Type &m2,
+                              Type &m3, Type &m4 );
+
+
+    #include <moments-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// MOMENTS_H
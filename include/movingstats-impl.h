@@ -0,0 +1,751 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                             movingstats-impl.h
+ *
+ * Implementation for MovingMoments, MovingMedian and MovingMinMax classes.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * L        : window length
+ * nChan    : the number of channels
+ */
+template <typename Type>
+MovingMoments<Type>::MovingMoments( int L, int nChan )
+: W(L), C(nChan), buf(nChan,L),
+  mu(nChan), m2(nChan), m3(nChan), m4(nChan)
+{
+    assert( L > 0 );
+    assert( nChan > 0 );
+
+    reset();
+}
+
+template <typename Type>
+MovingMoments<Type>::~MovingMoments()
+{
+}
+
+
+/**
+ * Clear the windows.
+ */
+template <typename Type>
+void MovingMoments<Type>::reset()
+{
+    count = 0;
+    head = W-1;
+    nRefresh = 0;
+
+    buf = Type(0);
+    mu = Type(0);
+    m2 = Type(0);
+    m3 = Type(0);
+    m4 = Type(0);
+}
+
+/**
+ * Input one sample of a single channel stream.
+ */
+template <typename Type>
+void MovingMoments<Type>::input( const Type &x )
+{
+    assert( C == 1 );
+
+    if( ++head == W )
+        head = 0;
+    update( 0, x, head, count );
+    if( count < W )
+        count++;
+
+    if( ++nRefresh == W )
+    {
+        refresh( 0, count );
+        nRefresh = 0;
+    }
+}
+
+
+/**
+ * Input a block of samples of a single channel stream.
+ */
+template <typename Type>
+void MovingMoments<Type>::input( const Vector<Type> &xn )
+{
+    for( int k=0; k<xn.size(); ++k )
+        input( xn[k] );
+}
+
+
+/**
+ * Input a C-by-K block, the k-th column is the samples of all channels at
+ * the k-th moment.
+ */
+template <typename Type>
+void MovingMoments<Type>::input( const Matrix<Type> &xn )
+{
+    assert( xn.rows() == C );
+
+    int K = xn.cols();
+
+    #pragma omp parallel for
+    for( int c=0; c<C; ++c )
+    {
+        int s = head,
+            n = count,
+            r = nRefresh;
+        for( int k=0; k<K; ++k )
+        {
+            if( ++s == W )
+                s = 0;
+            update( c, xn[c][k], s, n );
+            if( n < W )
+                n++;
+
+            if( ++r == W )
+            {
+                refresh( c, n );
+                r = 0;
+            }
+        }
+    }
+
+    head = (head+K) % W;
+    count = min( W, count+K );
+    nRefresh = (nRefresh+K) % W;
+}
+
+
+/**
+ * Get the window length, the number of channels and the number of samples
+ * in the window.
+ */
+template <typename Type>
+inline int MovingMoments<Type>::window() const
+{
+    return W;
+}
+
+template <typename Type>
+inline int MovingMoments<Type>::channels() const
+{
+    return C;
+}
+
+template <typename Type>
+inline int MovingMoments<Type>::size() const
+{
+    return count;
+}
+
+
+/**
+ * The sample "x" enters the window of channel "c" at the position "slot",
+ * and the sample at this position leaves if the window (having n samples)
+ * is full. The central moments are updated by
+ *      M4 += t*d^2*(n^2-3n+3) + 6*d^2*M2 - 4*d*M3
+ *      M3 += t*d*(n-2) - 3*d*M2
+ *      M2 += t
+ * for adding a sample, where n is the new size, d = (x-mean)/n and
+ * t = (x-mean)*d*(n-1), and by the inverse formulas for removing one.
+ */
+template <typename Type>
+void MovingMoments<Type>::update( int c, const Type &x, int slot, int n )
+{
+    Type *b = buf[c];
+    Type delta, dn, dn2, t, nn;
+
+    if( n == W )
+    {
+        Type xOld = b[slot];
+        if( n == 1 )
+        {
+            mu[c] = 0;
+            m2[c] = 0;
+            m3[c] = 0;
+            m4[c] = 0;
+        }
+        else
+        {
+            nn = Type(n);
+            Type muOld = ( nn*mu[c] - xOld ) / (nn-1);
+            delta = xOld - muOld;
+            dn = delta / nn;
+            dn2 = dn*dn;
+            t = delta*dn*(nn-1);
+
+            m2[c] -= t;
+            m3[c] -= t*dn*(nn-2) - 3*dn*m2[c];
+            m4[c] -= t*dn2*(nn*nn-3*nn+3) + 6*dn2*m2[c] - 4*dn*m3[c];
+            mu[c] = muOld;
+        }
+        n--;
+    }
+
+    nn = Type(n+1);
+    delta = x - mu[c];
+    dn = delta / nn;
+    dn2 = dn*dn;
+    t = delta*dn*n;
+
+    m4[c] += t*dn2*(nn*nn-3*nn+3) + 6*dn2*m2[c] - 4*dn*m3[c];
+    m3[c] += t*dn*(nn-2) - 3*dn*m2[c];
+    m2[c] += t;
+    mu[c] += dn;
+
+    b[slot] = x;
+}
+
+
+/**
+ * Recompute the moments of channel "c" from the "n" samples in the window.
+ */
+template <typename Type>
+void MovingMoments<Type>::refresh( int c, int n )
+{
+    const Type *b = buf[c];
+
+    Type m = 0;
+    for( int i=0; i<n; ++i )
+        m += b[i];
+    m /= n;
+
+    Type s2 = 0,
+         s3 = 0,
+         s4 = 0;
+    for( int i=0; i<n; ++i )
+    {
+        Type d = b[i]-m,
+             d2 = d*d;
+        s2 += d2;
+        s3 += d2*d;
+        s4 += d2*d2;
+    }
+
+    mu[c] = m;
+    m2[c] = s2;
+    m3[c] = s3;
+    m4[c] = s4;
+}
+
+
+/**
+ * Get the mean, variance, standard variance, skew and kurtosis of the
+ * window of channel "c".
+ */
+template <typename Type>
+inline Type MovingMoments<Type>::getMean( int c ) const
+{
+    return mu[c];
+}
+
+template <typename Type>
+inline Type MovingMoments<Type>::getVar( int c ) const
+{
+    return ( count > 1 ) ? m2[c] / (count-1) : Type(0);
+}
+
+template <typename Type>
+inline Type MovingMoments<Type>::getStdVar( int c ) const
+{
+    return sqrt( getVar(c) );
+}
+
+template <typename Type>
+Type MovingMoments<Type>::getSkew( int c ) const
+{
+    Type s = getStdVar(c);
+    return ( s > 0 ) ? m3[c] / (count*s*s*s) : Type(0);
+}
+
+template <typename Type>
+Type MovingMoments<Type>::getKurt( int c ) const
+{
+    Type d = getVar(c);
+    return ( d > 0 ) ? m4[c] / (count*d*d) - 3 : Type(0);
+}
+
+
+/**
+ * constructors and destructor
+ * L        : window length
+ * nChan    : the number of channels
+ */
+template <typename Type>
+MovingMedian<Type>::MovingMedian( int L, int nChan )
+: W(L), C(nChan), buf(nChan,L),
+  lo(nChan,(L+1)/2), hi(nChan,L/2+1), where(nChan,L)
+{
+    assert( L > 0 );
+    assert( nChan > 0 );
+
+    reset();
+}
+
+template <typename Type>
+MovingMedian<Type>::~MovingMedian()
+{
+}
+
+
+/**
+ * Clear the windows.
+ */
+template <typename Type>
+void MovingMedian<Type>::reset()
+{
+    count = 0;
+    head = W-1;
+
+    buf = Type(0);
+}
+
+/**
+ * Input one sample of a single channel stream.
+ */
+template <typename Type>
+void MovingMedian<Type>::input( const Type &x )
+{
+    assert( C == 1 );
+
+    if( ++head == W )
+        head = 0;
+    update( 0, x, head, count );
+    if( count < W )
+        count++;
+}
+
+
+/**
+ * Input a block of samples of a single channel stream.
+ */
+template <typename Type>
+void MovingMedian<Type>::input( const Vector<Type> &xn )
+{
+    for( int k=0; k<xn.size(); ++k )
+        input( xn[k] );
+}
+
+
+/**
+ * Input a C-by-K block, the k-th column is the samples of all channels at
+ * the k-th moment.
+ */
+template <typename Type>
+void MovingMedian<Type>::input( const Matrix<Type> &xn )
+{
+    assert( xn.rows() == C );
+
+    int K = xn.cols();
+
+    #pragma omp parallel for
+    for( int c=0; c<C; ++c )
+    {
+        int s = head,
+            n = count;
+        for( int k=0; k<K; ++k )
+        {
+            if( ++s == W )
+                s = 0;
+            update( c, xn[c][k], s, n );
+            if( n < W )
+                n++;
+        }
+    }
+
+    head = (head+K) % W;
+    count = min( W, count+K );
+}
+
+
+/**
+ * Get the window length, the number of channels and the number of samples
+ * in the window.
+ */
+template <typename Type>
+inline int MovingMedian<Type>::window() const
+{
+    return W;
+}
+
+template <typename Type>
+inline int MovingMedian<Type>::channels() const
+{
+    return C;
+}
+
+template <typename Type>
+inline int MovingMedian<Type>::size() const
+{
+    return count;
+}
+
+
+/**
+ * The sample "x" enters the window of channel "c" at the position "slot".
+ * If the window is full, the leaving sample is replaced in its heap, and
+ * then the tops of the two heaps are swapped if they are out of order.
+ */
+template <typename Type>
+void MovingMedian<Type>::update( int c, const Type &x, int slot, int n )
+{
+    int *w = where[c];
+    buf[c][slot] = x;
+
+    if( n == W )
+    {
+        if( w[slot] >= 0 )
+        {
+            siftUpLo( c, w[slot] );
+            siftDownLo( c, w[slot], (n+1)/2 );
+        }
+        else
+        {
+            siftUpHi( c, -w[slot]-1 );
+            siftDownHi( c, -w[slot]-1, n/2 );
+        }
+    }
+    else
+    {
+        // the smaller half has one more sample if n+1 is odd
+        if( (n+2)/2 > (n+1)/2 )
+        {
+            int i = (n+1)/2;
+            lo[c][i] = slot;
+            w[slot] = i;
+            siftUpLo( c, i );
+        }
+        else
+        {
+            int i = n/2;
+            hi[c][i] = slot;
+            w[slot] = -(i+1);
+            siftUpHi( c, i );
+        }
+        n++;
+    }
+
+    balance( c, n );
+}
+
+
+/**
+ * Heap operations, "n" is the size of the heap.
+ */
+template <typename Type>
+void MovingMedian<Type>::siftUpLo( int c, int i )
+{
+    const Type *b = buf[c];
+    int *h = lo[c],
+        *w = where[c];
+
+    while( i > 0 )
+    {
+        int p = (i-1) / 2;
+        if( !( b[h[p]] < b[h[i]] ) )
+            break;
+
+        swap( h[p], h[i] );
+        w[h[p]] = p;
+        w[h[i]] = i;
+        i = p;
+    }
+}
+
+template <typename Type>
+void MovingMedian<Type>::siftDownLo( int c, int i, int n )
+{
+    const Type *b = buf[c];
+    int *h = lo[c],
+        *w = where[c];
+
+    for( int k=2*i+1; k<n; k=2*i+1 )
+    {
+        if( k+1 < n && b[h[k]] < b[h[k+1]] )
+            k++;
+        if( !( b[h[i]] < b[h[k]] ) )
+            break;
+
+        swap( h[k], h[i] );
+        w[h[k]] = k;
+        w[h[i]] = i;
+        i = k;
+    }
+}
+
+template <typename Type>
+void MovingMedian<Type>::siftUpHi( int c, int i )
+{
+    const Type *b = buf[c];
+    int *h = hi[c],
+        *w = where[c];
+
+    while( i > 0 )
+    {
+        int p = (i-1) / 2;
+        if( !( b[h[i]] < b[h[p]] ) )
+            break;
+
+        swap( h[p], h[i] );
+        w[h[p]] = -(p+1);
+        w[h[i]] = -(i+1);
+        i = p;
+    }
+}
+
+template <typename Type>
+void MovingMedian<Type>::siftDownHi( int c, int i, int n )
+{
+    const Type *b = buf[c];
+    int *h = hi[c],
+        *w = where[c];
+
+    for( int k=2*i+1; k<n; k=2*i+1 )
+    {
+        if( k+1 < n && b[h[k+1]] < b[h[k]] )
+            k++;
+        if( !( b[h[k]] < b[h[i]] ) )
+            break;
+
+        swap( h[k], h[i] );
+        w[h[k]] = -(k+1);
+        w[h[i]] = -(i+1);
+        i = k;
+    }
+}
+
+
+/**
+ * Keep the maximum of the smaller half not greater than the minimum of the
+ * larger half, "n" is the number of samples in the window. Only one sample
+ * changes in each update, so one swap is enough.
+ */
+template <typename Type>
+void MovingMedian<Type>::balance( int c, int n )
+{
+    const Type *b = buf[c];
+    int *l = lo[c],
+        *h = hi[c],
+        *w = where[c];
+
+    if( n/2 > 0 && b[h[0]] < b[l[0]] )
+    {
+        swap( l[0], h[0] );
+        w[l[0]] = 0;
+        w[h[0]] = -1;
+        siftDownLo( c, 0, (n+1)/2 );
+        siftDownHi( c, 0, n/2 );
+    }
+}
+
+
+/**
+ * Get the median of the window of channel "c".
+ */
+template <typename Type>
+inline Type MovingMedian<Type>::getMedian( int c ) const
+{
+    return ( count > 0 ) ? buf[c][lo[c][0]] : Type(0);
+}
+
+
+/**
+ * constructors and destructor
+ * L        : window length
+ * nChan    : the number of channels
+ */
+template <typename Type>
+MovingMinMax<Type>::MovingMinMax( int L, int nChan )
+: W(L), C(nChan), buf(nChan,L),
+  qMin(nChan,L), qMax(nChan,L),
+  fMin(nChan), nMin(nChan), fMax(nChan), nMax(nChan)
+{
+    assert( L > 0 );
+    assert( nChan > 0 );
+
+    reset();
+}
+
+template <typename Type>
+MovingMinMax<Type>::~MovingMinMax()
+{
+}
+
+
+/**
+ * Clear the windows.
+ */
+template <typename Type>
+void MovingMinMax<Type>::reset()
+{
+    count = 0;
+    head = W-1;
+
+    buf = Type(0);
+    fMin = 0;
+    nMin = 0;
+    fMax = 0;
+    nMax = 0;
+}
+
+/**
+ * Input one sample of a single channel stream.
+ */
+template <typename Type>
+void MovingMinMax<Type>::input( const Type &x )
+{
+    assert( C == 1 );
+
+    if( ++head == W )
+        head = 0;
+    update( 0, x, head, count );
+    if( count < W )
+        count++;
+}
+
+
+/**
+ * Input a block of samples of a single channel stream.
+ */
+template <typename Type>
+void MovingMinMax<Type>::input( const Vector<Type> &xn )
+{
+    for( int k=0; k<xn.size(); ++k )
+        input( xn[k] );
+}
+
+
+/**
+ * Input a C-by-K block, the k-th column is the samples of all channels at
+ * the k-th moment.
+ */
+template <typename Type>
+void MovingMinMax<Type>::input( const Matrix<Type> &xn )
+{
+    assert( xn.rows() == C );
+
+    int K = xn.cols();
+
+    #pragma omp parallel for
+    for( int c=0; c<C; ++c )
+    {
+        int s = head,
+            n = count;
+        for( int k=0; k<K; ++k )
+        {
+            if( ++s == W )
+                s = 0;
+            update( c, xn[c][k], s, n );
+            if( n < W )
+                n++;
+        }
+    }
+
+    head = (head+K) % W;
+    count = min( W, count+K );
+}
+
+
+/**
+ * Get the window length, the number of channels and the number of samples
+ * in the window.
+ */
+template <typename Type>
+inline int MovingMinMax<Type>::window() const
+{
+    return W;
+}
+
+template <typename Type>
+inline int MovingMinMax<Type>::channels() const
+{
+    return C;
+}
+
+template <typename Type>
+inline int MovingMinMax<Type>::size() const
+{
+    return count;
+}
+
+
+/**
+ * The sample "x" enters the window of channel "c" at the position "slot".
+ * The leaving sample is dropped from the front of the queues, and the
+ * samples which can never be the minimum (maximum) are dropped from the
+ * back of the queue.
+ */
+template <typename Type>
+void MovingMinMax<Type>::update( int c, const Type &x, int slot, int n )
+{
+    Type *b = buf[c];
+    int *qm = qMin[c],
+        *qM = qMax[c];
+
+    if( n == W )
+    {
+        if( nMin[c] > 0 && qm[fMin[c]] == slot )
+        {
+            fMin[c] = (fMin[c]+1) % W;
+            nMin[c]--;
+        }
+        if( nMax[c] > 0 && qM[fMax[c]] == slot )
+        {
+            fMax[c] = (fMax[c]+1) % W;
+            nMax[c]--;
+        }
+    }
+    b[slot] = x;
+
+    while( nMin[c] > 0 && !( b[qm[(fMin[c]+nMin[c]-1)%W]] < x ) )
+        nMin[c]--;
+    qm[(fMin[c]+nMin[c])%W] = slot;
+    nMin[c]++;
+
+    while( nMax[c] > 0 && !( x < b[qM[(fMax[c]+nMax[c]-1)%W]] ) )
+        nMax[c]--;
+    qM[(fMax[c]+nMax[c])%W] = slot;
+    nMax[c]++;
+}
+
+
+/**
+ * Get the minimum and maximum of the window of channel "c".
+ */
+template <typename Type>
+inline Type MovingMinMax<Type>::getMin( int c ) const
+{
+    return ( count > 0 ) ? buf[c][qMin[c][fMin[c]]] : Type(0);
+}
+
+template <typename Type>
+inline Type MovingMinMax<Type>::getMax( int c ) const
+{
+    return ( count > 0 ) ? buf[c][qMax[c][fMax[c]]] : Type(0);
+}
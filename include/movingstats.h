@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                movingstats.h
+ *
+ * Sliding window statistics of multi-channel streams.
+ *
+ * These classes compute the statistics of the latest W samples of each
+ * channel, the samples are input one by one, or by blocks of a C-by-K matrix
+ * whose columns are the samples of the C channels at K moments. Each update
+ * costs O(1) (O(log W) for the median) instead of recomputing the window:
+ *
+ * MovingMoments    : mean, variance, standard variance, skew and kurtosis,
+ *                    the central moments are updated by the one-pass
+ *                    formulas (Welford and Pebay) when a sample enters or
+ *                    leaves the window, and recomputed every W samples to
+ *                    avoid the accumulation of rounding errors;
+ * MovingMedian     : median, the window is split into a max-heap of the
+ *                    smaller half and a min-heap of the larger half, the
+ *                    leaving sample is replaced by the entering one in
+ *                    its heap;
+ * MovingMinMax     : minimum and maximum, by monotonic queues of the
+ *                    window positions.
+ *
+ * The definitions are the same as "var", "skew", "kurt" and "mid" in
+ * "statistics.h", i.e. the variance is divided by n-1, and the median of an
+ * even number of samples is the lower one of the two middle samples. If
+ * OpenMP is enabled, the channels of a block are processed in parallel.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef MOVINGSTATS_H
+#define MOVINGSTATS_H
+
+
+#include <vector.h>
+#include <matrix.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class MovingMoments
+    {
+
+    public:
+
+        MovingMoments( int W, int C=1 );
+        ~MovingMoments();
+
+        void reset();
+        void input( const Type &x );
+        void input( const Vector<Type> &xn );
+        void input( const Matrix<Type> &xn );
+
+        int window() const;
+        int channels() const;
+        int size() const;
+
+        Type getMean( int c=0 ) const;
+        Type getVar( int c=0 ) const;
+        Type getStdVar( int c=0 ) const;
+        Type getSkew( int c=0 ) const;
+        Type getKurt( int c=0 ) const;
+
+    private:
+
+        // window length, channels, samples in the window, position of the
+        // newest sample and samples since the last recomputation
+        int W;
+        int C;
+        int count;
+        int head;
+        int nRefresh;
+
+        // samples of the window, one row for one channel
+        Matrix<Type> buf;
+
+        // mean and the sums of 2nd, 3rd and 4th powers of deviations
+        Vector<Type> mu, m2, m3, m4;
+
+        void update( int c, const Type &x, int slot, int n );
+        void refresh( int c, int n );
+
+    };
+    // class MovingMoments
+
+
+    template <typename Type>
+    class MovingMedian
+    {
+
+    public:
+
+        MovingMedian( int W, int C=1 );
+        ~MovingMedian();
+
+        void reset();
+        void input( const Type &x );
+        void input( const Vector<Type> &xn );
+        void input( const Matrix<Type> &xn );
+
+        int window() const;
+        int channels() const;
+        int size() const;
+
+        Type getMedian( int c=0 ) const;
+
+    private:
+
+        int W;
+        int C;
+        int count;
+        int head;
+
+        Matrix<Type> buf;
+
+        // window positions in the max-heap of the smaller half (lo) and
+        // the min-heap of the larger half (hi), and the place of each
+        // position, i >= 0 for lo[i] and -(i+1) for hi[i]
+        Matrix<int> lo, hi;
+        Matrix<int> where;
+
+        void update( int c, const Type &x, int slot, int n );
+        void siftUpLo( int c, int i );
+        void siftDownLo( int c, int i, int n );
+        void siftUpHi( int c, int i );
+        void siftDownHi( int c, int i, int n );
+        void balance( int c, int n );
+
+    };
+    // class MovingMedian
+
+
+    template <typename Type>
+    class MovingMinMax
+    {
+
+    public:
+
+        MovingMinMax( int W, int C=1 );
+        ~MovingMinMax();
+
+        void reset();
+        void input( const Type &x );
+        void input( const Vector<Type> &xn );
+        void input( const Matrix<Type> &xn );
+
+        int window() const;
+        int channels() const;
+        int size() const;
+
+        Type getMin( int c=0 ) const;
+        Type getMax( int c=0 ) const;
+
+    private:
+
+        int W;
+        int C;
+        int count;
+        int head;
+
+        Matrix<Type> buf;
+
+        // circular queues of window positions, whose samples are increasing
+        // (for minimum) or decreasing (for maximum) from the front
+        Matrix<int> qMin, qMax;
+        Vector<int> fMin, nMin, fMax, nMax;
+
+        void update( int c, const Type &x, int slot, int n );
+
+    };
+    // class MovingMinMax
+
+
+    #include <movingstats-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// MOVINGSTATS_H
@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              nlkalman-impl.h
+ *
+ * Implementation for UKF and EnKF class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * Weighted mean of the N points (rows of the N-by-n array X). If "w" is
+ * null, all points have the weight 1/N.
+ */
+template <typename Type>
+void pointsMean( int N, int n, const Type *X, const Type *w, Type *mean )
+{
+    for( int j=0; j<n; ++j )
+        mean[j] = 0;
+
+    for( int i=0; i<N; ++i )
+    {
+        const Type *xi = X + i*n;
+        Type wi = w ? w[i] : Type(1)/N;
+        for( int j=0; j<n; ++j )
+            mean[j] += wi*xi[j];
+    }
+}
+
+
+/**
+ * Weighted cross covariance C = sum_i w_i * A_i' * B_i (n-by-m) of the N
+ * deviation vectors (rows of A and B). If "w" is null, all points have the
+ * weight 1/(N-1). The rows of C are computed in parallel.
+ */
+template <typename Type>
+void pointsCov( int N, int n, int m, const Type *A, const Type *B,
+                const Type *w, Type *C )
+{
+    #pragma omp parallel for
+    for( int j=0; j<n; ++j )
+    {
+        Type *cj = C + j*m;
+        for( int k=0; k<m; ++k )
+            cj[k] = 0;
+
+        for( int i=0; i<N; ++i )
+        {
+            const Type *bi = B + i*m;
+            Type a = ( w ? w[i] : Type(1)/(N-1) ) * A[i*n+j];
+            for( int k=0; k<m; ++k )
+                cj[k] += a*bi[k];
+        }
+    }
+}
+
+
+/**
+ * Kalman gain K = Pxz*inv(Pzz) (n-by-m), solved by the Cholesky factor of
+ * Pzz, which is stored in the m-by-m work array "L". Return false if Pzz is
+ * not positive definite.
+ */
+template <typename Type>
+bool gainSolve( int n, int m, const Type *Pxz, Type *Pzz, Type *K, Type *L )
+{
+    if( !lowerCholesky( m, Pzz, L ) )
+        return false;
+    for( int l=0; l<m; ++l )
+        if( L[l*m+l] == 0 )
+            return false;
+
+    for( int i=0; i<n; ++i )
+    {
+        Type *ki = K + i*m;
+        const Type *pi = Pxz + i*m;
+        for( int l=0; l<m; ++l )
+        {
+            Type sum = pi[l];
+            for( int k=0; k<l; ++k )
+                sum -= L[l*m+k] * ki[k];
+            ki[l] = sum / L[l*m+l];
+        }
+        for( int l=m-1; l>=0; --l )
+        {
+            Type sum = ki[l];
+            for( int k=l+1; k<m; ++k )
+                sum -= L[k*m+l] * ki[k];
+            ki[l] = sum / L[l*m+l];
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * constructors and destructor of UKF
+ */
+template <typename Type>
+UKF<Type>::UKF( const Type &alpha, const Type &beta, const Type &kappa )
+          : alpha(alpha), beta(beta), kappa(kappa)
+{
+}
+
+template <typename Type>
+UKF<Type>::~UKF()
+{
+}
+
+
+/**
+ * Initialize the state vector and its covariance matrix.
+ */
+template <typename Type>
+void UKF<Type>::init( const Vector<Type> &x0, const Matrix<Type> &P0 )
+{
+    int n = x0.size();
+    assert( P0.rows() == n && P0.cols() == n );
+
+    x = x0;
+    P = P0;
+
+    // weights of the 2n+1 sigma points
+    Type lambda = alpha*alpha*(n+kappa) - n;
+    wm.resize( 2*n+1 );
+    wc.resize( 2*n+1 );
+    wm[0] = lambda / (n+lambda);
+    wc[0] = wm[0] + 1 - alpha*alpha + beta;
+    for( int i=1; i<=2*n; ++i )
+    {
+        wm[i] = 1 / ( 2*(n+lambda) );
+        wc[i] = wm[i];
+    }
+}
+
+
+/**
+ * Generate the sigma points from the current state and covariance. Return
+ * false if the covariance is not nonnegative definite.
+ */
+template <typename Type>
+bool UKF<Type>::sigmaPoints()
+{
+    int n = x.size();
+    Type c = sqrt( alpha*alpha*(n+kappa) );
+
+    if( work.size() < n*n )
+        work.resize( n*n );
+    Type *S = &work[0];
+    if( !lowerCholesky( n, (const Type*)P, S ) )
+        return false;
+
+    X.resize( 2*n+1, n );
+    for( int j=0; j<n; ++j )
+        X[0][j] = x[j];
+    for( int i=0; i<n; ++i )
+        for( int j=0; j<n; ++j )
+        {
+            X[1+i][j]   = x[j] + c*S[j*n+i];
+            X[1+n+i][j] = x[j] - c*S[j*n+i];
+        }
+
+    return true;
+}
+
+
+/**
+ * Prediction by the system function "f" and the process noise covariance
+ * "Q". Return false if the covariance is not nonnegative definite.
+ */
+template <typename Type>
+template <typename Func>
+bool UKF<Type>::predict( Func &f, const Matrix<Type> &Q )
+{
+    int n = x.size(),
+        np = 2*n+1;
+
+    if( !sigmaPoints() )
+        return false;
+
+    Y.resize( np, n );
+    #pragma omp parallel for
+    for( int i=0; i<np; ++i )
+        f( X[i], Y[i] );
+
+    pointsMean( np, n, (const Type*)Y, &wm[0], &x[0] );
+    for( int i=0; i<np; ++i )
+        for( int j=0; j<n; ++j )
+            Y[i][j] -= x[j];
+
+    pointsCov( np, n, n, (const Type*)Y, (const Type*)Y, &wc[0], (Type*)P );
+    P += Q;
+
+    return true;
+}
+
+
+/**
+ * Correction by the measurement function "h", the measurement noise
+ * covariance "R" and the measurement "y". Return false if the covariance
+ * matrices are not positive definite.
+ */
+template <typename Type>
+template <typename Func>
+bool UKF<Type>::correct( Func &h, const Matrix<Type> &R,
+                         const Vector<Type> &y )
+{
+    int n = x.size(),
+        m = y.size(),
+        np = 2*n+1;
+    assert( R.rows() == m && R.cols() == m );
+
+    if( !sigmaPoints() )
+        return false;
+
+    Y.resize( np, m );
+    #pragma omp parallel for
+    for( int i=0; i<np; ++i )
+        h( X[i], Y[i] );
+
+    if( work.size() < m+2*m*m+2*n*m )
+        work.resize( m+2*m*m+2*n*m );
+    Type *zm  = &work[0],
+         *Pzz = zm + m,
+         *L   = Pzz + m*m,
+         *Pxz = L + m*m,
+         *K   = Pxz + n*m;
+
+    // deviations of the predicted measurements and the sigma points
+    pointsMean( np, m, (const Type*)Y, &wm[0], zm );
+    for( int i=0; i<np; ++i )
+    {
+        for( int l=0; l<m; ++l )
+            Y[i][l] -= zm[l];
+        for( int j=0; j<n; ++j )
+            X[i][j] -= x[j];
+    }
+
+    pointsCov( np, m, m, (const Type*)Y, (const Type*)Y, &wc[0], Pzz );
+    for( int l=0; l<m; ++l )
+        for( int r=0; r<m; ++r )
+            Pzz[l*m+r] += R[l][r];
+    pointsCov( np, n, m, (const Type*)X, (const Type*)Y, &wc[0], Pxz );
+
+    if( !gainSolve( n, m, Pxz, Pzz, K, L ) )
+        return false;
+
+    // x = x + K*(y-zm),  P = P - K*Pzz*K' = P - Pxz*K'
+    for( int i=0; i<n; ++i )
+    {
+        Type sum = 0;
+        for( int l=0; l<m; ++l )
+            sum += K[i*m+l] * ( y[l]-zm[l] );
+        x[i] += sum;
+    }
+    for( int i=0; i<n; ++i )
+        for( int j=i; j<n; ++j )
+        {
+            Type sum = 0;
+            for( int l=0; l<m; ++l )
+                sum += Pxz[i*m+l] * K[j*m+l];
+            P[i][j] -= sum;
+            P[j][i] = P[i][j];
+        }
+
+    return true;
+}
+
+
+/**
+ * Get the state vector and its covariance matrix.
+ */
+template <typename Type>
+inline Vector<Type> UKF<Type>::getState() const
+{
+    return x;
+}
+
+template <typename Type>
+inline Matrix<Type> UKF<Type>::getCovariance() const
+{
+    return P;
+}
+
+
+/**
+ * constructors and destructor of EnKF
+ */
+template <typename Type>
+EnKF<Type>::EnKF( int members, long int seed )
+           : Ne(members), rg(seed)
+{
+    assert( Ne > 1 );
+}
+
+template <typename Type>
+EnKF<Type>::~EnKF()
+{
+}
+
+
+/**
+ * Standard normal random number by Box-Muller transform.
+ */
+template <typename Type>
+inline Type EnKF<Type>::gauss()
+{
+    Type u1 = rg.random() / Type(rg.getM()),
+         u2 = rg.random() / Type(rg.getM());
+
+    return sqrt(-2*log(u1)) * cos( Type(TWOPI)*u2 );
+}
+
+
+/**
+ * Fill the rows of "A" (Ne-by-n) with N(0,L*L') distributed vectors. The
+ * standard normal numbers are drawn sequentially, then multiplied by the
+ * lower triangular L in parallel.
+ */
+template <typename Type>
+void EnKF<Type>::perturb( int n, const Type *L, Matrix<Type> &A )
+{
+    A.resize( Ne, n );
+    for( int i=0; i<Ne; ++i )
+        for( int j=0; j<n; ++j )
+            A[i][j] = gauss();
+
+    #pragma omp parallel for
+    for( int i=0; i<Ne; ++i )
+    {
+        Type *a = A[i];
+        for( int j=n-1; j>=0; --j )
+        {
+            Type sum = 0;
+            for( int k=0; k<=j; ++k )
+                sum += L[j*n+k] * a[k];
+            a[j] = sum;
+        }
+    }
+}
+
+
+/**
+ * Initialize the ensemble by random members of N(x0,P0).
+ */
+template <typename Type>
+void EnKF<Type>::init( const Vector<Type> &x0, const Matrix<Type> &P0 )
+{
+    int n = x0.size();
+    assert( P0.rows() == n && P0.cols() == n );
+
+    if( work.size() < n*n )
+        work.resize( n*n );
+    if( !lowerCholesky( n, (const Type*)P0, &work[0] ) )
+        cerr << "The initial covariance matrix is not nonnegative definite!"
+             << endl;
+
+    perturb( n, &work[0], X );
+    for( int i=0; i<Ne; ++i )
+        for( int j=0; j<n; ++j )
+            X[i][j] += x0[j];
+}
+
+
+/**
+ * Prediction by the system function "f" and the process noise covariance
+ * "Q". Return false if Q is not nonnegative definite.
+ */
+template <typename Type>
+template <typename Func>
+bool EnKF<Type>::predict( Func &f, const Matrix<Type> &Q )
+{
+    int n = X.cols();
+    assert( Q.rows() == n && Q.cols() == n );
+
+    if( work.size() < n*n )
+        work.resize( n*n );
+    if( !lowerCholesky( n, (const Type*)Q, &work[0] ) )
+        return false;
+
+    Y.resize( Ne, n );
+    #pragma omp parallel for
+    for( int i=0; i<Ne; ++i )
+        f( X[i], Y[i] );
+
+    // add the process noise
+    perturb( n, &work[0], X );
+    X += Y;
+
+    return true;
+}
+
+
+/**
+ * Correction by the measurement function "h", the measurement noise
+ * covariance "R" and the measurement "y", each member is corrected by a
+ * perturbed measurement. Return false if the covariance matrices are not
+ * positive definite.
+ */
+template <typename Type>
+template <typename Func>
+bool EnKF<Type>::correct( Func &h, const Matrix<Type> &R,
+                          const Vector<Type> &y )
+{
+    int n = X.cols(),
+        m = y.size();
+    assert( R.rows() == m && R.cols() == m );
+
+    Z.resize( Ne, m );
+    #pragma omp parallel for
+    for( int i=0; i<Ne; ++i )
+        h( X[i], Z[i] );
+
+    if( work.size() < n+m+3*m*m+2*n*m )
+        work.resize( n+m+3*m*m+2*n*m );
+    Type *xm  = &work[0],
+         *zm  = xm + n,
+         *Pzz = zm + m,
+         *L   = Pzz + m*m,
+         *Lr  = L + m*m,
+         *Pxz = Lr + m*m,
+         *K   = Pxz + n*m;
+
+    if( !lowerCholesky( m, (const Type*)R, Lr ) )
+        return false;
+
+    // anomalies of the members and the predicted measurements
+    pointsMean( Ne, n, (const Type*)X, (const Type*)0, xm );
+    pointsMean( Ne, m, (const Type*)Z, (const Type*)0, zm );
+    Y.resize( Ne, n );
+    for( int i=0; i<Ne; ++i )
+    {
+        for( int j=0; j<n; ++j )
+            Y[i][j] = X[i][j] - xm[j];
+        for( int l=0; l<m; ++l )
+            Z[i][l] -= zm[l];
+    }
+
+    pointsCov( Ne, m, m, (const Type*)Z, (const Type*)Z, (const Type*)0, Pzz );
+    for( int l=0; l<m; ++l )
+        for( int r=0; r<m; ++r )
+            Pzz[l*m+r] += R[l][r];
+    pointsCov( Ne, n, m, (const Type*)Y, (const Type*)Z, (const Type*)0, Pxz );
+
+    if( !gainSolve( n, m, Pxz, Pzz, K, L ) )
+        return false;
+
+    // x_i = x_i + K*( y + e_i - h(x_i) )
+    perturb( m, Lr, E );
+
+    #pragma omp parallel for
+    for( int i=0; i<Ne; ++i )
+    {
+        Type *xi = X[i],
+             *di = E[i];
+        const Type *zi = Z[i];
+        for( int l=0; l<m; ++l )
+            di[l] += y[l] - zm[l] - zi[l];
+        for( int j=0; j<n; ++j )
+        {
+            Type sum = 0;
+            for( int l=0; l<m; ++l )
+                sum += K[j*m+l] * di[l];
+            xi[j] += sum;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Get the ensemble size and the ensemble members (rows).
+ */
+template <typename Type>
+inline int EnKF<Type>::members() const
+{
+    return Ne;
+}
+
+template <typename Type>
+inline Matrix<Type> EnKF<Type>::getEnsemble() const
+{
+    return X;
+}
+
+
+/**
+ * Get the ensemble mean and covariance.
+ */
+template <typename Type>
+Vector<Type> EnKF<Type>::getState() const
+{
+    int n = X.cols();
+    Vector<Type> xm(n);
+    pointsMean( Ne, n, (const Type*)X, (const Type*)0, &xm[0] );
+
+    return xm;
+}
+
+template <typename Type>
+Matrix<Type> EnKF<Type>::getCovariance() const
+{
+    int n = X.cols();
+    Vector<Type> xm = getState();
+    Matrix<Type> A(Ne,n), P(n,n);
+    for( int i=0; i<Ne; ++i )
+        for( int j=0; j<n; ++j )
+            A[i][j] = X[i][j] - xm[j];
+    pointsCov( Ne, n, n, (const Type*)A, (const Type*)A, (const Type*)0,
+               (Type*)P );
+
+    return P;
+}
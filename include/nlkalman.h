@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 nlkalman.h
+ *
+ * Unscented Kalman Filter and Ensemble Kalman Filter.
+ *
+ * For nonlinear systems
+ *      x(k) = f( x(k-1) ) + w,     y(k) = h( x(k) ) + v
+ * the Kalman filter can be generalized by propagating a set of points
+ * through the nonlinear functions, and estimating the means and covariances
+ * from the propagated points:
+ *
+ * The unscented Kalman filter (UKF) uses 2n+1 deterministic sigma points,
+ * x and x +/- sqrt(n+lambda)*S(:,j), where S is the Cholesky factor of the
+ * covariance, and lambda = alpha^2*(n+kappa)-n.
+ *
+ * The ensemble Kalman filter (EnKF) represents the distribution by an
+ * ensemble of random members, and corrects each member with perturbed
+ * measurements, so neither the covariance matrix nor its factor is needed
+ * in the prediction step.
+ *
+ * The functions f and h are given as function objects with a member
+ *      void operator()( const Type *x, Type *fx )
+ * which are called for different points concurrently if OpenMP is enabled,
+ * so they must be thread-safe. The points are stored as the rows of a
+ * matrix, thus the mean and covariance reductions run over contiguous
+ * memory. The random numbers of EnKF are drawn sequentially from the
+ * object's own generator, so the results don't depend on the number of
+ * threads.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef NLKALMAN_H
+#define NLKALMAN_H
+
+
+#include <vector.h>
+#include <matrix.h>
+#include <random.h>
+#include <srkalman.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class UKF
+    {
+
+    public:
+
+        UKF( const Type &alpha=Type(1), const Type &beta=Type(2),
+             const Type &kappa=Type(0) );
+        ~UKF();
+
+        void init( const Vector<Type> &x0, const Matrix<Type> &P0 );
+
+        template <typename Func>
+        bool predict( Func &f, const Matrix<Type> &Q );
+        template <typename Func>
+        bool correct( Func &h, const Matrix<Type> &R, const Vector<Type> &y );
+
+        Vector<Type> getState() const;
+        Matrix<Type> getCovariance() const;
+
+    private:
+
+        // parameters of the sigma points
+        Type alpha,
+             beta,
+             kappa;
+
+        // state vector and its covariance matrix
+        Vector<Type> x;
+        Matrix<Type> P;
+
+        // sigma points, propagated points and their weights
+        Matrix<Type> X;
+        Matrix<Type> Y;
+        Vector<Type> wm;
+        Vector<Type> wc;
+
+        // work space
+        Vector<Type> work;
+
+        bool sigmaPoints();
+
+    };
+    // class UKF
+
+
+    template <typename Type>
+    class EnKF
+    {
+
+    public:
+
+        EnKF( int members, long int seed=1 );
+        ~EnKF();
+
+        void init( const Vector<Type> &x0, const Matrix<Type> &P0 );
+
+        template <typename Func>
+        bool predict( Func &f, const Matrix<Type> &Q );
+        template <typename Func>
+        bool correct( Func &h, const Matrix<Type> &R, const Vector<Type> &y );
+
+        int members() const;
+        Matrix<Type> getEnsemble() const;
+        Vector<Type> getState() const;
+        Matrix<Type> getCovariance() const;
+
+    private:
+
+        // ensemble size
+        int Ne;
+
+        // ensemble members (rows), propagated members or anomalies,
+        // predicted measurements and measurement perturbations
+        Matrix<Type> X;
+        Matrix<Type> Y;
+        Matrix<Type> Z;
+        Matrix<Type> E;
+
+        // random numbers generator
+        Random rg;
+
+        // work space
+        Vector<Type> work;
+
+        Type gauss();
+        void perturb( int n, const Type *L, Matrix<Type> &A );
+
+    };
+    // class EnKF
+
+
+    template<typename Type>
+    static void pointsMean( int, int, const Type*, const Type*, Type* );
+    template<typename Type>
+    static void pointsCov( int, int, int, const Type*, const Type*,
+                           const Type*, Type* );
+    template<typename Type>
+    static bool gainSolve( int, int, const Type*, Type*, Type*, Type* );
+
+
+    #include <nlkalman-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// NLKALMAN_H
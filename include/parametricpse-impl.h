@@ -46,11 +46,8 @@ Vector<Type> yulewalkerPSE( const Vector<Type> &xn, int p, Type &sigma2 )
 
     assert( p <= N );
 
-    Vector<Type> rn(p+1);
-    for( int i=0; i<=p; ++i )
-        for( int k=0; k<N-i; ++k )
-            rn[i] += xn[k+i]*xn[k];
-    rn /= Type(N);
+    // only the first p+1 lags of the biased auto-correlation
+    Vector<Type> rn = corrLags( xn, p, "biased" );
 
     return levinson( rn, sigma2 );
 }
@@ -62,45 +59,57 @@ Vector<Type> yulewalkerPSE( const Vector<Type> &xn, int p, Type &sigma2 )
  * p        : the AR model order
  * sigma2   : the variance of exciting white noise
  * return   : coefficients of AR model --- a(0), a(1), ..., a(p)
+ *
+ * The forward and backward prediction errors are updated in place, and the
+ * denominator of the reflection coefficient is updated recursively, so only
+ * one inner product is needed for each order.
  */
 template <typename Type>
 Vector<Type> burgPSE( const Vector<Type> &xn, int p, Type &sigma2 )
 {
     int N = xn.size();
-    Type numerator, denominator;
-    Vector<Type> ak(p+1), akPrev(p+1), ef(N), eb(N);
 
-    ak[0] = Type(1.0);
-    sigma2 = sum(xn*xn) / Type(N);
+    assert( p < N );
 
-    for( int i=1; i<N; ++i )
-    {
-        ef[i] = xn[i];
-        eb[i-1] = xn[i-1];
-    }
+    Type numerator, denominator, kk, tmp;
+    Vector<Type> ak(p+1), ef(xn), eb(xn);
+
+    ak[0] = Type(1.0);
+    sigma2 = 0;
+    for( int i=0; i<N; ++i )
+        sigma2 += xn[i]*xn[i];
+    denominator = 2*sigma2 - xn[0]*xn[0] - xn[N-1]*xn[N-1];
+    sigma2 /= Type(N);
 
     for( int k=1; k<=p; ++k )
     {
         numerator = 0;
-        denominator = 0;
         for( int i=k; i<N; ++i )
-        {
             numerator += ef[i]*eb[i-1];
-            denominator += ef[i]*ef[i] + eb[i-1]*eb[i-1];
+        kk = -2*numerator/denominator;
+
+        // Levinson recursion in place
+        for( int i=1; i<=k/2; ++i )
+        {
+            tmp = ak[i];
+            ak[i] += kk*ak[k-i];
+            if( i != k-i )
+                ak[k-i] += kk*tmp;
         }
-        ak[k] = -2*numerator/denominator;
+        ak[k] = kk;
 
-        for( int i=1; i<k; ++i )
-            akPrev[i] = ak[i] + ak[k]*ak[k-i];
-        for( int i=1; i<k; ++i )
-            ak[i] = akPrev[i];
+        sigma2 *= 1 - kk*kk;
 
-        sigma2 *= 1 - ak[k]*ak[k];
+        // denominator for the next order
+        tmp = ef[k] + kk*eb[k-1];
+        denominator = (1-kk*kk)*denominator - tmp*tmp;
+        tmp = eb[N-2] + kk*ef[N-1];
+        denominator -= tmp*tmp;
 
         for( int i=N-1; i>k; --i )
         {
-            ef[i] = ef[i] + ak[k]*eb[i-1];
-            eb[i-1] = eb[i-2] + ak[k]*ef[i-1];
+            ef[i] = ef[i] + kk*eb[i-1];
+            eb[i-1] = eb[i-2] + kk*ef[i-1];
         }
     }
 
@@ -115,33 +124,46 @@ Vector<Type> burgPSE( const Vector<Type> &xn, int p, Type &sigma2 )
  * p        : the AR model order
  * sigma2   : the variance of exciting white noise
  * return   : coefficients of AR model --- a(0), a(1), ..., a(p)
+ *
+ * The (p+1)-by-(p+1) modified covariance matrix is the sum of a forward
+ * covariance matrix C and its persymmetric counterpart. The adjacent
+ * elements along the diagonals of C differ only in two products, so the
+ * matrix is obtained in O(N*p+p^2) without forming the 2(N-p)-by-(p+1) data
+ * matrix, and then solved by Cholesky decomposition.
  */
 template <typename Type>
 Vector<Type> fblplsPSE( const Vector<Type> &xn, int p, Type &sigma2 )
 {
     int N = xn.size(),
-        M = 2*(N-p);
+        Nf = N-p,
+        M = 2*Nf;
+
+    assert( p < N );
 
     Vector<Type> u(p+1);
     u[0] = Type(1.0);
 
-    Matrix<Type> X(M,p+1);
-//    for( int i=0; i<=p; ++i )
-//    {
-//        for( int j=0; j<N-p; ++j )
-//            X[j][i] = xn[i+j];
-//        for( int j=p; j<N; ++j )
-//            X[j][i] = xn[j-i];
-//    }
-    for( int i=0; i<N-p; ++i )
-        for( int j=0; j<=p; ++j )
-            X[i][j] = xn[i+j];
-    for( int i=p; i<N; ++i )
-        for( int j=0; j<=p; ++j )
-            X[i][j] = xn[i-j];
-
-    Matrix<Type> Rp = trMult(X,X) / Type(M);
-    Vector<Type> ak = luSolver( Rp, u );
+    // C[i][j] = sum{ x(t+i)*x(t+j) }, t = 0, 1, ..., N-p-1, for i <= j
+    Matrix<Type> C(p+1,p+1);
+    for( int j=0; j<=p; ++j )
+    {
+        Type sum = 0;
+        for( int t=0; t<Nf; ++t )
+            sum += xn[t]*xn[t+j];
+        C[0][j] = sum;
+    }
+    for( int i=1; i<=p; ++i )
+        for( int j=i; j<=p; ++j )
+            C[i][j] = C[i-1][j-1] - xn[i-1]*xn[j-1]
+                      + xn[Nf+i-1]*xn[Nf+j-1];
+
+    // forward part C[i][j] plus backward part C[p-j][p-i]
+    Matrix<Type> Rp(p+1,p+1);
+    for( int i=0; i<=p; ++i )
+        for( int j=i; j<=p; ++j )
+            Rp[i][j] = Rp[j][i] = ( C[i][j] + C[p-j][p-i] ) / Type(M);
+
+    Vector<Type> ak = choleskySolver( Rp, u );
     sigma2 = 1/ak[0];
     ak *= sigma2;
 
@@ -150,13 +172,17 @@ Vector<Type> fblplsPSE( const Vector<Type> &xn, int p, Type &sigma2 )
 
 
 /**
- * The Bartlett method of power spectral estimation.
+ * The power spectral density of ARMA model.
  * ak       : AR coefficients
  * bk       : MA coefficients
  * sigma2   : the variance of exciting white noise
  * L        : the points number of PSD
  * return   : spectral density at L frequencies:
  *            w = 0, 2*pi/L, ..., 2*pi(L-1)/L
+ *
+ * A(w) and B(w) are the DFTs of the (folded) coefficients, so they are
+ * computed by one L points FFT of the complex sequence ak + j*bk, and
+ * separated by the conjugate symmetry of the DFT of real sequences.
  */
 template <typename Type>
 Vector<Type> armaPSD( const Vector<Type> &ak, const Vector<Type> &bk,
@@ -165,51 +191,21 @@ Vector<Type> armaPSD( const Vector<Type> &ak, const Vector<Type> &bk,
     int p = ak.size()-1,
         q = bk.size()-1;
     Vector<Type> Xk(L);
+    Vector< complex<Type> > zn(L);
+
+    for( int i=0; i<=p; ++i )
+        zn[i%L] += ak[i];
+    for( int i=0; i<=q; ++i )
+        zn[i%L] += complex<Type>( 0, bk[i] );
+
+    Vector< complex<Type> > Zk = fft( zn );
+
+    // 2*A(k) = Z(k) + conj(Z(L-k)), 2j*B(k) = Z(k) - conj(Z(L-k))
+    for( int k=0; k<L; ++k )
+    {
+        complex<Type> Zc = conj( Zk[(L-k)%L] );
+        Xk[k] = sigma2 * norm(Zk[k]-Zc) / norm(Zk[k]+Zc);
+    }
 
-    Type zRe, zIm, aRe, aIm, bRe, bIm,
-         Xre, Xim,
-         re, im;
-	Type omega,
-         den, numRe, numIm;
-
-	for( int k=0; k<L; ++k )
-	{
-		omega = Type(TWOPI*k/L);
-		zRe = cos(-omega);
-		zIm = sin(-omega);
-
-        // numerator
-		bRe = 0;
-		bIm = 0;
-		for( int i=q; i>0; --i )
-		{
-			re = bRe;
-			im = bIm;
-			bRe = (re+bk[i])*zRe - im*zIm;
-			bIm = (re+bk[i])*zIm + im*zRe;
-		}
-		bRe += bk[0];
-
-        // denominator
-		aRe = 0;
-		aIm = 0;
-		for( int i=p; i>0; --i )
-		{
-			re = aRe;
-			im = aIm;
-			aRe = (re+ak[i])*zRe - im*zIm;
-			aIm = (re+ak[i])*zIm + im*zRe;
-		}
-		aRe += ak[0];
-
-        // Power Spectrum Density
-		numRe = aRe*bRe + aIm*bIm;
-		numIm = aRe*bIm - aIm*bRe;
-		den = aRe*aRe + aIm*aIm;
-		Xre = numRe/(den);
-		Xim = numIm/(den);
-        Xk[k] = sigma2 * (Xre*Xre + Xim*Xim);
-	}
-
-	return Xk;
+    return Xk;
 }
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              pcgsolver-impl.h
+ *
+ * Implementation for preconditioned conjugate gradient method.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * Solve A*x = b by the preconditioned conjugate gradient method.
+ * A        : symmetric positive definite operator
+ * M        : preconditioner, which approximates A
+ * b        : constant vector
+ * x        : initial guess (zero vector if its size isn't n) as input, and
+ *            the solution as output
+ * tol      : stop when norm(b-A*x) <= tol*norm(b)
+ * maxItr   : the maximum number of iterations, 0 means n
+ * return   : the number of iterations
+ */
+template <typename Type, typename Operator, typename Preconditioner>
+int pcgSolver( Operator &A, Preconditioner &M, const Vector<Type> &b,
+               Vector<Type> &x, Type tol, int maxItr )
+{
+    int n = b.size();
+    if( maxItr <= 0 )
+        maxItr = n;
+
+    Vector<Type> r(n), z(n), p(n), Ap(n);
+
+    if( x.size() != n )
+    {
+        x.resize(n);
+        x = Type(0);
+        r = b;
+    }
+    else
+    {
+        A.multiply( x, Ap );
+        r = b - Ap;
+    }
+
+    Type bNorm = norm(b),
+         rz, rzOld, alpha, beta;
+    if( bNorm == 0 )
+        bNorm = 1;
+
+    M.solve( r, z );
+    p = z;
+    rz = dotProd( r, z );
+
+    int itr = 0;
+    while( itr < maxItr && norm(r) > tol*bNorm )
+    {
+        A.multiply( p, Ap );
+        alpha = rz / dotProd( p, Ap );
+
+        for( int i=0; i<n; ++i )
+        {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+        }
+
+        M.solve( r, z );
+        rzOld = rz;
+        rz = dotProd( r, z );
+        beta = rz / rzOld;
+
+        for( int i=0; i<n; ++i )
+            p[i] = z[i] + beta*p[i];
+
+        itr++;
+    }
+
+    return itr;
+}
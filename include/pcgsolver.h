@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 pcgsolver.h
+ *
+ * Preconditioned conjugate gradient method for linear equations.
+ *
+ * For a symmetric positive definite n-by-n operator A, the preconditioned
+ * conjugate gradient method solves A*x = b iteratively, each iteration
+ * needs one product A*p and one preconditioner solve M*z = r. The matrix
+ * is never formed, so any structured operator with a fast product can be
+ * used, such as "ToeplitzOperator". The operator and preconditioner types
+ * only need the members
+ *      void multiply( const Vector<Type> &x, Vector<Type> &y );  // y = A*x
+ *      void solve( const Vector<Type> &r, Vector<Type> &z );     // M*z = r
+ * respectively. "IdentityPreconditioner" gives the plain conjugate gradient
+ * method.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef PCGSOLVER_H
+#define PCGSOLVER_H
+
+
+#include <vector.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class IdentityPreconditioner
+    {
+
+    public:
+
+        void solve( const Vector<Type> &r, Vector<Type> &z )
+        {
+            z = r;
+        }
+
+    };
+    // class IdentityPreconditioner
+
+
+    template<typename Type, typename Operator, typename Preconditioner>
+    int pcgSolver( Operator&, Preconditioner&, const Vector<Type>&,
+                   Vector<Type>&, Type tol=Type(1.0e-10), int maxItr=0 );
+
+
+    #include <pcgsolver-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// PCGSOLVER_H
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              pcholesky-impl.h
+ *
+ * Implementation for PackedCholesky class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructor and destructor
+ */
+template<typename Type>
+PackedCholesky<Type>::PackedCholesky() : spd(true), n(0), nt(0)
+{
+}
+
+template<typename Type>
+PackedCholesky<Type>::~PackedCholesky()
+{
+}
+
+
+/**
+ * return true, if original matrix is symmetric positive-definite.
+ */
+template<typename Type>
+inline bool PackedCholesky<Type>::isSpd() const
+{
+    return spd;
+}
+
+
+/**
+ * the dimension of the matrix
+ */
+template<typename Type>
+inline int PackedCholesky<Type>::dim() const
+{
+    return n;
+}
+
+
+/**
+ * Factorize a full matrix, only the lower triangle is read.
+ */
+template <typename Type>
+void PackedCholesky<Type>::dec( const Matrix<Type> &A )
+{
+    spd = ( A.rows() == A.cols() );
+    if( !spd )
+        return;
+
+    allocate( A.rows() );
+    for( int I=0; I<nt; ++I )
+        for( int J=0; J<=I; ++J )
+        {
+            Type *t = tile(I,J);
+            int ld = size(J);
+            for( int i=0; i<size(I); ++i )
+            {
+                const Type *a = A[I*TS+i] + J*TS;
+                int nj = (I == J) ? i+1 : ld;
+                for( int j=0; j<nj; ++j )
+                    t[i*ld+j] = a[j];
+                for( int j=nj; j<ld; ++j )
+                    t[i*ld+j] = 0;
+            }
+        }
+
+    factorize();
+}
+
+
+/**
+ * Factorize a matrix of dimension "N" given by its lower triangle packed
+ * by rows.
+ */
+template <typename Type>
+void PackedCholesky<Type>::dec( int N, const Vector<Type> &ap )
+{
+    assert( ap.size() == N*(N+1)/2 );
+
+    spd = true;
+    allocate( N );
+    for( int r=0; r<n; ++r )
+    {
+        const Type *a = &ap[r*(r+1)/2];
+        int I = r / TS,
+            i = r % TS;
+        for( int J=0; J<=I; ++J )
+        {
+            Type *t = tile(I,J) + i*size(J);
+            int nj = (I == J) ? i+1 : size(J);
+            for( int j=0; j<nj; ++j )
+                t[j] = a[J*TS+j];
+            for( int j=nj; j<size(J); ++j )
+                t[j] = 0;
+        }
+    }
+
+    factorize();
+}
+
+
+/**
+ * return the lower triangular factor, L, such that L*L'=A.
+ */
+template <typename Type>
+Matrix<Type> PackedCholesky<Type>::getL() const
+{
+    Matrix<Type> L( n, n );
+
+    for( int I=0; I<nt; ++I )
+        for( int J=0; J<=I; ++J )
+        {
+            const Type *t = tile(I,J);
+            int ld = size(J);
+            for( int i=0; i<size(I); ++i )
+            {
+                int nj = (I == J) ? i+1 : ld;
+                for( int j=0; j<nj; ++j )
+                    L[I*TS+i][J*TS+j] = t[i*ld+j];
+            }
+        }
+
+    return L;
+}
+
+
+/**
+ * return the lower triangular factor packed by rows.
+ */
+template <typename Type>
+Vector<Type> PackedCholesky<Type>::getPacked() const
+{
+    Vector<Type> lp( n*(n+1)/2 );
+
+    for( int r=0; r<n; ++r )
+    {
+        Type *l = &lp[r*(r+1)/2];
+        int I = r / TS,
+            i = r % TS;
+        for( int J=0; J<=I; ++J )
+        {
+            const Type *t = tile(I,J) + i*size(J);
+            int nj = (I == J) ? i+1 : size(J);
+            for( int j=0; j<nj; ++j )
+                l[J*TS+j] = t[j];
+        }
+    }
+
+    return lp;
+}
+
+
+/**
+ * Solve a linear system A*x = b, using the previously computed
+ * cholesky factorization of A: L*L'.
+ */
+template <typename Type>
+Vector<Type> PackedCholesky<Type>::solve( const Vector<Type> &b )
+{
+    if( b.dim() != n )
+        return Vector<Type>();
+
+    Vector<Type> x = b;
+    solveTiles( &x[0], 1 );
+
+    return x;
+}
+
+
+/**
+ * Solve a linear system A*X = B, using the previously computed
+ * cholesky factorization of A: L*L'.
+ */
+template <typename Type>
+Matrix<Type> PackedCholesky<Type>::solve( const Matrix<Type> &B )
+{
+    if( B.rows() != n )
+        return Matrix<Type>();
+
+    Matrix<Type> X = B;
+    solveTiles( &X[0][0], X.cols() );
+
+    return X;
+}
+
+
+/**
+ * Allocate the tiles for a matrix of dimension "N", the tiles of the last
+ * block row and column have only the remaining rows and columns.
+ */
+template <typename Type>
+void PackedCholesky<Type>::allocate( int N )
+{
+    n = N;
+    nt = (n+TS-1) / TS;
+    int r = ( nt > 0 ) ? size(nt-1) : 0;
+    tiles.resize( (nt-1)*nt/2*TS*TS + (nt-1)*r*TS + r*r );
+}
+
+
+/**
+ * The tiled factorization. At step K, the diagonal tile is factorized, the
+ * tiles (I,K) below it are solved, and the trailing tiles (I,J), K < J <= I,
+ * are updated by T(I,J) -= T(I,K)*T(J,K)'. The pack buffers of "gemmTile"
+ * have KC columns (its panel width).
+ */
+template <typename Type>
+void PackedCholesky<Type>::factorize()
+{
+    for( int K=0; K<nt; ++K )
+    {
+        int kb = size(K);
+        const Type *tkk = tile(K,K);
+
+        if( !choleskyBlock( tile(K,K), kb, kb ) )
+        {
+            spd = false;
+            return;
+        }
+
+        int r = nt-K-1;
+
+        #pragma omp parallel
+        {
+            Vector<Type> packA( TS*KC ),
+                         packB( KC*TS );
+
+            #pragma omp for
+            for( int I=K+1; I<nt; ++I )
+                trsmSmall( 'R', 'L', 'C', 'N', size(I), kb, tkk, kb,
+                           tile(I,K), kb );
+
+            #pragma omp for
+            for( int t=0; t<r*(r+1)/2; ++t )
+            {
+                int p = int( (sqrt(8.0*t+1)-1) / 2 );
+                while( p*(p+1)/2 > t )
+                    --p;
+                while( (p+1)*(p+2)/2 <= t )
+                    ++p;
+                int I = K+1 + p,
+                    J = K+1 + t - p*(p+1)/2;
+
+                gemmTile( 'N', 'C', size(I), size(J), kb, Type(-1),
+                          tile(I,K), kb, tile(J,K), kb, Type(1),
+                          tile(I,J), size(J), &packA[0], &packB[0] );
+            }
+        }
+    }
+}
+
+
+/**
+ * Solve L*L'*X = B in place for "nx" right hand sides, the columns are
+ * split into chunks for the threads, and each chunk is solved by block
+ * rows of TS.
+ */
+template <typename Type>
+void PackedCholesky<Type>::solveTiles( Type *X, int nx )
+{
+    const int NS = 256;
+    int nChunks = (nx+NS-1) / NS;
+
+    #pragma omp parallel
+    {
+        Vector<Type> packA( TS*KC ),
+                     packB( KC*NS );
+
+        #pragma omp for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int j0 = c*NS,
+                nb = min( NS, nx-j0 );
+
+            // solve L*Y = B
+            for( int I=0; I<nt; ++I )
+            {
+                Type *XI = X + I*TS*nx + j0;
+                for( int J=0; J<I; ++J )
+                    gemmTile( 'N', 'N', size(I), nb, size(J), Type(-1),
+                              tile(I,J), size(J), X+J*TS*nx+j0, nx, Type(1),
+                              XI, nx, &packA[0], &packB[0] );
+                trsmSmall( 'L', 'L', 'N', 'N', size(I), nb, tile(I,I),
+                           size(I), XI, nx );
+            }
+
+            // solve L'*X = Y
+            for( int I=nt-1; I>=0; --I )
+            {
+                Type *XI = X + I*TS*nx + j0;
+                for( int J=I+1; J<nt; ++J )
+                    gemmTile( 'C', 'N', size(I), nb, size(J), Type(-1),
+                              tile(J,I), size(I), X+J*TS*nx+j0, nx, Type(1),
+                              XI, nx, &packA[0], &packB[0] );
+                trsmSmall( 'L', 'L', 'C', 'N', size(I), nb, tile(I,I),
+                           size(I), XI, nx );
+            }
+        }
+    }
+}
+
+
+/**
+ * the tile (I,J), J <= I, of size(I) rows and size(J) columns, the block
+ * rows before I are full
+ */
+template <typename Type>
+inline Type* PackedCholesky<Type>::tile( int I, int J )
+{
+    return &tiles[I*(I+1)/2*TS*TS + J*size(I)*TS];
+}
+
+template <typename Type>
+inline const Type* PackedCholesky<Type>::tile( int I, int J ) const
+{
+    return &tiles[I*(I+1)/2*TS*TS + J*size(I)*TS];
+}
+
+
+/**
+ * the number of rows of the tiles in block row I
+ */
+template <typename Type>
+inline int PackedCholesky<Type>::size( int I ) const
+{
+    return ( n-I*TS < TS ) ? n-I*TS : TS;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 pcholesky.h
+ *
+ * Class template of Cholesky decomposition in packed storage.
+ *
+ * For a real symmetric positive definite matrix A, this class computes the
+ * lower triangular matrix L such that A = L*L', as "Cholesky" does, but only
+ * the lower triangle is stored, in tiles of TS by TS elements: tile (I,J),
+ * J <= I, is contiguous and stored by rows, the tiles of the last block row
+ * and column have only the remaining rows and columns. The storage is
+ * n*(n+TS)/2 elements at most, so it is never more than a full matrix and
+ * about half of it for n >> TS. The input can be given as a full matrix
+ * (only the lower triangle is read) or as the lower triangle packed by
+ * rows, i.e. A(i,j), j <= i, at i*(i+1)/2 + j.
+ *
+ * The factorization is a tiled right-looking algorithm: the diagonal tile
+ * is factorized, the tiles below it are solved by "trsm", and the trailing
+ * tiles are updated by the "gemm" kernel. The tiles of each step are shared
+ * by the threads if OpenMP is enabled. The solvers work on block rows of
+ * the right hand sides in the same way.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef PCHOLESKY_H
+#define PCHOLESKY_H
+
+
+#include <cholesky.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class PackedCholesky
+    {
+
+    public:
+
+        PackedCholesky();
+        ~PackedCholesky();
+
+        bool isSpd() const;
+        int dim() const;
+        void dec( const Matrix<Type> &A );
+        void dec( int N, const Vector<Type> &ap );
+        Matrix<Type> getL() const;
+        Vector<Type> getPacked() const;
+
+        Vector<Type> solve( const Vector<Type> &b );
+        Matrix<Type> solve( const Matrix<Type> &B );
+
+    private:
+
+        static const int TS = 128;
+        static const int KC = 256;
+
+        bool spd;
+        int n,
+            nt;
+
+        Vector<Type> tiles;
+
+        void allocate( int N );
+        void factorize();
+        void solveTiles( Type *X, int nx );
+
+        Type* tile( int I, int J );
+        const Type* tile( int I, int J ) const;
+        int size( int I ) const;
+
+    };
+    //	class PackedCholesky
+
+
+    #include <pcholesky-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// PCHOLESKY_H
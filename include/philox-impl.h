@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                philox-impl.h
+ *
+ * Implementation for Philox class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * s        : seed (the key)
+ * stream   : stream number (the high 64 bits of the counter)
+ */
+inline Philox::Philox( uint64 s, uint64 stream )
+{
+    seed( s, stream );
+}
+
+inline Philox::~Philox()
+{
+}
+
+
+/**
+ * Set the seed and stream, and go to the beginning of the stream.
+ */
+inline void Philox::seed( uint64 s, uint64 stream )
+{
+    key = s;
+    strm = stream;
+    pos = 0;
+    bufCtr = 0;
+    bufValid = false;
+}
+
+
+/**
+ * Skip the next "n" 64 bits outputs.
+ */
+inline void Philox::jump( uint64 n )
+{
+    pos += n;
+}
+
+
+/**
+ * Return a generator of the same seed at the beginning of another stream.
+ */
+inline Philox Philox::split( uint64 stream ) const
+{
+    return Philox( key, stream );
+}
+
+
+/**
+ * Get the seed, stream and the position of the next output.
+ */
+inline Philox::uint64 Philox::getSeed() const
+{
+    return key;
+}
+
+inline Philox::uint64 Philox::getStream() const
+{
+    return strm;
+}
+
+inline Philox::uint64 Philox::getPosition() const
+{
+    return pos;
+}
+
+
+/**
+ * Compute the "n" (n <= GROUP) counters first, first+1, ..., and write the
+ * two 64 bits outputs of each counter to "out". The counters are kept in
+ * interleaved arrays, so each round is a loop over the counters.
+ */
+inline void Philox::blocks( uint64 k, uint64 stream, uint64 first, int n,
+                            uint64 *out )
+{
+    const uint32 M0 = 0xD2511F53U,
+                 M1 = 0xCD9E8D57U,
+                 W0 = 0x9E3779B9U,
+                 W1 = 0xBB67AE85U;
+
+    uint32 c0[GROUP], c1[GROUP], c2[GROUP], c3[GROUP];
+    for( int l=0; l<GROUP; ++l )
+    {
+        uint64 ctr = first + l;
+        c0[l] = uint32( ctr );
+        c1[l] = uint32( ctr >> 32 );
+        c2[l] = uint32( stream );
+        c3[l] = uint32( stream >> 32 );
+    }
+
+    uint32 k0 = uint32( k ),
+           k1 = uint32( k >> 32 );
+    for( int r=0; r<10; ++r )
+    {
+        for( int l=0; l<GROUP; ++l )
+        {
+            uint64 p0 = uint64(M0) * c0[l],
+                   p1 = uint64(M1) * c2[l];
+            uint32 n0 = uint32( p1 >> 32 ) ^ c1[l] ^ k0,
+                   n2 = uint32( p0 >> 32 ) ^ c3[l] ^ k1;
+            c0[l] = n0;
+            c1[l] = uint32( p1 );
+            c2[l] = n2;
+            c3[l] = uint32( p0 );
+        }
+        k0 += W0;
+        k1 += W1;
+    }
+
+    for( int l=0; l<n; ++l )
+    {
+        out[2*l]   = c0[l] | ( uint64(c1[l]) << 32 );
+        out[2*l+1] = c2[l] | ( uint64(c3[l]) << 32 );
+    }
+}
+
+
+/**
+ * Compute the "n" outputs from the position "first" of a stream.
+ */
+inline void Philox::generate( uint64 k, uint64 stream, uint64 first,
+                              int n, uint64 *out )
+{
+    uint64 tmp[2*GROUP];
+    uint64 ctr = first / 2;
+    int skip = int( first % 2 ),
+        i = 0;
+
+    while( i < n )
+    {
+        int nb = (skip+n-i+1) / 2;
+        if( nb > GROUP )
+            nb = GROUP;
+        blocks( k, stream, ctr, nb, tmp );
+        for( int j=skip; j<2*nb && i<n; ++j )
+            out[i++] = tmp[j];
+
+        skip = 0;
+        ctr += nb;
+    }
+}
+
+
+/**
+ * Map 64 bits to an uniform number in (0,1) with 53 bits resolution.
+ */
+inline double Philox::toUniform( uint64 x )
+{
+    return ( (x>>11) + 0.5 ) * ( 1.0/9007199254740992.0 );
+}
+
+
+/**
+ * Return the next 64 bits output.
+ */
+inline Philox::uint64 Philox::random()
+{
+    uint64 ctr = pos / 2;
+    if( !bufValid || ctr != bufCtr )
+    {
+        blocks( key, strm, ctr, 1, buf );
+        bufCtr = ctr;
+        bufValid = true;
+    }
+
+    return buf[(pos++)%2];
+}
+
+
+/**
+ * Return an Uniform(0,1) distributed number.
+ */
+inline double Philox::uniform()
+{
+    return toUniform( random() );
+}
+
+
+/**
+ * Return a Normal(0,1) distributed number, two outputs are used.
+ */
+inline double Philox::normal()
+{
+    double u1 = uniform(),
+           u2 = uniform();
+
+    return std::sqrt(-2*std::log(u1)) * std::cos(TWOPI*u2);
+}
+
+
+/**
+ * Fill "N" 64 bits outputs.
+ */
+inline void Philox::random( uint64 *xn, int N )
+{
+    int nChunks = (N+CHUNK-1) / CHUNK;
+
+    #pragma omp parallel for
+    for( int c=0; c<nChunks; ++c )
+    {
+        int i0 = c*CHUNK,
+            m = ( N-i0 < CHUNK ) ? N-i0 : CHUNK;
+        generate( key, strm, pos+i0, m, xn+i0 );
+    }
+
+    pos += N;
+}
+
+
+/**
+ * Fill a vector by Uniform(low,high) distributed numbers.
+ */
+template <typename Type>
+void Philox::uniform( Vector<Type> &xn, const Type &low, const Type &high )
+{
+    int N = xn.size(),
+        nChunks = (N+CHUNK-1) / CHUNK;
+
+    #pragma omp parallel
+    {
+        Vector<uint64> tmp(CHUNK);
+
+        #pragma omp for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int i0 = c*CHUNK,
+                m = ( N-i0 < CHUNK ) ? N-i0 : CHUNK;
+            generate( key, strm, pos+i0, m, &tmp[0] );
+            for( int i=0; i<m; ++i )
+                xn[i0+i] = low + Type( toUniform(tmp[i]) * (high-low) );
+        }
+    }
+
+    pos += N;
+}
+
+
+/**
+ * Fill a vector by Normal(mu,sigma) distributed numbers, two outputs are
+ * used for a pair of numbers.
+ */
+template <typename Type>
+void Philox::normal( Vector<Type> &xn, const Type &mu, const Type &sigma )
+{
+    int N = xn.size(),
+        M = N + N%2,
+        nChunks = (M+CHUNK-1) / CHUNK;
+
+    #pragma omp parallel
+    {
+        Vector<uint64> tmp(CHUNK);
+
+        #pragma omp for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int i0 = c*CHUNK,
+                m = ( M-i0 < CHUNK ) ? M-i0 : CHUNK;
+            generate( key, strm, pos+i0, m, &tmp[0] );
+            for( int i=0; i<m; i+=2 )
+            {
+                double r = std::sqrt( -2*std::log(toUniform(tmp[i])) ),
+                       t = TWOPI * toUniform(tmp[i+1]);
+                xn[i0+i] = mu + sigma*Type( r*std::cos(t) );
+                if( i0+i+1 < N )
+                    xn[i0+i+1] = mu + sigma*Type( r*std::sin(t) );
+            }
+        }
+    }
+
+    pos += M;
+}
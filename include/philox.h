@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                   philox.h
+ *
+ * Counter-based random number generator.
+ *
+ * Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+ * 3", 2011) maps a 128 bits counter to 128 random bits by 10 rounds of
+ * multiplications and xors with a 64 bits key. There is no state other than
+ * the counter, so
+ *      the seed is the key, and the high 64 bits of the counter select one
+ *      of 2^64 independent streams, e.g. one for each thread or job;
+ *      the low 64 bits of the counter is the position in the stream, and
+ *      jumping ahead by any distance costs O(1);
+ *      any part of a stream can be computed independently, so the bulk
+ *      fills run in parallel and give the same bits for any number of
+ *      threads.
+ * Each counter gives two 64 bits outputs. The bulk fills compute a group of
+ * counters together in interleaved arrays, so that the rounds can be
+ * vectorized by the compiler, and split long vectors into chunks for
+ * OpenMP threads.
+ *
+ * The uniform numbers are in (0,1) with 53 bits resolution, and the normal
+ * numbers are generated by Box-Muller transformation from pairs of uniform
+ * numbers.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+
+#include <cmath>
+#include <vector.h>
+
+
+namespace splab
+{
+
+    class Philox
+    {
+
+    public:
+
+        typedef unsigned int        uint32;
+        typedef unsigned long long  uint64;
+
+        explicit Philox( uint64 seed=0, uint64 stream=0 );
+        ~Philox();
+
+        void seed( uint64 seed, uint64 stream=0 );
+        void jump( uint64 n );
+        Philox split( uint64 stream ) const;
+
+        uint64 getSeed() const;
+        uint64 getStream() const;
+        uint64 getPosition() const;
+
+        uint64 random();
+        double uniform();
+        double normal();
+
+        void random( uint64 *xn, int N );
+        template<typename Type> void uniform( Vector<Type> &xn,
+                                              const Type &low=Type(0),
+                                              const Type &high=Type(1) );
+        template<typename Type> void normal( Vector<Type> &xn,
+                                             const Type &mu=Type(0),
+                                             const Type &sigma=Type(1) );
+
+    private:
+
+        // the number of counters computed together, and the outputs of one
+        // chunk of the bulk fills
+        static const int GROUP = 8;
+        static const int CHUNK = 4096;
+
+        // key, stream and the position of the next output
+        uint64 key;
+        uint64 strm;
+        uint64 pos;
+
+        // the last computed counter and its two outputs
+        uint64 bufCtr;
+        uint64 buf[2];
+        bool bufValid;
+
+        static void blocks( uint64 key, uint64 stream, uint64 first, int n,
+                            uint64 *out );
+        static void generate( uint64 key, uint64 stream, uint64 first, int n,
+                              uint64 *out );
+        static double toUniform( uint64 x );
+
+    };
+    // class Philox
+
+
+    #include <philox-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// PHILOX_H
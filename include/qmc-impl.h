@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 qmc-impl.h
+ *
+ * Implementation for Sobol and Halton classes.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ */
+inline Sobol::Sobol( int dim )
+: nDim(dim), pos(0), v(dim,BITS), shift(dim), cur(dim)
+{
+    assert( dim > 0 );
+
+    // degree, coefficients and initial numbers of the primitive
+    // polynomials of dimension 2 to 21 (Joe and Kuo, 2008)
+    static const int TABLE = 20;
+    static const int deg[TABLE] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5,
+                                    5, 5, 6, 6, 6, 6, 6, 6, 7, 7 };
+    static const int coef[TABLE] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11,
+                                     13, 14, 1, 13, 16, 19, 22, 25, 1, 4 };
+    static const int init[TABLE][7] = {
+        { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 },
+        { 1, 3, 5, 13 }, { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 },
+        { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 }, { 1, 1, 1, 3, 11 },
+        { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 }, { 1, 1, 1, 15, 21, 21 },
+        { 1, 3, 1, 13, 27, 49 }, { 1, 1, 1, 15, 7, 5 },
+        { 1, 3, 1, 15, 13, 25 }, { 1, 1, 5, 5, 19, 61 },
+        { 1, 3, 7, 11, 23, 15, 103 }, { 1, 3, 7, 13, 13, 15, 69 } };
+
+    for( int k=0; k<BITS; ++k )
+        v[0][k] = uint32(1) << (BITS-1-k);
+
+    int s = 7,
+        a = 4;
+    Philox rng( 0x536f626f6cULL );
+    for( int d=1; d<nDim; ++d )
+    {
+        uint32 *vd = v[d];
+        if( d <= TABLE )
+        {
+            s = deg[d-1];
+            a = coef[d-1];
+            for( int k=0; k<s; ++k )
+                vd[k] = uint32(init[d-1][k]) << (BITS-1-k);
+        }
+        else
+        {
+            // the next primitive polynomial and random odd m_k < 2^(k+1)
+            do
+            {
+                if( ++a == (1<<(s-1)) )
+                {
+                    ++s;
+                    a = 0;
+                }
+            } while( !isPrimitive(s,a) );
+            assert( s < BITS );
+
+            for( int k=0; k<s; ++k )
+            {
+                uint32 m = uint32( rng.random() ) & ((uint32(2)<<k)-1);
+                vd[k] = (m|1) << (BITS-1-k);
+            }
+        }
+
+        for( int k=s; k<BITS; ++k )
+        {
+            vd[k] = vd[k-s] ^ (vd[k-s]>>s);
+            for( int i=1; i<s; ++i )
+                if( (a>>(s-1-i)) & 1 )
+                    vd[k] ^= vd[k-i];
+        }
+    }
+}
+
+inline Sobol::~Sobol()
+{
+}
+
+
+/**
+ * Scramble the sequence by a random lower triangular binary matrix and a
+ * random digital shift of each dimension. Row j of the matrix has a unit
+ * diagonal and random bits left to it, and bit j of the new direction
+ * number is the parity of the row and the old direction number.
+ */
+inline void Sobol::scramble( uint64 seed, uint64 stream )
+{
+    Philox rng( seed, stream );
+    uint32 rows[BITS];
+
+    for( int d=0; d<nDim; ++d )
+    {
+        for( int j=0; j<BITS; ++j )
+        {
+            uint32 diag = uint32(1) << (BITS-1-j);
+            rows[j] = ( uint32(rng.random()) & ~(2*diag-1) ) | diag;
+        }
+
+        uint32 *vd = v[d];
+        for( int k=0; k<BITS; ++k )
+        {
+            uint32 t = 0;
+            for( int j=0; j<BITS; ++j )
+                if( parity( rows[j] & vd[k] ) )
+                    t |= uint32(1) << (BITS-1-j);
+            vd[k] = t;
+        }
+
+        shift[d] = uint32( rng.random() );
+    }
+
+    setPosition( pos );
+}
+
+
+/**
+ * Go to the n-th point, which is the xor of the direction numbers selected
+ * by the bits of the Gray code of "n".
+ */
+inline void Sobol::setPosition( uint64 n )
+{
+    assert( n < (uint64(1)<<BITS) );
+
+    uint32 g = uint32( n ^ (n>>1) );
+    for( int d=0; d<nDim; ++d )
+    {
+        uint32 x = shift[d];
+        for( int k=0; k<BITS; ++k )
+            if( (g>>k) & 1 )
+                x ^= v[d][k];
+        cur[d] = x;
+    }
+
+    pos = n;
+}
+
+
+/**
+ * Get the dimension and the index of the next point.
+ */
+inline int Sobol::dim() const
+{
+    return nDim;
+}
+
+inline Sobol::uint64 Sobol::getPosition() const
+{
+    return pos;
+}
+
+
+/**
+ * The next point in 32 bits integers.
+ */
+inline void Sobol::next( uint32 *x )
+{
+    for( int d=0; d<nDim; ++d )
+        x[d] = cur[d];
+
+    advance();
+}
+
+
+/**
+ * The next point in (0,1).
+ */
+template <typename Type>
+inline void Sobol::next( Vector<Type> &x )
+{
+    assert( x.size() == nDim );
+
+    for( int d=0; d<nDim; ++d )
+        x[d] = Type( (cur[d]+0.5) / 4294967296.0 );
+
+    advance();
+}
+
+
+/**
+ * The next "N" points in rows.
+ */
+template <typename Type>
+Matrix<Type> Sobol::generate( int N )
+{
+    Matrix<Type> X( N, nDim );
+    int nChunks = (N+CHUNK-1) / CHUNK;
+
+    #pragma omp parallel
+    {
+        Sobol g( *this );
+
+        #pragma omp for
+        for( int c=0; c<nChunks; ++c )
+        {
+            int i0 = c*CHUNK,
+                i1 = min( N, i0+CHUNK );
+            g.setPosition( pos+i0 );
+
+            for( int i=i0; i<i1; ++i )
+            {
+                Type *row = X[i];
+                for( int d=0; d<nDim; ++d )
+                    row[d] = Type( (g.cur[d]+0.5) / 4294967296.0 );
+                g.advance();
+            }
+        }
+    }
+
+    setPosition( pos+N );
+    return X;
+}
+
+
+/**
+ * Move to the next point in Gray code order, i.e. xor the direction number
+ * of the lowest zero bit of the current index.
+ */
+inline void Sobol::advance()
+{
+    int c = 0;
+    for( uint64 n=pos; n&1; n>>=1 )
+        ++c;
+    assert( c < BITS );
+
+    for( int d=0; d<nDim; ++d )
+        cur[d] ^= v[d][c];
+    ++pos;
+}
+
+
+/**
+ * Whether x^s + a(1)x^(s-1) + ... + a(s-1)x + 1 over GF(2) is primitive,
+ * where a(i) is bit s-1-i of "a", i.e. the order of x is 2^s-1.
+ */
+inline bool Sobol::isPrimitive( int s, int a )
+{
+    int p = (1<<s) | (a<<1) | 1,
+        period = (1<<s) - 1,
+        r = 1;
+
+    for( int t=1; t<=period; ++t )
+    {
+        r <<= 1;
+        if( r & (1<<s) )
+            r ^= p;
+        if( r == 1 )
+            return t == period;
+    }
+
+    return false;
+}
+
+
+/**
+ * The parity of the bits of "x".
+ */
+inline Sobol::uint32 Sobol::parity( uint32 x )
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+
+    return x & 1;
+}
+
+
+
+/**
+ * constructors and destructor
+ */
+inline Halton::Halton( int dim )
+: nDim(dim), pos(0), base(dim), offset(dim), digits(dim)
+{
+    assert( dim > 0 );
+
+    int len = 0;
+    for( int d=0, p=2; d<nDim; ++p )
+    {
+        bool prime = true;
+        for( int q=2; q*q<=p; ++q )
+            if( p%q == 0 )
+            {
+                prime = false;
+                break;
+            }
+
+        if( prime )
+        {
+            base[d] = p;
+            offset[d++] = len;
+            len += p;
+        }
+    }
+
+    perm.resize( len );
+    for( int d=0; d<nDim; ++d )
+        for( int i=0; i<base[d]; ++i )
+            perm[offset[d]+i] = i;
+}
+
+inline Halton::~Halton()
+{
+}
+
+
+/**
+ * Scramble the sequence by random permutations of the nonzero digits of
+ * each base, and random shifts of the digits from the first one down to
+ * the resolution of a double, i.e. the k-th digit "a" of the index becomes
+ * ( perm(a) + shift(k) ) mod b.
+ */
+inline void Halton::scramble( uint64 seed, uint64 stream )
+{
+    Philox rng( seed, stream );
+    shift.resize( nDim*MAXDIGITS );
+
+    for( int d=0; d<nDim; ++d )
+    {
+        int b = base[d];
+        int *p = &perm[offset[d]];
+        for( int i=b-1; i>1; --i )
+        {
+            int j = 1 + int( rng.random() % uint64(i) );
+            int t = p[i];
+            p[i] = p[j];
+            p[j] = t;
+        }
+
+        int K = 0;
+        for( double f=1.0/b; f>1.0e-16 && K<MAXDIGITS; f/=b )
+            shift[d*MAXDIGITS+K++] = int( rng.random() % uint64(b) );
+        digits[d] = K;
+    }
+}
+
+
+/**
+ * Go to the n-th point.
+ */
+inline void Halton::setPosition( uint64 n )
+{
+    pos = n;
+}
+
+
+/**
+ * Get the dimension and the index of the next point.
+ */
+inline int Halton::dim() const
+{
+    return nDim;
+}
+
+inline Halton::uint64 Halton::getPosition() const
+{
+    return pos;
+}
+
+
+/**
+ * The next point in [0,1).
+ */
+template <typename Type>
+inline void Halton::next( Vector<Type> &x )
+{
+    assert( x.size() == nDim );
+
+    for( int d=0; d<nDim; ++d )
+        x[d] = Type( radical(pos,d) );
+    ++pos;
+}
+
+
+/**
+ * The next "N" points in rows.
+ */
+template <typename Type>
+Matrix<Type> Halton::generate( int N )
+{
+    Matrix<Type> X( N, nDim );
+
+    #pragma omp parallel for
+    for( int i=0; i<N; ++i )
+    {
+        Type *row = X[i];
+        for( int d=0; d<nDim; ++d )
+            row[d] = Type( radical(pos+i,d) );
+    }
+
+    pos += N;
+    return X;
+}
+
+
+/**
+ * The (scrambled) radical inverse of "n" in the d-th base.
+ */
+inline double Halton::radical( uint64 n, int d ) const
+{
+    int b = base[d];
+    const int *p = &perm[offset[d]];
+    double f = 1.0 / b,
+           r = 0;
+
+    if( shift.size() == 0 )
+        while( n )
+        {
+            r += p[n%b] * f;
+            n /= b;
+            f /= b;
+        }
+    else
+    {
+        const int *s = &shift[d*MAXDIGITS];
+        for( int k=0; k<digits[d]; ++k )
+        {
+            r += ( (p[n%b]+s[k]) % b ) * f;
+            n /= b;
+            f /= b;
+        }
+    }
+
+    return r;
+}
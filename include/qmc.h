@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                    qmc.h
+ *
+ * Low-discrepancy (quasi-random) sequences for quasi-Monte Carlo methods.
+ *
+ * "Sobol" is the base-2 digital sequence of Sobol (1967) with 32 bits
+ * resolution. The direction numbers of the first 21 dimensions are those of
+ * Joe and Kuo (2008), the further dimensions use the next primitive
+ * polynomials (found at construction) with odd initial numbers drawn from a
+ * fixed random stream. The points are generated in Gray code order by one
+ * xor per coordinate (Antonov and Saleev, 1979), and jumping to any index
+ * costs O(32) xors per coordinate.
+ *
+ * "Halton" is the radical inverse sequence in the first "dim" primes.
+ *
+ * Both sequences can be randomized by "scramble", which keeps the low
+ * discrepancy and makes every point uniformly distributed, so the error of
+ * a QMC estimation can be measured by independently scrambled replicas. A
+ * Sobol sequence is scrambled by a random lower triangular binary matrix
+ * and a random digital shift (Matousek, 1998), a Halton sequence by random
+ * permutations of the nonzero digits of each base. The random numbers are
+ * taken from a "Philox" stream of the given seed and stream number.
+ *
+ * The coordinates are in (0,1): a Sobol coordinate is the centre of its
+ * 2^-32 wide cell. The first point (index 0) of an unscrambled sequence is
+ * at the origin (the centre of the first cell for Sobol). "generate" fills
+ * a matrix of consecutive points by chunks, which run in parallel if OpenMP
+ * is enabled.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef QMC_H
+#define QMC_H
+
+
+#include <vector.h>
+#include <matrix.h>
+#include <philox.h>
+
+
+namespace splab
+{
+
+    class Sobol
+    {
+
+    public:
+
+        typedef unsigned int        uint32;
+        typedef unsigned long long  uint64;
+
+        explicit Sobol( int dim );
+        ~Sobol();
+
+        void scramble( uint64 seed, uint64 stream=0 );
+        void setPosition( uint64 n );
+
+        int dim() const;
+        uint64 getPosition() const;
+
+        void next( uint32 *x );
+        template<typename Type> void next( Vector<Type> &x );
+        template<typename Type> Matrix<Type> generate( int N );
+
+    private:
+
+        static const int BITS = 32;
+        static const int CHUNK = 1024;
+
+        int nDim;
+        uint64 pos;
+
+        // direction numbers (nDim by BITS), digital shift and current point
+        Matrix<uint32> v;
+        Vector<uint32> shift;
+        Vector<uint32> cur;
+
+        void advance();
+
+        static bool isPrimitive( int s, int a );
+        static uint32 parity( uint32 x );
+
+    };
+    // class Sobol
+
+
+    class Halton
+    {
+
+    public:
+
+        typedef unsigned long long  uint64;
+
+        explicit Halton( int dim );
+        ~Halton();
+
+        void scramble( uint64 seed, uint64 stream=0 );
+        void setPosition( uint64 n );
+
+        int dim() const;
+        uint64 getPosition() const;
+
+        template<typename Type> void next( Vector<Type> &x );
+        template<typename Type> Matrix<Type> generate( int N );
+
+    private:
+
+        static const int MAXDIGITS = 53;
+
+        int nDim;
+        uint64 pos;
+
+        // the bases, the digit permutations of base b[d] starting at
+        // perm[offset[d]], and the shifts of the first digits[d] digits
+        // starting at shift[d*MAXDIGITS] (empty if not scrambled)
+        Vector<int> base;
+        Vector<int> offset;
+        Vector<int> perm;
+        Vector<int> digits;
+        Vector<int> shift;
+
+        double radical( uint64 n, int d ) const;
+
+    };
+    // class Halton
+
+
+    #include <qmc-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// QMC_H
@@ -36,7 +36,7 @@
  * constructor and destructor
  */
 template<typename Real>
-QRD<Real>::QRD()
+QRD<Real>::QRD() : hasQ(false)
 {
 }
 
@@ -52,49 +52,25 @@ QRD<Real>::~QRD()
 template <typename Real>
 void QRD<Real>::dec( const Matrix<Real> &A )
 {
-
     int m = A.rows(),
         n = A.cols(),
         p = min(m,n);
     QR = A;
     RDiag = Vector<Real>(p);
+    T = Matrix<Real>( (p < NB) ? p : NB, p );
+    hasQ = true;
 
-    // main loop.
-    for( int k=0; k<p; ++k )
+    // main loop over the panels of NB columns.
+    for( int j=0; j<p; j+=NB )
     {
-        // Compute 2-norm of k-th column without under/overflow.
-        Real nrm = 0;
-        for( int i=k; i<m; ++i )
-            nrm = hypot( nrm, QR[i][k] );
-//        for( int i=k; i<m; ++i )
-//            nrm += QR[i][k]*QR[i][k];
-//        nrm = sqrt(nrm);
-
-        if( nrm != 0 )
-        {
-            // Form k-th Householder vector.
-            if( QR[k][k] < 0 )
-                nrm = -nrm;
-
-            for( int i=k; i<m; ++i )
-                QR[i][k] /= nrm;
-
-            QR[k][k] += 1;
-
-            // Apply transformation to remaining columns.
-            for( int j=k+1; j<n; ++j )
-            {
-                Real s = 0;
-                for( int i=k; i<m; ++i )
-                    s += QR[i][k]*QR[i][j];
-
-                s = -s/QR[k][k];
-                for( int i=k; i<m; ++i )
-                    QR[i][j] += s*QR[i][k];
-            }
-        }
-
-        RDiag[k] = -nrm;
+        int jb = ( p-j < NB ) ? p-j : NB;
+        panel( j, jb );
+        formT( j, jb, &T[0][j], p );
+
+        // Apply the block reflector to the remaining columns.
+        if( j+jb < n )
+            applyBlockReflector( 'C', m-j, n-j-jb, jb, &QR[j][j], n,
+                                 &T[0][j], p, &QR[j][j+jb], n );
     }
 }
 
@@ -123,24 +99,10 @@ Matrix<Real> QRD<Real>::getQ()
         p = RDiag.dim();
     Matrix<Real> Q( m, p );
 
-    for( int k=p-1; k>=0; --k )
-    {
-        for( int i=0; i<m; ++i )
-            Q[i][k] = 0;
-
-        Q[k][k] = 1;
-        for( int j=k; j<p; ++j )
-            if( QR[k][k] != 0 )
-            {
-                Real s = 0;
-                for( int i=k; i<m; ++i )
-                    s += QR[i][k] * Q[i][j];
-
-                s = -s / QR[k][k];
-                for( int i=k; i<m; ++i )
-                    Q[i][j] += s*QR[i][k];
-            }
-    }
+    for( int i=0; i<p; ++i )
+        Q[i][i] = 1;
+    if( p > 0 )
+        applyBlocks( 'N', &Q[0][0], p );
 
     return Q;
 }
@@ -173,6 +135,8 @@ Matrix<Real> QRD<Real>::getR()
 template <typename Real>
 Matrix<Real> QRD<Real>::getH()
 {
+    assert( hasQ );
+
     int m = QR.rows(),
         p = RDiag.dim();
     Matrix<Real> H( m, p );
@@ -185,6 +149,65 @@ Matrix<Real> QRD<Real>::getH()
 }
 
 
+/**
+ * Return Q*b, where Q is the m-by-m product of the Householder reflectors
+ * and b has m elements.
+ */
+template <typename Real>
+Vector<Real> QRD<Real>::applyQ( const Vector<Real> &b )
+{
+    assert( b.dim() == QR.rows() );
+
+    Vector<Real> x = b;
+    if( x.dim() > 0 )
+        applyBlocks( 'N', &x[0], 1 );
+
+    return x;
+}
+
+template <typename Real>
+Matrix<Real> QRD<Real>::applyQ( const Matrix<Real> &B )
+{
+    assert( B.rows() == QR.rows() );
+
+    Matrix<Real> X = B;
+    if( X.rows() > 0 && X.cols() > 0 )
+        applyBlocks( 'N', &X[0][0], X.cols() );
+
+    return X;
+}
+
+
+/**
+ * Return transpose(Q)*b, where Q is the m-by-m product of the Householder
+ * reflectors and b has m elements. The first p elements correspond to
+ * the columns of the economic Q.
+ */
+template <typename Real>
+Vector<Real> QRD<Real>::applyQT( const Vector<Real> &b )
+{
+    assert( b.dim() == QR.rows() );
+
+    Vector<Real> x = b;
+    if( x.dim() > 0 )
+        applyBlocks( 'C', &x[0], 1 );
+
+    return x;
+}
+
+template <typename Real>
+Matrix<Real> QRD<Real>::applyQT( const Matrix<Real> &B )
+{
+    assert( B.rows() == QR.rows() );
+
+    Matrix<Real> X = B;
+    if( X.rows() > 0 && X.cols() > 0 )
+        applyBlocks( 'C', &X[0][0], X.cols() );
+
+    return X;
+}
+
+
 /**
  * Least squares solution of A*x = b
  * Return x: a vector that minimizes the two norm of Q*R*X-B.
@@ -203,19 +226,8 @@ Vector<Real> QRD<Real>::solve( const Vector<Real> &b )
     if( !isFullRank() )
         return Vector<Real>();
 
-    Vector<Real> x = b;
-
     // compute y = transpose(Q)*b
-    for( int k=0; k<n; ++k )
-    {
-        Real s = 0;
-        for( int i=k; i<m; ++i )
-            s += QR[i][k]*x[i];
-
-        s = -s/QR[k][k];
-        for( int i=k; i<m; ++i )
-            x[i] += s*QR[i][k];
-    }
+    Vector<Real> x = applyQT( b );
 
     // solve R*x = y;
     for( int k=n-1; k>=0; --k )
@@ -252,21 +264,9 @@ Matrix<Real> QRD<Real>::solve( const Matrix<Real> &B )
     if( !isFullRank() )
         return Matrix<Real>(0,0);
 
-    int nx = B.cols();
-    Matrix<Real> X = B;
-
     // compute Y = transpose(Q)*B
-    for( int k=0; k<n; ++k )
-        for( int j=0; j<nx; ++j )
-        {
-            Real s = 0;
-            for( int i=k; i<m; ++i )
-                s += QR[i][k]*X[i][j];
-
-            s = -s/QR[k][k];
-            for( int i=k; i<m; ++i )
-                X[i][j] += s*QR[i][k];
-        }
+    int nx = B.cols();
+    Matrix<Real> X = applyQT( B );
 
     // solve R*X = Y;
     for( int k=n-1; k>=0; --k )
@@ -287,3 +287,241 @@ Matrix<Real> QRD<Real>::solve( const Matrix<Real> &B )
 
      return X_;
 }
+
+
+/**
+ * Update R for the matrix A with the row "a" appended, m >= n. The new
+ * row is rotated into R by n Givens rotations.
+ */
+template <typename Real>
+void QRD<Real>::insertRow( const Vector<Real> &a )
+{
+    int n = QR.cols();
+    assert( RDiag.dim() == n );
+    assert( a.dim() == n );
+
+    dropQ();
+
+    Vector<Real> x = a;
+    for( int k=0; k<n; ++k )
+    {
+        Real r = hypot( RDiag[k], x[k] );
+        if( r == 0 )
+            continue;
+
+        Real c = RDiag[k] / r,
+             s = x[k] / r;
+        RDiag[k] = r;
+
+        for( int j=k+1; j<n; ++j )
+        {
+            Real t = QR[k][j];
+            QR[k][j] = c*t + s*x[j];
+            x[j] = c*x[j] - s*t;
+        }
+    }
+}
+
+
+/**
+ * Update R for the matrix A with the row "a" removed, m >= n, so that
+ * R'*R = A'*A - a*a'. With p = inv(R')*a, the Givens rotations which
+ * reduce [p; sqrt(1-p'*p)] to [0; 1] are applied to [R; 0], and the last
+ * row becomes a'. If A'*A - a*a' is not positive definite, i.e. p'*p >= 1,
+ * R is not changed and false is returned.
+ */
+template <typename Real>
+bool QRD<Real>::deleteRow( const Vector<Real> &a )
+{
+    int n = QR.cols();
+    assert( RDiag.dim() == n );
+    assert( a.dim() == n );
+
+    // solve R'*p = a
+    Vector<Real> p = a;
+    Real pp = 0;
+    for( int k=0; k<n; ++k )
+    {
+        for( int i=0; i<k; ++i )
+            p[k] -= QR[i][k]*p[i];
+        p[k] /= RDiag[k];
+        pp += p[k]*p[k];
+    }
+    if( !( pp < 1 ) )
+        return false;
+
+    dropQ();
+
+    // the rotations in the planes (k, n), k = n-1, ..., 0
+    Vector<Real> c(n), s(n);
+    Real alpha = sqrt( 1-pp );
+    for( int k=n-1; k>=0; --k )
+    {
+        Real scale = alpha + abs(p[k]),
+             a0 = alpha / scale,
+             b0 = p[k] / scale,
+             nrm = sqrt( a0*a0 + b0*b0 );
+
+        c[k] = a0 / nrm;
+        s[k] = b0 / nrm;
+        alpha = scale * nrm;
+    }
+
+    // apply them to the columns of R
+    for( int j=0; j<n; ++j )
+    {
+        Real xx = 0;
+        for( int i=j; i>=0; --i )
+        {
+            Real &rij = ( i == j ) ? RDiag[j] : QR[i][j];
+            Real t = c[i]*xx + s[i]*rij;
+            rij = c[i]*rij - s[i]*xx;
+            xx = t;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Form the k-th Householder vector and apply it to the columns k+1 to
+ * jEnd-1.
+ */
+template <typename Real>
+void QRD<Real>::householder( int k, int jEnd )
+{
+    int m = QR.rows();
+
+    // Compute 2-norm of k-th column without under/overflow.
+    Real scale = 0,
+         nrm = 0;
+    for( int i=k; i<m; ++i )
+        scale = max( scale, abs(QR[i][k]) );
+    if( scale != 0 )
+    {
+        for( int i=k; i<m; ++i )
+        {
+            Real t = QR[i][k] / scale;
+            nrm += t*t;
+        }
+        nrm = scale * sqrt(nrm);
+    }
+
+    if( nrm != 0 )
+    {
+        // Form k-th Householder vector.
+        if( QR[k][k] < 0 )
+            nrm = -nrm;
+
+        for( int i=k; i<m; ++i )
+            QR[i][k] /= nrm;
+
+        QR[k][k] += 1;
+
+        // Apply transformation to remaining columns.
+        for( int j=k+1; j<jEnd; ++j )
+        {
+            Real s = 0;
+            for( int i=k; i<m; ++i )
+                s += QR[i][k]*QR[i][j];
+
+            s = -s/QR[k][k];
+            for( int i=k; i<m; ++i )
+                QR[i][j] += s*QR[i][k];
+        }
+    }
+
+    RDiag[k] = -nrm;
+}
+
+
+/**
+ * Factorize the panel of columns j to j+w-1 recursively: the left half is
+ * factorized, its block reflector is applied to the right half, and then
+ * the right half is factorized.
+ */
+template <typename Real>
+void QRD<Real>::panel( int j, int w )
+{
+    if( w <= 4 )
+    {
+        for( int k=j; k<j+w; ++k )
+            householder( k, j+w );
+        return;
+    }
+
+    int m = QR.rows(),
+        n = QR.cols(),
+        w1 = w/2;
+
+    panel( j, w1 );
+
+    Matrix<Real> T1( w1, w1 );
+    formT( j, w1, &T1[0][0], w1 );
+    applyBlockReflector( 'C', m-j, w-w1, w1, &QR[j][j], n, &T1[0][0], w1,
+                         &QR[j][j+w1], n );
+
+    panel( j+w1, w-w1 );
+}
+
+
+/**
+ * Form the triangular factor of the reflectors j to j+w-1. For the k-th
+ * reflector H = I - v*v'/v[k], and it is the identity if RDiag[k] is 0.
+ */
+template <typename Real>
+void QRD<Real>::formT( int j, int w, Real *Tj, int ldt )
+{
+    Vector<Real> tau( w );
+    for( int k=0; k<w; ++k )
+        tau[k] = ( RDiag[j+k] != 0 ) ? 1/QR[j+k][j+k] : Real(0);
+
+    blockReflector( QR.rows()-j, w, &QR[j][j], QR.cols(), &tau[0],
+                    Tj, ldt );
+}
+
+
+/**
+ * X(m x nx) = Q*X if "trans" is 'N', or X = transpose(Q)*X if "trans" is
+ * 'C', by the block reflectors of the panels.
+ */
+template <typename Real>
+void QRD<Real>::applyBlocks( char trans, Real *X, int nx )
+{
+    assert( hasQ );
+
+    int m = QR.rows(),
+        n = QR.cols(),
+        p = RDiag.dim(),
+        nb = (p+NB-1) / NB;
+
+    for( int t=0; t<nb; ++t )
+    {
+        int j = ( trans == 'N' ) ? (nb-1-t)*NB : t*NB,
+            jb = ( p-j < NB ) ? p-j : NB;
+        applyBlockReflector( trans, m-j, nx, jb, &QR[j][j], n,
+                             &T[0][j], p, X+j*nx, nx );
+    }
+}
+
+
+/**
+ * Drop the Householder vectors, and keep R in the first n rows of QR.
+ */
+template <typename Real>
+void QRD<Real>::dropQ()
+{
+    if( !hasQ )
+        return;
+
+    int n = QR.cols();
+    Matrix<Real> R( n, n );
+    for( int i=0; i<n; ++i )
+        for( int j=i+1; j<n; ++j )
+            R[i][j] = QR[i][j];
+
+    QR = R;
+    T = Matrix<Real>();
+    hasQ = false;
+}
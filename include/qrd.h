@@ -40,6 +40,21 @@
  * is provided to find the least squares solution of Ax=b or AX=B using the
  * QR factors.
  *
+ * The decomposition is blocked: the Householder reflectors of each panel of
+ * NB columns are accumulated in the compact WY form I - V*T*V^T, and the
+ * trailing columns are updated by matrix-matrix products. The panels are
+ * factorized recursively in the same way. The triangular factors T are
+ * kept, so that Q or Q^T can be applied to right hand sides by "applyQ"
+ * and "applyQT" without forming Q.
+ *
+ * For m >= n, the R factor can be updated in O(n^2) operations when a row
+ * is appended to or removed from A, by "insertRow" and "deleteRow" (Givens
+ * rotations). Q is not kept by these updates: the Householder vectors are
+ * dropped, and only "isFullRank" and "getR" can be used afterwards. For a
+ * sliding-window least squares problem, factorize [A, b] instead of A; the
+ * last column of R is then [transpose(Q)*b; residual], and x is found by
+ * back substitution with the leading n-by-n block of R.
+ *
  * Zhang Ming, 2010-01 (revised 2010-12), Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -49,6 +64,7 @@
 
 
 #include <matrix.h>
+#include <householder.h>
 
 
 namespace splab
@@ -70,17 +86,39 @@ namespace splab
 		Matrix<Real> getR();
 		Matrix<Real> getH();
 
+		Vector<Real> applyQ( const Vector<Real> &b );
+		Matrix<Real> applyQ( const Matrix<Real> &B );
+		Vector<Real> applyQT( const Vector<Real> &b );
+		Matrix<Real> applyQT( const Matrix<Real> &B );
+
 		Vector<Real> solve( const Vector<Real> &b );
 		Matrix<Real> solve( const Matrix<Real> &B );
 
+		void insertRow( const Vector<Real> &a );
+		bool deleteRow( const Vector<Real> &a );
+
     private:
 
+		static const int NB = 32;
+
 		// internal storage of QR
 		Matrix<Real> QR;
 
 		// diagonal of R.
 		Vector<Real> RDiag;
 
+		// triangular factors of the block reflectors, NB columns each
+		Matrix<Real> T;
+
+		// false after the rows are updated
+		bool hasQ;
+
+		void householder( int k, int jEnd );
+		void panel( int j, int w );
+		void formT( int j, int w, Real *Tj, int ldt );
+		void applyBlocks( char trans, Real *X, int nx );
+		void dropQ();
+
 	};
 	// class QRD
 
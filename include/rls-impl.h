@@ -453,3 +453,565 @@ Type qrrls( const Type &xk, const Type &dk, Vector<Type> &wn,
     else
         return dotProd(wn,xn);
 }
+
+
+/**
+ * constructor of the RLS filter object, the parameters are the same as the
+ * function "rls".
+ */
+template <typename Type>
+RLS<Type>::RLS( int length, const Type &lambda, const Type &delta )
+          : AdaptFilter<Type>(length), lambda(lambda), delta(delta),
+            invR(length,length), vQ(length)
+{
+    assert( Type(0.8) <= lambda );
+    assert( lambda <= Type(1.0) );
+
+    for( int i=0; i<length; ++i )
+        invR[i][i] = 1/delta;
+}
+
+
+/**
+ * Reset the RLS filter, including the inverse correlation matrix.
+ */
+template <typename Type>
+void RLS<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    invR = Type(0);
+    for( int i=0; i<this->L; ++i )
+        invR[i][i] = 1/delta;
+}
+
+
+/**
+ * RLS update, return the a posteriori output as the function "rls". The
+ * inverse correlation matrix is symmetric, so only its upper triangle is
+ * updated.
+ */
+template <typename Type>
+Type RLS<Type>::update( const Type *xn, const Type &dk, const Type &yk )
+{
+    int L = this->L;
+    Type *wn = this->wn;
+
+    // vQ = invR * xn
+    for( int i=0; i<L; ++i )
+    {
+        const Type *Ri = invR[i];
+        Type sum = 0;
+        for( int j=0; j<L; ++j )
+            sum += Ri[j]*xn[j];
+        vQ[i] = sum;
+    }
+
+    Type r = 0;
+    for( int i=0; i<L; ++i )
+        r += vQ[i]*xn[i];
+    Type s = 1 / (lambda+r);
+
+    // invR = ( invR - vQ*vQ'/(lambda+r) ) / lambda
+    for( int i=0; i<L; ++i )
+    {
+        Type *Ri = invR[i];
+        Type qi = vQ[i]*s;
+        for( int j=i; j<L; ++j )
+            Ri[j] = ( Ri[j] - qi*vQ[j] ) / lambda;
+        for( int j=0; j<i; ++j )
+            Ri[j] = invR[j][i];
+    }
+
+    // update weight vector by the gain vector vQ/(lambda+r)
+    Type ak = (dk-yk) * s,
+         y = 0;
+    for( int i=0; i<L; ++i )
+    {
+        wn[i] += ak*vQ[i];
+        y += wn[i]*xn[i];
+    }
+
+    return y;
+}
+
+
+/**
+ * constructor of the stabilized fast transversal RLS filter object, the
+ * parameters are the same as the function "sftrls". The delay line keeps
+ * one more sample, so the previous input vector is available.
+ */
+template <typename Type>
+SFTRLS<Type>::SFTRLS( int length, const Type &lambda, const Type &epsilon )
+             : AdaptFilter<Type>(length,1), lambda(lambda), epsilon(epsilon),
+               phi(length), wf(length), wb(length), phiExt(length+1)
+{
+    assert( Type(1.0-1.0/(2*length)) <= lambda );
+    assert( lambda <= Type(1.0) );
+
+    reset();
+}
+
+
+/**
+ * Reset the SFTRLS filter, including the prediction variables.
+ */
+template <typename Type>
+void SFTRLS<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    gamma = 1;
+    xiBmin = epsilon;
+    xiFminInv = 1/epsilon;
+    phi = Type(0);
+    wf = Type(0);
+    wb = Type(0);
+}
+
+
+/**
+ * SFTRLS update, return the a posteriori output as the function "sftrls".
+ * xn[1], ..., xn[L] is the input vector of the previous step.
+ */
+template <typename Type>
+Type SFTRLS<Type>::update( const Type *xn, const Type &dk, const Type &yk )
+{
+    int N = this->L;
+    Type *wn = this->wn;
+    const Type *xnPrev = xn+1;
+
+    const Type  k1 = Type(1.5),
+                k2 = Type(2.5),
+                k3 = Type(1.0);
+
+    // forward prediction error
+    Type efp = xn[0];
+    for( int i=0; i<N; ++i )
+        efp -= wf[i]*xnPrev[i];
+    Type ef = gamma * efp;
+
+    phiExt[0] = efp * xiFminInv/lambda;
+    for( int i=0; i<N; ++i )
+        phiExt[i+1] = phi[i] - phiExt[0]*wf[i];
+
+    // gamma1
+    gamma = 1 / ( 1/gamma + phiExt[0]*efp );
+
+    // forward minimum weighted least-squares error
+    xiFminInv = xiFminInv/lambda - gamma*phiExt[0]*phiExt[0];
+
+    // forward prediction coefficient vector
+    for( int i=0; i<N; ++i )
+        wf[i] += ef*phi[i];
+
+    // backward prediction errors
+    Type ebp1 = lambda * xiBmin * phiExt[N],
+         ebp2 = xnPrev[N-1];
+    for( int i=0; i<N; ++i )
+        ebp2 -= wb[i]*xn[i];
+    Type ebp31 = (1-k1)*ebp1 + k1*ebp2,
+         ebp32 = (1-k2)*ebp1 + k2*ebp2,
+         ebp33 = (1-k3)*ebp1 + k3*ebp2;
+
+    // gamma2
+    gamma = 1 / ( 1/gamma - phiExt[N]*ebp33 );
+
+    // backward prediction errors
+    Type eb1 = gamma * ebp31,
+         eb2 = gamma * ebp32;
+
+    // backward minimum weighted least-squares error
+    xiBmin = lambda*xiBmin + eb2*ebp2;
+
+    for( int i=0; i<N; ++i )
+        phi[i] = phiExt[i] + phiExt[N]*wb[i];
+
+    // backward prediction coefficient vector
+    for( int i=0; i<N; ++i )
+        wb[i] += eb1*phi[i];
+
+    // gamma3
+    Type r = 0;
+    for( int i=0; i<N; ++i )
+        r += phi[i]*xn[i];
+    gamma = 1 / ( 1 + r );
+
+    // joint-process estimation
+    Type e = gamma * ( dk-yk ),
+         y = 0;
+    for( int i=0; i<N; ++i )
+    {
+        wn[i] += e*phi[i];
+        y += wn[i]*xn[i];
+    }
+
+    return y;
+}
+
+
+/**
+ * constructor of the lattice RLS filter object, the parameters are the
+ * same as the function "lrls".
+ */
+template <typename Type>
+LRLS<Type>::LRLS( int length, const Type &lambda, const Type &epsilon )
+           : AdaptFilter<Type>(length), lambda(lambda), epsilon(epsilon),
+             delta(length-1), deltaD(length), gammaOld(length),
+             ebOld(length), xiBminOld(length), xiFminOld(length),
+             gamma(length), eb(length), kb(length-1), kf(length-1),
+             xiBmin(length), xiFmin(length)
+{
+    assert( Type(0.8) <= lambda );
+    assert( lambda <= Type(1.0) );
+
+    reset();
+}
+
+
+/**
+ * Reset the LRLS filter, including the lattice variables.
+ */
+template <typename Type>
+void LRLS<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    delta = Type(0);
+    deltaD = Type(0);
+    gammaOld = Type(1);
+    ebOld = Type(0);
+    xiBminOld = epsilon;
+    xiFminOld = epsilon;
+}
+
+
+/**
+ * LRLS update and filtering, return the output as the function "lrls" with
+ * "training" on and off. The lattice uses only the latest sample.
+ */
+template <typename Type>
+inline Type LRLS<Type>::update( const Type *xn, const Type &dk, const Type& )
+{
+    return lattice( xn[0], dk, true );
+}
+
+template <typename Type>
+inline Type LRLS<Type>::response( const Type *xn )
+{
+    return lattice( xn[0], Type(0), false );
+}
+
+
+/**
+ * One step of the lattice, the ladder coefficients are the weights.
+ */
+template <typename Type>
+Type LRLS<Type>::lattice( const Type &xk, const Type &dk, bool training )
+{
+    int L = this->L-1;
+    Type *vn = this->wn;
+
+    // initializing for zero order
+    gamma[0] = 1;
+    xiBmin[0]= xk*xk + lambda*xiFminOld[0];
+    xiFmin[0] = xiBmin[0];
+
+    Type e = dk;
+    Type ef = xk;
+    eb[0] = xk;
+
+    for( int j=0; j<L; ++j )
+    {
+        // auxiliary parameters
+        delta[j] = lambda*delta[j] + ebOld[j]*ef/gammaOld[j];
+        gamma[j+1] = gamma[j] - eb[j]*eb[j]/xiBmin[j];
+
+        // reflection coefficients
+        kb[j] = delta[j] / xiFmin[j];
+        kf[j] = delta[j] / xiBminOld[j];
+
+        // prediction errors
+        eb[j+1] = ebOld[j] - kb[j]*ef;
+        ef -= kf[j]*ebOld[j];
+
+        // minimum least-squares
+        xiBmin[j+1] = xiBminOld[j] - delta[j]*kb[j];
+        xiFmin[j+1] = xiFmin[j] - delta[j]*kf[j];
+
+        // feedforward filtering
+        if( training )
+        {
+            deltaD[j] = lambda*deltaD[j] + e*eb[j]/gamma[j];
+            vn[j] = deltaD[j] / xiBmin[j];
+        }
+        e -= vn[j]*eb[j];
+    }
+
+    // last order feedforward filtering
+    if( training )
+    {
+        deltaD[L] = lambda*deltaD[L] + e*eb[L]/gamma[L];
+        vn[L] = deltaD[L] / xiBmin[L];
+    }
+    e -= vn[L]*eb[L];
+
+    // updated parameters
+    gammaOld = gamma;
+    ebOld = eb;
+    xiFminOld = xiFmin;
+    xiBminOld = xiBmin;
+
+    return dk-e;
+}
+
+
+/**
+ * constructor of the error feedback lattice RLS filter object, the
+ * parameters are the same as the function "eflrls".
+ */
+template <typename Type>
+EFLRLS<Type>::EFLRLS( int length, const Type &lambda, const Type &epsilon )
+             : AdaptFilter<Type>(length), lambda(lambda), epsilon(epsilon),
+               delta(length-1), deltaD(length), gammaOld(length),
+               ebOld(length), kb(length-1), kf(length-1),
+               xiBminOld2(length), xiBminOld(length), xiFminOld(length),
+               gamma(length), eb(length), xiBmin(length), xiFmin(length)
+{
+    assert( Type(0.8) <= lambda );
+    assert( lambda <= Type(1.0) );
+
+    reset();
+}
+
+
+/**
+ * Reset the EFLRLS filter, including the lattice variables.
+ */
+template <typename Type>
+void EFLRLS<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    delta = Type(0);
+    deltaD = Type(0);
+    gammaOld = Type(1);
+    ebOld = Type(0);
+    kb = Type(0);
+    kf = Type(0);
+    xiBminOld2 = epsilon;
+    xiBminOld = epsilon;
+    xiFminOld = epsilon;
+}
+
+
+/**
+ * EFLRLS update and filtering, return the output as the function "eflrls"
+ * with "training" on and off. The lattice uses only the latest sample.
+ */
+template <typename Type>
+inline Type EFLRLS<Type>::update( const Type *xn, const Type &dk,
+                                  const Type& )
+{
+    return lattice( xn[0], dk, true );
+}
+
+template <typename Type>
+inline Type EFLRLS<Type>::response( const Type *xn )
+{
+    return lattice( xn[0], Type(0), false );
+}
+
+
+/**
+ * One step of the lattice, the ladder coefficients are the weights.
+ */
+template <typename Type>
+Type EFLRLS<Type>::lattice( const Type &xk, const Type &dk, bool training )
+{
+    int L = this->L-1;
+    Type *vn = this->wn;
+
+    // initializing for zero order
+    gamma[0] = 1;
+    xiBmin[0]= xk*xk + lambda*xiFminOld[0];
+    xiFmin[0] = xiBmin[0];
+
+    Type tmp = 0;
+    Type e = dk;
+    Type ef = xk;
+    eb[0] = xk;
+
+    for( int j=0; j<L; ++j )
+    {
+        // auxiliary parameters
+        delta[j] = lambda*delta[j] + ebOld[j]*ef/gammaOld[j];
+        gamma[j+1] = gamma[j] - eb[j]*eb[j]/xiBmin[j];
+
+        // reflection coefficients
+        tmp = ebOld[j]*ef / gammaOld[j]/lambda;
+
+        kb[j] = gamma[j+1]/gammaOld[j] * ( kb[j] + tmp/xiFminOld[j] );
+        kf[j] = gammaOld[j+1]/gammaOld[j] * ( kf[j] + tmp/xiBminOld2[j] );
+
+        // prediction errors
+        eb[j+1] = ebOld[j] - kb[j]*ef;
+        ef -= kf[j]*ebOld[j];
+
+        // minimum least-squares
+        xiBmin[j+1] = xiBminOld[j] - delta[j]*delta[j]/xiFmin[j];
+        xiFmin[j+1] = xiFmin[j] - delta[j]*delta[j]/xiBminOld[j];
+
+        // feedforward filtering
+        if( training )
+           vn[j] = gamma[j+1]/gamma[j] *
+                   ( vn[j] + e*eb[j]/(lambda*gamma[j]*xiBminOld[j]) );
+
+        e -= vn[j]*eb[j];
+    }
+
+    // last order feedforward filtering
+    if( training )
+        vn[L] = (gamma[L]-eb[L]*eb[L]/xiBmin[L])/gamma[L] *
+                (vn[L]+e*eb[L]/(lambda*gamma[L]*xiBminOld[L]));
+    e -= vn[L]*eb[L];
+
+    // updated parameters
+    gammaOld = gamma;
+    ebOld = eb;
+    xiBminOld2 = xiBminOld;
+    xiBminOld = xiBmin;
+    xiFminOld = xiFmin;
+
+    return dk-e;
+}
+
+
+/**
+ * constructor of the QR-RLS filter object, the parameter is the same as
+ * the function "qrrls".
+ */
+template <typename Type>
+QRRLS<Type>::QRRLS( int length, const Type &lambdaSqrt )
+            : AdaptFilter<Type>(length), lambdaSqrt(lambdaSqrt),
+              Up(length,length), dq2p(length), dInit(length), xp(length)
+{
+    reset();
+}
+
+
+/**
+ * Reset the QR-RLS filter, the initializing steps start again.
+ */
+template <typename Type>
+void QRRLS<Type>::reset()
+{
+    AdaptFilter<Type>::reset();
+
+    nInit = 0;
+    sx1 = 0;
+    Up = Type(0);
+    dq2p = Type(0);
+    dInit = Type(0);
+}
+
+
+/**
+ * QR-RLS update, return the a posteriori output as the function "qrrls".
+ * The first L steps solve the weights by back substitution, then the
+ * triangular factor is updated by Givens rotations.
+ */
+template <typename Type>
+Type QRRLS<Type>::update( const Type *xn, const Type &dk, const Type& )
+{
+    int N = this->L;
+    Type *wn = this->wn;
+    Type ep, tmp;
+
+    if( nInit < N )
+    {
+        // update Up and dq2p by the new input vector and desired sample
+        for( int i=N-1; i>0; --i )
+            for( int j=0; j<N; ++j )
+                Up[i][j] = lambdaSqrt * Up[i-1][j];
+        for( int j=0; j<N; ++j )
+            Up[0][j] = lambdaSqrt * xn[j];
+
+        dInit[nInit] = dk;
+        for( int i=N-1; i>0; --i )
+            dq2p[i] = lambdaSqrt * dq2p[i-1];
+        dq2p[0] = lambdaSqrt * dk;
+
+        // the first input is the diagonal of the triangular system
+        if( nInit == 0 )
+        {
+            sx1 = xn[0];
+            if( abs(sx1) < Type(1.0e-6) )
+                sx1 = Type(1.0);
+        }
+        nInit++;
+
+        // new weight vector
+        int k = nInit;
+        wn[0] = dInit[0] / sx1;
+        for( int i=1; i<k; ++i )
+        {
+            tmp = 0;
+            for( int j=1; j<=i; ++j )
+                tmp += xn[k-1-j]*wn[i-j];
+            wn[i] = ( -tmp+dInit[i] ) / sx1;
+        }
+
+        ep = dk;
+        for( int i=0; i<N; ++i )
+            ep -= wn[i]*xn[i];
+    }
+    else
+    {
+        for( int j=0; j<N; ++j )
+            xp[j] = xn[j];
+        Type gammap = 1,
+             dp = dk;
+
+        // Givens rotations
+        for( int i=0; i<N; ++i )
+        {
+            Type *ui = Up[i];
+            int c = N-1-i;
+            Type r = sqrt( ui[c]*ui[c] + xp[c]*xp[c] ),
+                 cosTheta = ui[c] / r,
+                 sinTheta = xp[c] / r;
+            gammap *= cosTheta;
+
+            for( int j=0; j<N; ++j )
+            {
+                tmp = xp[j];
+                xp[j] = cosTheta*tmp - sinTheta*ui[j];
+                ui[j] = sinTheta*tmp + cosTheta*ui[j];
+            }
+
+            tmp = dp;
+            dp = cosTheta*tmp - sinTheta*dq2p[i];
+            dq2p[i] = sinTheta*tmp + cosTheta*dq2p[i];
+        }
+
+        ep = dp / gammap;
+
+        // new weight vector
+        wn[0] = dq2p[N-1] / Up[N-1][0];
+        for( int i=1; i<N; ++i )
+        {
+            const Type *ui = Up[N-1-i];
+            tmp = 0;
+            for( int j=1; j<=i; ++j )
+                tmp += ui[i-j] * wn[i-j];
+            wn[i] = ( -tmp+dq2p[N-1-i] ) / ui[i];
+        }
+
+        // updating internal variables
+        Up *= lambdaSqrt;
+        dq2p *= lambdaSqrt;
+    }
+
+    return dk-ep;
+}
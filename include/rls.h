@@ -45,6 +45,15 @@
  * lattice RLS (lrls),           error feedblck lattice RLS (eflrls),
  * QR based RLS (qrrls).
  *
+ * The functions keep their state in static variables, so only one filter of
+ * each kind can be used in a program. The classes "RLS", "SFTRLS", "LRLS",
+ * "EFLRLS" and "QRRLS" (derived from "AdaptFilter") implement the same
+ * algorithms with per-object state and allocation-free updates, so they
+ * can run in any number, e.g. one per channel by "adaptChannels". The
+ * "training" option of the functions corresponds to "adapt" ("on") and
+ * "filter" ("off"). The weights of the lattice filters are the
+ * coefficients of the ladder part.
+ *
  * Zhang Ming, 2010-10, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -55,6 +64,7 @@
 
 #include <vector.h>
 #include <matrix.h>
+#include <adaptfilter.h>
 
 
 namespace splab
@@ -81,6 +91,170 @@ namespace splab
                 const Type&, const string& );
 
 
+    template <typename Type>
+    class RLS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        RLS( int length, const Type &lambda, const Type &delta );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type lambda,
+             delta;
+
+        // inverse of the correlation matrix and the work vector
+        Matrix<Type> invR;
+        Vector<Type> vQ;
+
+    };
+    // class RLS
+
+
+    template <typename Type>
+    class SFTRLS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        SFTRLS( int length, const Type &lambda, const Type &epsilon );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type lambda,
+             epsilon;
+
+        // conversion factor and the minimum backward and (inverse) forward
+        // least-squares errors
+        Type gamma,
+             xiBmin,
+             xiFminInv;
+
+        // gain vector, forward and backward prediction coefficients, and
+        // the work vector of the extended gain
+        Vector<Type> phi, wf, wb;
+        Vector<Type> phiExt;
+
+    };
+    // class SFTRLS
+
+
+    template <typename Type>
+    class LRLS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        LRLS( int length, const Type &lambda, const Type &epsilon );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+        Type response( const Type *xn );
+
+    private:
+
+        Type lambda,
+             epsilon;
+
+        // variables of the previous step
+        Vector<Type> delta, deltaD,
+                     gammaOld, ebOld,
+                     xiBminOld, xiFminOld;
+
+        // work vectors of the current step
+        Vector<Type> gamma, eb,
+                     kb, kf,
+                     xiBmin, xiFmin;
+
+        Type lattice( const Type &xk, const Type &dk, bool training );
+
+    };
+    // class LRLS
+
+
+    template <typename Type>
+    class EFLRLS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        EFLRLS( int length, const Type &lambda, const Type &epsilon );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+        Type response( const Type *xn );
+
+    private:
+
+        Type lambda,
+             epsilon;
+
+        // variables of the previous steps
+        Vector<Type> delta, deltaD,
+                     gammaOld, ebOld,
+                     kb, kf,
+                     xiBminOld2, xiBminOld, xiFminOld;
+
+        // work vectors of the current step
+        Vector<Type> gamma, eb,
+                     xiBmin, xiFmin;
+
+        Type lattice( const Type &xk, const Type &dk, bool training );
+
+    };
+    // class EFLRLS
+
+
+    template <typename Type>
+    class QRRLS : public AdaptFilter<Type>
+    {
+
+    public:
+
+        QRRLS( int length, const Type &lambdaSqrt );
+
+        void reset();
+
+    protected:
+
+        Type update( const Type *xn, const Type &dk, const Type &yk );
+
+    private:
+
+        Type lambdaSqrt;
+
+        // number of the initializing steps taken, and the first input
+        int nInit;
+        Type sx1;
+
+        // triangular factor, rotated desired signal, the desired signal of
+        // the initializing steps and the work vector
+        Matrix<Type> Up;
+        Vector<Type> dq2p, dInit, xp;
+
+    };
+    // class QRRLS
+
+
     #include <rls-impl.h>
 
 }
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                               sampler-impl.h
+ *
+ * Implementation for Sampler class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * The ziggurat of f(x) consists of the base layer (a rectangle of width
+ * x[1] = r plus the tail beyond r) and the rectangles [0,x[i]] with heights
+ * from f(x[i]) to f(x[i+1]), all of the same area v. x[0] = v/f(r) is the
+ * width of a rectangle having the area of the base layer.
+ */
+inline Sampler::Sampler( uint64 seed, uint64 stream )
+: rng( seed, stream )
+{
+    const double rN = 3.6541528853610088,
+                 vN = 0.00492867323399,
+                 rE = 7.69711747013104972,
+                 vE = 0.0039496598225815571993;
+
+    xN[0] = vN / exp(-0.5*rN*rN);
+    xN[1] = rN;
+    xE[0] = vE / exp(-rE);
+    xE[1] = rE;
+    for( int i=1; i<LAYERS-1; ++i )
+    {
+        double y = vN/xN[i] + exp(-0.5*xN[i]*xN[i]);
+        xN[i+1] = ( y < 1 ) ? sqrt(-2*log(y)) : 0.0;
+
+        y = vE/xE[i] + exp(-xE[i]);
+        xE[i+1] = ( y < 1 ) ? -log(y) : 0.0;
+    }
+    xN[LAYERS] = 0;
+    xE[LAYERS] = 0;
+
+    for( int i=0; i<=LAYERS; ++i )
+    {
+        fN[i] = exp(-0.5*xN[i]*xN[i]);
+        fE[i] = exp(-xE[i]);
+    }
+}
+
+inline Sampler::~Sampler()
+{
+}
+
+
+/**
+ * Get the generator.
+ */
+inline Philox& Sampler::engine()
+{
+    return rng;
+}
+
+
+/**
+ * Map 64 bits to an uniform number in (0,1).
+ */
+inline double Sampler::toUniform( uint64 x )
+{
+    return ( (x>>11) + 0.5 ) * ( 1.0/9007199254740992.0 );
+}
+
+
+/**
+ * Return an Uniform(0,1) distributed number.
+ */
+inline double Sampler::uniform()
+{
+    return rng.uniform();
+}
+
+
+/**
+ * Return a Normal(0,1) distributed number. The low 8 bits of the output
+ * select the layer, and the high 53 bits give the abscissa.
+ */
+inline double Sampler::normal()
+{
+    uint64 w = rng.random();
+    int i = int( w & (LAYERS-1) );
+    double x = ( 2*toUniform(w) - 1 ) * xN[i];
+
+    if( abs(x) < xN[i+1] )
+        return x;
+    else
+        return normalSlow( i, x );
+}
+
+
+/**
+ * The rejected point "x" of the layer "i": sample the tail for the base
+ * layer, or test it under the density in the other layers.
+ */
+inline double Sampler::normalSlow( int i, double x )
+{
+    if( i == 0 )
+    {
+        double r = xN[1],
+               a, b;
+        do
+        {
+            a = -log( rng.uniform() ) / r;
+            b = -log( rng.uniform() );
+        } while( b+b < a*a );
+
+        return ( x < 0 ) ? -(r+a) : r+a;
+    }
+
+    if( fN[i+1] + rng.uniform()*(fN[i]-fN[i+1]) < exp(-0.5*x*x) )
+        return x;
+    else
+        return normal();
+}
+
+
+/**
+ * Return an Exponential(1) distributed number.
+ */
+inline double Sampler::exponential()
+{
+    uint64 w = rng.random();
+    int i = int( w & (LAYERS-1) );
+    double x = toUniform(w) * xE[i];
+
+    if( x < xE[i+1] )
+        return x;
+    else
+        return exponentialSlow( i, x );
+}
+
+inline double Sampler::exponentialSlow( int i, double x )
+{
+    if( i == 0 )
+        return xE[1] - log( rng.uniform() );
+
+    if( fE[i+1] + rng.uniform()*(fE[i]-fE[i+1]) < exp(-x) )
+        return x;
+    else
+        return exponential();
+}
+
+
+/**
+ * Fill a vector by Normal(mu,sigma) distributed numbers.
+ */
+template <typename Type>
+void Sampler::normal( Vector<Type> &xn, const Type &mu, const Type &sigma )
+{
+    int N = xn.size();
+    Vector<uint64> wn(N);
+    Vector<double> yn(N);
+    Vector<int> ok(N);
+    rng.random( &wn[0], N );
+
+    // fast path of the ziggurat, then the rejected samples
+    #pragma omp parallel for
+    for( int k=0; k<N; ++k )
+    {
+        int i = int( wn[k] & (LAYERS-1) );
+        double x = ( 2*toUniform(wn[k]) - 1 ) * xN[i];
+        yn[k] = x;
+        ok[k] = ( abs(x) < xN[i+1] );
+    }
+
+    for( int k=0; k<N; ++k )
+    {
+        if( !ok[k] )
+            yn[k] = normalSlow( int( wn[k] & (LAYERS-1) ), yn[k] );
+        xn[k] = mu + sigma*Type(yn[k]);
+    }
+}
+
+
+/**
+ * Fill a vector by Exponential(beta) distributed numbers, where "beta" is
+ * the mean.
+ */
+template <typename Type>
+void Sampler::exponential( Vector<Type> &xn, const Type &beta )
+{
+    int N = xn.size();
+    Vector<uint64> wn(N);
+    Vector<double> yn(N);
+    Vector<int> ok(N);
+    rng.random( &wn[0], N );
+
+    #pragma omp parallel for
+    for( int k=0; k<N; ++k )
+    {
+        int i = int( wn[k] & (LAYERS-1) );
+        double x = toUniform(wn[k]) * xE[i];
+        yn[k] = x;
+        ok[k] = ( x < xE[i+1] );
+    }
+
+    for( int k=0; k<N; ++k )
+    {
+        if( !ok[k] )
+            yn[k] = exponentialSlow( int( wn[k] & (LAYERS-1) ), yn[k] );
+        xn[k] = beta*Type(yn[k]);
+    }
+}
+
+
+/**
+ * log(k!), by a table for small k and the Stirling series for large k.
+ */
+inline double Sampler::logFactorial( int k )
+{
+    static const double table[10] =
+    {
+        0.0, 0.0, 0.69314718055994531, 1.7917594692280550,
+        3.1780538303479458, 4.7874917427820460, 6.5792512120101010,
+        8.5251613610654143, 10.604602902745251, 12.801827480081469
+    };
+
+    if( k < 10 )
+        return table[k];
+
+    double x = k+1.0,
+           x2 = x*x;
+    return (x-0.5)*log(x) - x + 0.91893853320467274
+           + ( 1.0/12 - ( 1.0/360 - 1.0/(1260*x2) ) / x2 ) / x;
+}
+
+
+/**
+ * Poisson sampler by inversion, for small lambda.
+ */
+inline int Sampler::poissonInv( double lambda )
+{
+    double p = exp(-lambda),
+           u = rng.uniform();
+    int k = 0;
+
+    while( u > p && p > 0 )
+    {
+        u -= p;
+        k++;
+        p *= lambda / k;
+    }
+
+    return k;
+}
+
+
+/**
+ * Constants of PTRS method: sqrt(lambda), log(lambda), a, b, 1/alpha, v_r.
+ */
+inline void Sampler::poissonSetup( double lambda, double *c )
+{
+    c[0] = sqrt(lambda);
+    c[1] = log(lambda);
+    c[3] = 0.931 + 2.53*c[0];
+    c[2] = -0.059 + 0.02483*c[3];
+    c[4] = 1.1239 + 1.1328/(c[3]-3.4);
+    c[5] = 0.9277 - 3.6224/(c[3]-2);
+}
+
+
+/**
+ * Poisson sampler by PTRS method, for lambda >= 10.
+ */
+inline int Sampler::poissonPTRS( double lambda, const double *c )
+{
+    double a = c[2],
+           b = c[3];
+
+    for( ;; )
+    {
+        double u = rng.uniform() - 0.5,
+               v = rng.uniform(),
+               us = 0.5 - abs(u);
+        int k = int( floor( (2*a/us+b)*u + lambda + 0.43 ) );
+
+        if( us >= 0.07 && v <= c[5] )
+            return k;
+        if( k < 0 || ( us < 0.013 && v > us ) )
+            continue;
+        if( log(v) + log(c[4]) - log(a/(us*us)+b)
+            <= -lambda + k*c[1] - logFactorial(k) )
+            return k;
+    }
+}
+
+
+/**
+ * Return a Poisson(lambda) distributed number.
+ */
+inline int Sampler::poisson( double lambda )
+{
+    if( lambda < 10 )
+        return poissonInv( lambda );
+
+    double c[6];
+    poissonSetup( lambda, c );
+    return poissonPTRS( lambda, c );
+}
+
+
+/**
+ * Fill a vector by Poisson(lambda) distributed numbers.
+ */
+inline void Sampler::poisson( Vector<int> &xn, double lambda )
+{
+    int N = xn.size();
+
+    if( lambda < 10 )
+        for( int k=0; k<N; ++k )
+            xn[k] = poissonInv( lambda );
+    else
+    {
+        double c[6];
+        poissonSetup( lambda, c );
+        for( int k=0; k<N; ++k )
+            xn[k] = poissonPTRS( lambda, c );
+    }
+}
+
+
+/**
+ * Binomial sampler by inversion, for small n*p (p <= 0.5).
+ */
+inline int Sampler::binomialInv( int n, double p )
+{
+    double q = 1-p,
+           s = p/q,
+           a = (n+1)*s,
+           r = pow( q, double(n) ),
+           u = rng.uniform();
+    int k = 0;
+
+    while( u > r && k < n )
+    {
+        u -= r;
+        k++;
+        r *= a/k - s;
+    }
+
+    return k;
+}
+
+
+/**
+ * Constants of BTRS method (p <= 0.5): a, b, c, v_r, alpha, log(p/q), m,
+ * log(m!)+log((n-m)!).
+ */
+inline void Sampler::binomialSetup( int n, double p, double *c )
+{
+    double q = 1-p,
+           spq = sqrt(n*p*q);
+
+    c[1] = 1.15 + 2.53*spq;
+    c[0] = -0.0873 + 0.0248*c[1] + 0.01*p;
+    c[2] = n*p + 0.5;
+    c[3] = 0.92 - 4.2/c[1];
+    c[4] = (2.83 + 5.1/c[1]) * spq;
+    c[5] = log(p/q);
+    c[6] = floor( (n+1)*p );
+    c[7] = logFactorial( int(c[6]) ) + logFactorial( n-int(c[6]) );
+}
+
+
+/**
+ * Binomial sampler by BTRS method, for n*p >= 10 (p <= 0.5), the constants
+ * "c" are set by "binomialSetup".
+ */
+inline int Sampler::binomialBTRS( int n, const double *c )
+{
+    double a = c[0],
+           b = c[1];
+    int m = int( c[6] );
+
+    for( ;; )
+    {
+        double u = rng.uniform() - 0.5,
+               v = rng.uniform(),
+               us = 0.5 - abs(u);
+        int k = int( floor( (2*a/us+b)*u + c[2] ) );
+
+        if( k < 0 || k > n )
+            continue;
+        if( us >= 0.07 && v <= c[3] )
+            return k;
+
+        v = log( v*c[4] / (a/(us*us)+b) );
+        if( v <= c[7] - logFactorial(k) - logFactorial(n-k) + (k-m)*c[5] )
+            return k;
+    }
+}
+
+
+/**
+ * Return a Binomial(n,p) distributed number.
+ */
+inline int Sampler::binomial( int n, double p )
+{
+    bool flip = ( p > 0.5 );
+    double pp = flip ? 1-p : p;
+    int k;
+
+    if( n*pp < 10 )
+        k = binomialInv( n, pp );
+    else
+    {
+        double c[8];
+        binomialSetup( n, pp, c );
+        k = binomialBTRS( n, c );
+    }
+
+    return flip ? n-k : k;
+}
+
+
+/**
+ * Fill a vector by Binomial(n,p) distributed numbers.
+ */
+inline void Sampler::binomial( Vector<int> &xn, int n, double p )
+{
+    int N = xn.size();
+    bool flip = ( p > 0.5 );
+    double pp = flip ? 1-p : p;
+
+    if( n*pp < 10 )
+        for( int k=0; k<N; ++k )
+            xn[k] = binomialInv( n, pp );
+    else
+    {
+        double c[8];
+        binomialSetup( n, pp, c );
+        for( int k=0; k<N; ++k )
+            xn[k] = binomialBTRS( n, c );
+    }
+
+    if( flip )
+        for( int k=0; k<N; ++k )
+            xn[k] = n - xn[k];
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                                  sampler.h
+ *
+ * Fast samplers of normal, exponential, Poisson and binomial distributions.
+ *
+ * The samplers are driven by the counter-based generator "Philox":
+ * normal       : ziggurat method (Marsaglia and Tsang, 2000) with 256
+ *                layers, about 99% of the samples need only one 64 bits
+ *                output and a multiplication, and the tails are exact;
+ * exponential  : ziggurat method with 256 layers;
+ * Poisson      : inversion for lambda < 10, and transformed rejection with
+ *                squeeze (PTRS, Hormann, 1993) otherwise;
+ * binomial     : inversion for n*min(p,1-p) < 10, and transformed rejection
+ *                (BTRS, Hormann, 1993) otherwise.
+ *
+ * The bulk normal and exponential samplers fill the random bits of the whole
+ * vector by "Philox" at first, and then take the fast path of the ziggurat
+ * for all samples in one loop which can be vectorized by the compiler. The
+ * few rejected samples are regenerated one by one afterwards, so the result
+ * doesn't depend on the number of threads. The bulk Poisson and binomial
+ * samplers compute the constants of the rejection method only once.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+
+#include <philox.h>
+
+
+namespace splab
+{
+
+    class Sampler
+    {
+
+    public:
+
+        typedef Philox::uint64  uint64;
+
+        explicit Sampler( uint64 seed=0, uint64 stream=0 );
+        ~Sampler();
+
+        Philox& engine();
+
+        double uniform();
+        double normal();
+        double exponential();
+        int poisson( double lambda );
+        int binomial( int n, double p );
+
+        template<typename Type> void normal( Vector<Type> &xn,
+                                             const Type &mu=Type(0),
+                                             const Type &sigma=Type(1) );
+        template<typename Type> void exponential( Vector<Type> &xn,
+                                                  const Type &beta=Type(1) );
+        void poisson( Vector<int> &xn, double lambda );
+        void binomial( Vector<int> &xn, int n, double p );
+
+    private:
+
+        static const int LAYERS = 256;
+
+        Philox rng;
+
+        // right edges and densities of the ziggurat layers
+        double xN[LAYERS+1], fN[LAYERS+1];
+        double xE[LAYERS+1], fE[LAYERS+1];
+
+        double normalSlow( int i, double x );
+        double exponentialSlow( int i, double x );
+
+        int poissonInv( double lambda );
+        int poissonPTRS( double lambda, const double *c );
+        int binomialInv( int n, double p );
+        int binomialBTRS( int n, const double *c );
+
+        static void poissonSetup( double lambda, double *c );
+        static void binomialSetup( int n, double p, double *c );
+        static double logFactorial( int k );
+        static double toUniform( uint64 x );
+
+    };
+    // class Sampler
+
+
+    #include <sampler-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// SAMPLER_H
@@ -206,6 +206,55 @@ void heapSort( Vector<Type> &a, int left, int right )
 }
 
 
+/**
+ * Introselect algorithm, using the same partitioning as quick sort.
+ * "a"      ---->   array of Comparable items.
+ * "left"   ---->   the left-most index of the subarray.
+ * "right"  ---->   the right-most index of the subarray.
+ * "k"      ---->   the index to be placed, left <= k <= right.
+ */
+template <typename Type>
+void quickSelect( Vector<Type> &a, int left, int right, int k )
+{
+    int depth = 0;
+    for( int n=right-left+1; n>1; n/=2 )
+        depth += 2;
+
+    while( left+20 <= right )
+    {
+        if( depth-- == 0 )
+        {
+            heapSort( a, left, right );
+            return;
+        }
+
+        Type pivot = median3( a, left, right );
+
+        int i = left, j = right-1;
+        for( ; ; )
+        {
+            while( a[++i] < pivot ) { }
+            while( pivot < a[--j] ) { }
+
+            if( i < j )
+                swap( a[i], a[j] );
+            else
+                break;
+        }
+        swap( a[i], a[right-1] );
+
+        if( k < i )
+            right = i-1;
+        else if( k > i )
+            left = i+1;
+        else
+            return;
+    }
+
+    insertSort( a, left, right );
+}
+
+
 /**
  * Return median of left, center, and right.
  * Order these and hide the pivot.
@@ -32,6 +32,12 @@
  * sorting, selection sorting, insertion sorting, quick sorting, merging
  * sorting, and heap sorting.
  *
+ * "quickSelect" partially sorts a subarray so that its k-th element is in
+ * the sorted place, with the smaller elements before it and the larger ones
+ * after it. It's the introselect algorithm: quick selection with median-of-
+ * three partitioning, which takes expected linear time, and falls back to
+ * heap sorting if the partitions are too unbalanced.
+ *
  * Zhang Ming, 2010-07, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -56,6 +62,8 @@ namespace splab
     template<typename Type> void mergSort( Vector<Type>&, int, int );
     template<typename Type> void heapSort( Vector<Type>&, int, int );
 
+    template<typename Type> void quickSelect( Vector<Type>&, int, int, int );
+
     template<typename Type> const Type& median3( Vector<Type>&, int, int );
     template<typename Type> void merg( Vector<Type>&, int, int, int, int );
     template<typename Type> void filterDown( Vector<Type>&, int, int );
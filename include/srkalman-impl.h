@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              srkalman-impl.h
+ *
+ * Implementation for SRKalmanFilter class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * Lower triangular Cholesky factor L (n-by-n, row-major, strictly upper
+ * part set to zero) of the symmetric matrix A. A zero pivot gives a zero
+ * column, so the semidefinite matrices (e.g. process noise acting on only
+ * some states) are accepted. A pivot within n*eps*A[j][j] of zero is the
+ * rounding error of a singular A and taken as zero. Return false if A is
+ * not nonnegative definite.
+ */
+template <typename Type>
+bool lowerCholesky( int n, const Type *A, Type *L )
+{
+    for( int j=0; j<n; ++j )
+    {
+        Type d = A[j*n+j],
+             tol = n * std::numeric_limits<Type>::epsilon() * abs(d);
+        for( int k=0; k<j; ++k )
+            d -= L[j*n+k] * L[j*n+k];
+        if( d < -tol )
+            return false;
+        d = ( d > tol ) ? sqrt(d) : Type(0);
+        L[j*n+j] = d;
+
+        for( int i=j+1; i<n; ++i )
+        {
+            Type sum = A[i*n+j];
+            for( int k=0; k<j; ++k )
+                sum -= L[i*n+k] * L[j*n+k];
+            L[i*n+j] = ( d > 0 ) ? sum/d : Type(0);
+        }
+        for( int i=0; i<j; ++i )
+            L[i*n+j] = 0;
+    }
+
+    return true;
+}
+
+
+/**
+ * Triangularize the m-by-n (m <= n) row-major array A in place by Householder
+ * reflections applied from the right, A ---> [L 0] with L lower triangular
+ * and positive diagonal. The reflector of the ith row only touches columns
+ * i to n-1, so the rows are updated over contiguous memory.
+ */
+template <typename Type>
+void lqTriangularize( int m, int n, Type *A )
+{
+    for( int i=0; i<m; ++i )
+    {
+        Type *ai = A + i*n;
+
+        Type nrm = 0;
+        for( int k=i; k<n; ++k )
+            nrm += ai[k]*ai[k];
+        nrm = sqrt(nrm);
+
+        if( nrm == 0 )
+            continue;
+
+        // v = a - alpha*e1, with alpha of the opposite sign of a[i]
+        Type alpha = ( ai[i] > 0 ) ? -nrm : nrm;
+        ai[i] -= alpha;
+        Type beta = 1 / ( nrm*abs(ai[i]) );
+
+        // apply I - beta*v*v' to the rows below
+        for( int r=i+1; r<m; ++r )
+        {
+            Type *ar = A + r*n;
+            Type s = 0;
+            for( int k=i; k<n; ++k )
+                s += ar[k]*ai[k];
+            s *= beta;
+            for( int k=i; k<n; ++k )
+                ar[k] -= s*ai[k];
+        }
+
+        // row i becomes [alpha 0 ... 0], keep the diagonal positive
+        Type sign = ( alpha > 0 ) ? Type(1) : Type(-1);
+        ai[i] = sign*alpha;
+        for( int k=i+1; k<n; ++k )
+            ai[k] = 0;
+        for( int r=i+1; r<m; ++r )
+            A[r*n+i] *= sign;
+    }
+}
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type>
+SRKalmanFilter<Type>::SRKalmanFilter()
+{
+}
+
+template <typename Type>
+SRKalmanFilter<Type>::~SRKalmanFilter()
+{
+}
+
+
+/**
+ * Initialize the state vector and its covariance matrix.
+ */
+template <typename Type>
+void SRKalmanFilter<Type>::init( const Vector<Type> &x0,
+                                 const Matrix<Type> &P0 )
+{
+    int n = x0.size();
+    assert( P0.rows() == n && P0.cols() == n );
+
+    x = x0;
+    S.resize( n, n );
+    if( !lowerCholesky( n, (const Type*)P0, (Type*)S ) )
+        cerr << "The initial covariance matrix is not positive definite!"
+             << endl;
+}
+
+
+/**
+ * Make sure the work space has at least "len" elements.
+ */
+template <typename Type>
+inline void SRKalmanFilter<Type>::reserve( int len )
+{
+    if( work.size() < len )
+        work.resize(len);
+}
+
+
+/**
+ * Prediction by the system matrix "A" and the process noise covariance "Q".
+ * Return false if Q is not nonnegative definite.
+ */
+template <typename Type>
+bool SRKalmanFilter<Type>::predict( const Matrix<Type> &A,
+                                    const Matrix<Type> &Q )
+{
+    int n = x.size();
+    assert( A.rows() == n && A.cols() == n );
+    assert( Q.rows() == n && Q.cols() == n );
+
+    reserve( 3*n*n );
+    Type *Qs = &work[2*n*n];
+    if( !lowerCholesky( n, (const Type*)Q, Qs ) )
+        return false;
+
+    predictArray( A, Qs );
+    return true;
+}
+
+
+/**
+ * Prediction by the system matrix "A" and a square root "Qs" of the process
+ * noise covariance, Q = Qs*Qs', e.g. computed once for a constant Q.
+ */
+template <typename Type>
+void SRKalmanFilter<Type>::predictSqrt( const Matrix<Type> &A,
+                                        const Matrix<Type> &Qs )
+{
+    int n = x.size();
+    assert( A.rows() == n && A.cols() == n );
+    assert( Qs.rows() == n && Qs.cols() == n );
+
+    reserve( 2*n*n );
+    predictArray( A, (const Type*)Qs );
+}
+
+
+/**
+ * Triangularize the prediction pre-array [A*S Qs], the work space holds at
+ * least 2*n*n elements.
+ */
+template <typename Type>
+void SRKalmanFilter<Type>::predictArray( const Matrix<Type> &A,
+                                         const Type *Qs )
+{
+    int n = x.size(),
+        n2 = 2*n;
+    Type *M = &work[0];
+
+    // x = A*x, using the first row of the pre-array as temporary
+    for( int i=0; i<n; ++i )
+    {
+        Type sum = 0;
+        for( int k=0; k<n; ++k )
+            sum += A[i][k] * x[k];
+        M[i] = sum;
+    }
+    for( int i=0; i<n; ++i )
+        x[i] = M[i];
+
+    // pre-array [A*S sqrt(Q)], S is lower triangular
+    for( int i=0; i<n; ++i )
+    {
+        Type *mi = M + i*n2;
+        for( int j=0; j<n; ++j )
+        {
+            Type sum = 0;
+            for( int k=j; k<n; ++k )
+                sum += A[i][k] * S[k][j];
+            mi[j] = sum;
+        }
+        for( int j=0; j<n; ++j )
+            mi[n+j] = Qs[i*n+j];
+    }
+
+    lqTriangularize( n, n2, M );
+
+    for( int i=0; i<n; ++i )
+        for( int j=0; j<n; ++j )
+            S[i][j] = M[i*n2+j];
+}
+
+
+/**
+ * Correction by the measurement "y", the measurement matrix "C" and the
+ * measurement noise covariance "R". Return false if R is not positive
+ * definite.
+ */
+template <typename Type>
+bool SRKalmanFilter<Type>::correct( const Matrix<Type> &C,
+                                    const Matrix<Type> &R, const Type *y )
+{
+    int n = x.size(),
+        m = C.rows(),
+        l = m+n;
+    assert( C.cols() == n );
+    assert( R.rows() == m && R.cols() == m );
+
+    reserve( l*l + m + m*m );
+    Type *Rs = &work[l*l+m];
+    if( !lowerCholesky( m, (const Type*)R, Rs ) )
+        return false;
+
+    return correctArray( C, Rs, y );
+}
+
+
+/**
+ * Correction by the measurement "y", the measurement matrix "C" and the
+ * lower triangular Cholesky factor "Rs" of the measurement noise
+ * covariance, R = Rs*Rs'. Return false if Rs is singular.
+ */
+template <typename Type>
+bool SRKalmanFilter<Type>::correctSqrt( const Matrix<Type> &C,
+                                        const Matrix<Type> &Rs,
+                                        const Type *y )
+{
+    int n = x.size(),
+        m = C.rows(),
+        l = m+n;
+    assert( C.cols() == n );
+    assert( Rs.rows() == m && Rs.cols() == m );
+
+    reserve( l*l + m );
+    return correctArray( C, (const Type*)Rs, y );
+}
+
+template <typename Type>
+inline bool SRKalmanFilter<Type>::correctSqrt( const Matrix<Type> &C,
+                                               const Matrix<Type> &Rs,
+                                               const Vector<Type> &y )
+{
+    assert( y.size() == C.rows() );
+    return correctSqrt( C, Rs, &y[0] );
+}
+
+
+/**
+ * Triangularize the correction pre-array [Rs C*S; 0 S] and correct the
+ * state, the work space holds at least (m+n)*(m+n)+m elements.
+ */
+template <typename Type>
+bool SRKalmanFilter<Type>::correctArray( const Matrix<Type> &C,
+                                         const Type *Rs, const Type *y )
+{
+    int n = x.size(),
+        m = C.rows(),
+        l = m+n;
+    Type *M = &work[0],
+         *z = M + l*l;
+
+    for( int i=0; i<m; ++i )
+        if( Rs[i*m+i] == 0 )
+            return false;
+
+    // pre-array [ sqrt(R) C*S; 0 S ]
+    for( int i=0; i<m; ++i )
+    {
+        Type *mi = M + i*l;
+        for( int j=0; j<m; ++j )
+            mi[j] = Rs[i*m+j];
+        for( int j=0; j<n; ++j )
+        {
+            Type sum = 0;
+            for( int k=j; k<n; ++k )
+                sum += C[i][k] * S[k][j];
+            mi[m+j] = sum;
+        }
+    }
+    for( int i=0; i<n; ++i )
+    {
+        Type *mi = M + (m+i)*l;
+        for( int j=0; j<m; ++j )
+            mi[j] = 0;
+        for( int j=0; j<n; ++j )
+            mi[m+j] = S[i][j];
+    }
+
+    lqTriangularize( l, l, M );
+
+    // z = inv(Sy) * (y-C*x)
+    for( int i=0; i<m; ++i )
+    {
+        Type sum = y[i];
+        for( int k=0; k<n; ++k )
+            sum -= C[i][k] * x[k];
+        for( int k=0; k<i; ++k )
+            sum -= M[i*l+k] * z[k];
+        z[i] = sum / M[i*l+i];
+    }
+
+    // x = x + Kb*z, and the new factor
+    for( int i=0; i<n; ++i )
+    {
+        const Type *mi = M + (m+i)*l;
+        Type sum = 0;
+        for( int k=0; k<m; ++k )
+            sum += mi[k] * z[k];
+        x[i] += sum;
+
+        for( int j=0; j<n; ++j )
+            S[i][j] = mi[m+j];
+    }
+
+    return true;
+}
+
+template <typename Type>
+inline bool SRKalmanFilter<Type>::correct( const Matrix<Type> &C,
+                                           const Matrix<Type> &R,
+                                           const Vector<Type> &y )
+{
+    assert( y.size() == C.rows() );
+    return correct( C, R, &y[0] );
+}
+
+
+/**
+ * Get the state dimension, state vector, the covariance factor and the
+ * covariance matrix.
+ */
+template <typename Type>
+inline int SRKalmanFilter<Type>::dim() const
+{
+    return x.size();
+}
+
+template <typename Type>
+inline Vector<Type> SRKalmanFilter<Type>::getState() const
+{
+    return x;
+}
+
+template <typename Type>
+inline Matrix<Type> SRKalmanFilter<Type>::getSqrtCovariance() const
+{
+    return S;
+}
+
+template <typename Type>
+inline Matrix<Type> SRKalmanFilter<Type>::getCovariance() const
+{
+    return multTr( S, S );
+}
+
+
+/**
+ * One predict-correct step for K filters sharing the same model, the kth
+ * row of "Y" is the measurement of the kth filter. Q and R are factorized
+ * once for all filters, which are processed in parallel if OpenMP is
+ * enabled. Return the number of filters whose step failed (all of them if
+ * Q or R is not definite), if "ok" is given, ok[k] is set to the result of
+ * the kth filter.
+ */
+template <typename Type>
+int srKalmanBatch( SRKalmanFilter<Type> *filters, int K,
+                   const Matrix<Type> &A, const Matrix<Type> &C,
+                   const Matrix<Type> &Q, const Matrix<Type> &R,
+                   const Matrix<Type> &Y, bool *ok )
+{
+    int n = Q.rows(),
+        m = R.rows();
+    assert( Y.rows() == K );
+    assert( Q.cols() == n && R.cols() == m );
+
+    Matrix<Type> Qs( n, n ),
+                 Rs( m, m );
+    if( !lowerCholesky( n, (const Type*)Q, (Type*)Qs ) ||
+        !lowerCholesky( m, (const Type*)R, (Type*)Rs ) )
+    {
+        if( ok )
+            for( int k=0; k<K; ++k )
+                ok[k] = false;
+        return K;
+    }
+
+    int fails = 0;
+
+    #pragma omp parallel for reduction(+:fails)
+    for( int k=0; k<K; ++k )
+    {
+        filters[k].predictSqrt( A, Qs );
+        bool good = filters[k].correctSqrt( C, Rs, Y[k] );
+        if( ok )
+            ok[k] = good;
+        if( !good )
+            ++fails;
+    }
+
+    return fails;
+}
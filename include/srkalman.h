@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 srkalman.h
+ *
+ * Square-Root Kalman Filter.
+ *
+ * The covariance form of the Kalman filter loses the symmetry and positive
+ * definiteness of the covariance matrix by rounding errors during a long
+ * run, especially in single precision. The square-root filter propagates
+ * the lower triangular Cholesky factor S of the covariance, P = S*S',
+ * instead of P itself, so P is always symmetric and nonnegative definite,
+ * and the condition number of S is the square root of that of P, which
+ * halves the precision needed (float becomes usable in most cases).
+ *
+ * Both steps are done in the "array" form: a pre-array built from the
+ * factors is triangularized by an orthogonal transformation from the right
+ * (a LQ decomposition by Householder reflections on the rows),
+ *      prediction :  [ A*S  sqrt(Q) ] ---> [ S  0 ]
+ *      correction :  [ sqrt(R)  C*S ]      [ Sy  0 ]
+ *                    [   0       S  ] ---> [ Kb  S ]
+ * and the state is corrected by x = x + Kb*inv(Sy)*(y-C*x). The pre-arrays
+ * are stored in a work space allocated once, so no memory allocation is
+ * needed for each step. "predict" and "correct" factorize Q and R at each
+ * call, which costs O(n^3); when the noise covariances are constant their
+ * factors can be computed once and given to "predictSqrt" and
+ * "correctSqrt". "srKalmanBatch" updates a group of filters sharing the
+ * same model in parallel, factorizing Q and R once per step.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef SRKALMAN_H
+#define SRKALMAN_H
+
+
+#include <limits>
+#include <vector.h>
+#include <matrix.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class SRKalmanFilter
+    {
+
+    public:
+
+        SRKalmanFilter();
+        ~SRKalmanFilter();
+
+        void init( const Vector<Type> &x0, const Matrix<Type> &P0 );
+
+        bool predict( const Matrix<Type> &A, const Matrix<Type> &Q );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Type *y );
+        bool correct( const Matrix<Type> &C, const Matrix<Type> &R,
+                      const Vector<Type> &y );
+
+        void predictSqrt( const Matrix<Type> &A, const Matrix<Type> &Qs );
+        bool correctSqrt( const Matrix<Type> &C, const Matrix<Type> &Rs,
+                          const Type *y );
+        bool correctSqrt( const Matrix<Type> &C, const Matrix<Type> &Rs,
+                          const Vector<Type> &y );
+
+        int dim() const;
+        Vector<Type> getState() const;
+        Matrix<Type> getSqrtCovariance() const;
+        Matrix<Type> getCovariance() const;
+
+    private:
+
+        // state vector and the lower triangular factor of its covariance
+        Vector<Type> x;
+        Matrix<Type> S;
+
+        // work space for the pre-arrays
+        Vector<Type> work;
+
+        void reserve( int len );
+        void predictArray( const Matrix<Type> &A, const Type *Qs );
+        bool correctArray( const Matrix<Type> &C, const Type *Rs,
+                           const Type *y );
+
+    };
+    // class SRKalmanFilter
+
+
+    template<typename Type>
+    int srKalmanBatch( SRKalmanFilter<Type>*, int,
+                       const Matrix<Type>&, const Matrix<Type>&,
+                       const Matrix<Type>&, const Matrix<Type>&,
+                       const Matrix<Type>&, bool *ok=0 );
+
+    template<typename Type>
+    static bool lowerCholesky( int, const Type*, Type* );
+    template<typename Type>
+    static void lqTriangularize( int, int, Type* );
+
+
+    #include <srkalman-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// SRKALMAN_H
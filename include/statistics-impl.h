@@ -33,28 +33,155 @@
 
 
 /**
- * Get the median value of a sequence.
+ * Get the median value of a sequence, the lower one of the two middle
+ * values if the length is even.
  */
 template <typename Type>
 Type mid( const Vector<Type> &v )
 {
     Vector<Type> tmp(v);
-    int index,
-        N = tmp.size(),
-        K = N/2;
+    int K = (tmp.size()-1) / 2;
 
-    for( int k=0; k<=K; ++k )
+    quickSelect( tmp, 0, tmp.size()-1, K );
+
+    return tmp[K];
+}
+
+
+/**
+ * Median of a sequence, the mean of the two middle values if the length
+ * is even.
+ */
+template <typename Type>
+inline Type median( const Vector<Type> &v )
+{
+    return quantile( v, Type(0.5) );
+}
+
+
+/**
+ * The p-quantile (0 <= p <= 1) of a sequence.
+ */
+template <typename Type>
+inline Type quantile( const Vector<Type> &v, const Type &p )
+{
+    Vector<Type> tmp(v);
+    return quantileInPlace( tmp, p );
+}
+
+template <typename Type>
+inline Vector<Type> quantile( const Vector<Type> &v, const Vector<Type> &p )
+{
+    Vector<Type> tmp(v);
+    return quantileInPlace( tmp, p );
+}
+
+
+/**
+ * The p-percentile (0 <= p <= 100) of a sequence.
+ */
+template <typename Type>
+inline Type percentile( const Vector<Type> &v, const Type &p )
+{
+    return quantile( v, p/100 );
+}
+
+template <typename Type>
+inline Vector<Type> percentile( const Vector<Type> &v, const Vector<Type> &p )
+{
+    return quantile( v, p/Type(100) );
+}
+
+
+/**
+ * The p-quantile of a sequence, which is reordered.
+ */
+template <typename Type>
+Type quantileInPlace( Vector<Type> &v, const Type &p )
+{
+    assert( v.size() > 0 );
+    assert( Type(0) <= p && p <= Type(1) );
+
+    int N = v.size();
+    Type h = (N-1)*p;
+    int k = int(h);
+    if( k > N-2 )
+        k = max( N-2, 0 );
+
+    quickSelect( v, 0, N-1, k );
+    Type xk = v[k];
+    if( k == N-1 )
+        return xk;
+
+    // the next order statistic is the minimum of the right part
+    Type xk1 = v[k+1];
+    for( int i=k+2; i<N; ++i )
+        if( v[i] < xk1 )
+            xk1 = v[i];
+
+    return xk + (h-k)*(xk1-xk);
+}
+
+
+/**
+ * The quantiles of a vector of probabilities, the sequence is reordered.
+ */
+template <typename Type>
+Vector<Type> quantileInPlace( Vector<Type> &v, const Vector<Type> &p )
+{
+    assert( v.size() > 0 );
+
+    int N = v.size(),
+        M = p.size();
+
+    // the needed ranks in ascending order without repetition
+    Vector<int> ranks(2*M);
+    for( int i=0; i<M; ++i )
     {
-        index = k;
-        for( int i=k+1; i<N; ++i )
-            if( tmp[index] < tmp[i] )
-                index = i;
+        assert( Type(0) <= p[i] && p[i] <= Type(1) );
+        int k = int( (N-1)*p[i] );
+        ranks[2*i] = k;
+        ranks[2*i+1] = min( k+1, N-1 );
+    }
+    insertSort( ranks, 0, 2*M-1 );
 
-        if( index != k )
-            swap( tmp[index], tmp[k] );
+    int R = 0;
+    for( int i=0; i<2*M; ++i )
+        if( R == 0 || ranks[i] != ranks[R-1] )
+            ranks[R++] = ranks[i];
+
+    multiSelect( v, 0, N-1, ranks, 0, R-1 );
+
+    Vector<Type> q(M);
+    for( int i=0; i<M; ++i )
+    {
+        Type h = (N-1)*p[i];
+        int k = int(h);
+        q[i] = ( k < N-1 ) ? v[k] + (h-k)*(v[k+1]-v[k]) : v[k];
     }
 
-    return tmp[K];
+    return q;
+}
+
+
+/**
+ * Place the elements of ranks[r0], ..., ranks[r1] of a[left], ...,
+ * a[right] in their sorted places. The middle rank is selected at first,
+ * and then the two sides are done separately.
+ */
+template <typename Type>
+void multiSelect( Vector<Type> &a, int left, int right,
+                  const Vector<int> &ranks, int r0, int r1 )
+{
+    if( r0 > r1 || left >= right )
+        return;
+
+    int rm = (r0+r1) / 2,
+        k = ranks[rm];
+    quickSelect( a, left, right, k );
+
+    multiSelect( a, left, k-1, ranks, r0, rm-1 );
+    multiSelect( a, k+1, right, ranks, rm+1, r1 );
 }
 
 
@@ -166,52 +293,35 @@ template <typename Type>
 Vector<Type> pdf( Vector<Type> &xn, const Type lambda )
 {
     int i, k,
-        tmpInt,
-        Lpx,
+        pMin, pMax,
         Lx = xn.size();
 
-    Type tmpDbl,
+    Type r,
          kb = Type( lambda * 2.107683*stdVar(xn)/pow(Lx, 0.2) );
 
-    Vector<Type> r(Lx);
-    Vector<int>  pos(Lx),
-                 index(Lx);
-
-    // binning the data into blocks, each block width is "kb"
-    for( i=0; i<Lx; ++i )
+    // the range of blocks, each block width is "kb"
+    pMin = pMax = int( xn[0]/kb );
+    for( i=1; i<Lx; ++i )
     {
-        tmpDbl = xn[i] / kb;
-        pos[i] = int(tmpDbl);
-        r[i] = tmpDbl - pos[i];
+        k = int( xn[i]/kb );
+        if( k < pMin )
+            pMin = k;
+        else if( k > pMax )
+            pMax = k;
     }
 
-    // compute the blocks index
-    tmpInt = 1 - min(pos);
-    for( i=0; i<Lx; ++i )
-        index[i] = pos[i]+tmpInt;
-
-    // weights for left, middle and right block
-    Vector<Type> weightl(Lx),
-                 weightc(Lx),
-                 weightr(Lx);
-    for( i=0; i<Lx; ++i )
-    {
-        tmpDbl = r[i];
-        weightl[i] = (1-tmpDbl)*(1-tmpDbl) / Type(2.0);
-        weightc[i] = Type(0.5) + tmpDbl*(1-tmpDbl);
-        weightr[i] = tmpDbl*tmpDbl / Type(2.0);
-    }
-
-    Lpx = max(index) - min(index) + 3;
-    Vector<Type> px(Lpx);
-
-    // compute probability density function
+    // distribute each sample into the left, middle and right blocks
+    Vector<Type> px( pMax-pMin+3 );
     for( i=0; i<Lx; ++i )
     {
-        k = index[i];
-        px[k-1] += weightl[i] / Lx ;
-        px[k]   += weightc[i] / Lx ;
-        px[k+1] += weightr[i] / Lx ;
+        r = xn[i] / kb;
+        k = int(r);
+        r -= k;
+        k += 1 - pMin;
+
+        px[k-1] += (1-r)*(1-r) / (2*Lx);
+        px[k]   += (Type(0.5)+r*(1-r)) / Lx;
+        px[k+1] += r*r / (2*Lx);
     }
 
     return px;
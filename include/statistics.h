@@ -30,6 +30,16 @@
  * median, mean, variance, standard variance, skew, kurtosis and the
  * PDF(probability density function).
  *
+ * The median and quantiles are found by selection (see "quickSelect" in
+ * "sort.h") in expected linear time. "quantile" interpolates linearly
+ * between the order statistics, i.e. the p-quantile of x(0) <= ... <=
+ * x(N-1) is x(h) at h = (N-1)*p, and "median" is the 0.5-quantile, while
+ * "mid" returns the lower one of the two middle samples for even N. The
+ * quantiles of a vector of probabilities are selected together, each
+ * selection works only on the part between the neighbouring selected
+ * ranks. The routines ending with "InPlace" reorder the given vector
+ * instead of copying it.
+ *
  * Zhang Ming, 2010-03, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -39,12 +49,25 @@
 
 
 #include <vector.h>
+#include <sort.h>
 
 
 namespace splab
 {
 
     template<typename Type> Type mid( const Vector<Type>& );
+    template<typename Type> Type median( const Vector<Type>& );
+    template<typename Type> Type quantile( const Vector<Type>&, const Type& );
+    template<typename Type> Vector<Type> quantile( const Vector<Type>&,
+                                                   const Vector<Type>& );
+    template<typename Type> Type percentile( const Vector<Type>&,
+                                             const Type& );
+    template<typename Type> Vector<Type> percentile( const Vector<Type>&,
+                                                     const Vector<Type>& );
+    template<typename Type> Type quantileInPlace( Vector<Type>&,
+                                                  const Type& );
+    template<typename Type> Vector<Type> quantileInPlace( Vector<Type>&,
+                                                          const Vector<Type>& );
     template<typename Type> Type mean( const Vector<Type>& );
 
     template<typename Type> Type var( const Vector<Type>& );
@@ -57,6 +80,10 @@ namespace splab
     template<typename Type> Vector<Type> pdf( Vector<Type>&,
                                               const Type lambda=Type(1.0) );
 
+    template<typename Type> static void multiSelect( Vector<Type>&, int, int,
+                                                     const Vector<int>&,
+                                                     int, int );
+
 
     #include <statistics-impl.h>
 
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              streampse-impl.h
+ *
+ * Implementation for StreamPSE class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructor and destructor
+ * wn       : window function, the segment length is wn.size()
+ * K        : the step between two adjacent segments
+ * L        : the number of power spectrum density samples, L >= wn.size()
+ * a        : 0 for rectangular averaging, or the weight of the newest
+ *            segment (0 < alpha <= 1) for exponential averaging
+ */
+template <typename Type>
+StreamPSE<Type>::StreamPSE( const Vector<Type> &wn, int K, int L,
+                            const Type &a )
+: win(wn), step(K), nFFT(L), alpha(a),
+  pending(wn.size()), avgPow(L), partPow(PARTS,L)
+{
+    assert( K > 0 );
+    assert( L >= wn.size() );
+    assert( Type(0) <= a && a <= Type(1) );
+
+    partBuf.resize( PARTS );
+    partXk.resize( PARTS );
+    partMR.resize( PARTS );
+    partPF.resize( PARTS );
+    for( int p=0; p<PARTS; ++p )
+    {
+        partBuf[p].resize( L );
+        partXk[p].resize( L );
+    }
+
+    winPow = sum( wn*wn );
+    reset();
+}
+
+template <typename Type>
+StreamPSE<Type>::~StreamPSE()
+{
+}
+
+
+/**
+ * Discard all the samples and estimations.
+ */
+template <typename Type>
+void StreamPSE<Type>::reset()
+{
+    nPending = 0;
+    nSkip = 0;
+    nSegs = 0;
+    avgPow = Type(0);
+}
+
+
+/**
+ * Input a new block of signal "xn", the block size is arbitrary.
+ */
+template <typename Type>
+void StreamPSE<Type>::input( const Vector<Type> &xn )
+{
+    int M = win.size(),
+        N = xn.size();
+
+    // samples between two segments
+    if( nSkip >= N )
+    {
+        nSkip -= N;
+        return;
+    }
+
+    int first = nSkip,
+        total = nPending+N-first;
+    nSkip = 0;
+
+    if( total < M )
+    {
+        for( int i=first; i<N; ++i )
+            pending[nPending++] = xn[i];
+        return;
+    }
+
+    // periodograms of all complete segments of the unfinished segment
+    // joined with the new block, the ith sample of which is pending[i] for
+    // i < nPending, and xn[first+i-nPending] otherwise
+    int S = (total-M)/step + 1,
+        P = ( S < PARTS ) ? S : PARTS;
+    const Type *xs = &xn[first];
+
+    #pragma omp parallel for
+    for( int p=0; p<P; ++p )
+    {
+        int s0 = S*p/P,
+            s1 = S*(p+1)/P;
+        Type *ps = partPow[p];
+        for( int k=0; k<nFFT; ++k )
+            ps[k] = 0;
+
+        // in time order: the sum, or the exponential average started
+        // from zero
+        for( int s=s0; s<s1; ++s )
+        {
+            periodogram( s*step, xs, p );
+            const Type *pn = partBuf[p].begin();
+            if( alpha == Type(0) || ( nSegs == 0 && s == 0 ) )
+                for( int k=0; k<nFFT; ++k )
+                    ps[k] += pn[k];
+            else
+                for( int k=0; k<nFFT; ++k )
+                    ps[k] += alpha * ( pn[k]-ps[k] );
+        }
+    }
+
+    // merging in time order
+    for( int p=0; p<P; ++p )
+    {
+        int n = S*(p+1)/P - S*p/P;
+        const Type *ps = partPow[p];
+        if( alpha == Type(0) )
+            for( int k=0; k<nFFT; ++k )
+                avgPow[k] += ps[k];
+        else
+        {
+            Type decay = pow( 1-alpha, Type(n) );
+            for( int k=0; k<nFFT; ++k )
+                avgPow[k] = decay*avgPow[k] + ps[k];
+        }
+    }
+    nSegs += S;
+
+    // keep the samples of the next unfinished segment, the pending samples
+    // are moved forward
+    int next = S*step;
+    if( next >= total )
+    {
+        nPending = 0;
+        nSkip = next-total;
+    }
+    else
+    {
+        int n = total-next;
+        for( int i=0; i<n; ++i )
+        {
+            int j = next+i;
+            pending[i] = ( j < nPending ) ? pending[j] : xs[j-nPending];
+        }
+        nPending = n;
+    }
+}
+
+
+/**
+ * Return the number of segments that have been averaged.
+ */
+template <typename Type>
+inline int StreamPSE<Type>::segments() const
+{
+    return nSegs;
+}
+
+
+/**
+ * Return the current spectral estimates at L frequencies:
+ * w = 0, 2*pi/L, ..., 2*pi(L-1)/L
+ * For rectangular averaging, this is the same as "welchPSE" of all the
+ * input samples.
+ */
+template <typename Type>
+Vector<Type> StreamPSE<Type>::getPSD() const
+{
+    if( nSegs == 0 )
+        return Vector<Type>(nFFT);
+
+    if( alpha == Type(0) )
+        return avgPow / (nSegs*winPow);
+    else
+        return avgPow / winPow;
+}
+
+
+/**
+ * Squared magnitude of the FFT of the windowed segment started at the
+ * "start"th sample of the joined signal (see "input"), whose samples
+ * after the pending ones are xs[0], xs[1], ..., computed with the buffers
+ * of the pth part and returned in partBuf[p].
+ */
+template <typename Type>
+void StreamPSE<Type>::periodogram( int start, const Type *xs, int p )
+{
+    int M = win.size();
+    Vector<Type> &buf = partBuf[p];
+    Vector< complex<Type> > &Xk = partXk[p];
+
+    for( int i=0; i<M; ++i )
+    {
+        int j = start+i;
+        buf[i] = win[i] * ( ( j < nPending ) ? pending[j]
+                                             : xs[j-nPending] );
+    }
+    for( int i=M; i<nFFT; ++i )
+        buf[i] = 0;
+
+    if( isPower2(nFFT) )
+        partMR[p].fft( buf, Xk );
+    else
+        partPF[p].fft( buf, Xk );
+
+    for( int k=0; k<nFFT; ++k )
+        buf[k] = norm( Xk[k] );
+}
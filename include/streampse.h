@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 streampse.h
+ *
+ * Streaming Welch (and Bartlett) power spectrum estimator.
+ *
+ * Unlike "welchPSE" and "bartlettPSE" in "classicalpse.h", which need the
+ * whole signal, this class accepts the signal block by block, and the block
+ * can be of arbitrary size. The samples of an unfinished segment are kept
+ * inside the object, so the segments overlap across the blocks exactly as
+ * they do in the whole signal. The windowed periodograms of the segments are
+ * averaged rectangularly (the same result as "welchPSE") or exponentially
+ * (for tracking slowly varying spectrum), and the current estimation can be
+ * got at any moment.
+ *
+ * The Bartlett estimator is obtained by a rectangle window with the segment
+ * step equal to the window length. The segments of a block are split into
+ * at most PARTS parts of consecutive segments, and the periodograms of each
+ * part are added in place into its own running sum, which are computed in
+ * parallel if OpenMP is enabled and merged in time order, so the result
+ * does not depend on the number of threads. The buffers of the parts are
+ * kept in the object, so "input" allocates no memory.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef STREAMPSE_H
+#define STREAMPSE_H
+
+
+#include <vector.h>
+#include <matrix.h>
+#include <fft.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class StreamPSE
+    {
+
+    public:
+
+        StreamPSE( const Vector<Type> &wn, int K, int L,
+                   const Type &alpha=Type(0) );
+        ~StreamPSE();
+
+        void reset();
+        void input( const Vector<Type> &xn );
+
+        int segments() const;
+        Vector<Type> getPSD() const;
+
+    private:
+
+        static const int PARTS = 8;
+
+        // window, segment step and FFT points
+        Vector<Type> win;
+        int step;
+        int nFFT;
+
+        // exponential averaging factor, 0 means rectangular averaging
+        Type alpha;
+
+        // window power
+        Type winPow;
+
+        // samples of the unfinished segment, and the number of samples to
+        // be skipped before the next segment if step > window length
+        Vector<Type> pending;
+        int nPending;
+        int nSkip;
+
+        // averaged periodogram and the number of averaged segments
+        Vector<Type> avgPow;
+        int nSegs;
+
+        // running sums, windowed segments, spectra and FFT objects of the
+        // parts
+        Matrix<Type> partPow;
+        Vector< Vector<Type> > partBuf;
+        Vector< Vector< complex<Type> > > partXk;
+        Vector< FFTMR<Type> > partMR;
+        Vector< FFTPF<Type> > partPF;
+
+        void periodogram( int start, const Type *xn, int p );
+
+    };
+    // class StreamPSE
+
+
+    #include <streampse-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// STREAMPSE_H
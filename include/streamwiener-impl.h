@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                             streamwiener-impl.h
+ *
+ * Implementation for StreamWiener class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * order    : the order of Wiener filter (p+1 coefficients)
+ * a        : forgetting factor, 0 < a <= 1, used if there's no window
+ * L        : sliding window length, 0 means exponential window
+ */
+template <typename Type>
+StreamWiener<Type>::StreamWiener( int order, const Type &a, int L )
+: p(order), lambda(a), W(L),
+  xBuf(L+order+1), dBuf(L+1), rxx(order+1), rdx(order+1), wgt(order+1),
+  work(2*(order+1)), Thn(order+1), T( Vector<Type>(order+1,Type(1)) )
+{
+    assert( order >= 0 );
+    assert( L >= 0 );
+    assert( Type(0) < a && a <= Type(1) );
+
+    reset();
+}
+
+template <typename Type>
+StreamWiener<Type>::~StreamWiener()
+{
+}
+
+
+/**
+ * Clear the histories and the correlation lags.
+ */
+template <typename Type>
+void StreamWiener<Type>::reset()
+{
+    xBuf = Type(0);
+    dBuf = Type(0);
+    xPos = 0;
+    dPos = 0;
+    nAvail = 0;
+    nRefresh = 0;
+
+    rxx = Type(0);
+    rdx = Type(0);
+    wgt = Type(0);
+    hn.resize(0);
+}
+
+
+/**
+ * Get the input and desired samples k steps ago.
+ */
+template <typename Type>
+inline Type StreamWiener<Type>::xAt( int k ) const
+{
+    int i = xPos - k;
+    return ( i < 0 ) ? xBuf[i+xBuf.size()] : xBuf[i];
+}
+
+template <typename Type>
+inline Type StreamWiener<Type>::dAt( int k ) const
+{
+    int i = dPos - k;
+    return ( i < 0 ) ? dBuf[i+dBuf.size()] : dBuf[i];
+}
+
+
+/**
+ * Input one sample of x(n) and d(n). Only the auto-correlation is needed
+ * by the predictor, so d(n) can be omitted.
+ */
+template <typename Type>
+void StreamWiener<Type>::input( const Type &x, const Type &d )
+{
+    if( ++xPos == xBuf.size() )
+        xPos = 0;
+    if( ++dPos == dBuf.size() )
+        dPos = 0;
+    xBuf[xPos] = x;
+    dBuf[dPos] = d;
+    if( nAvail < xBuf.size() )
+        nAvail++;
+
+    int kMax = min( p, nAvail-1 );
+
+    if( W == 0 )
+    {
+        for( int k=0; k<=p; ++k )
+        {
+            rxx[k] *= lambda;
+            rdx[k] *= lambda;
+            wgt[k] *= lambda;
+        }
+        for( int k=0; k<=kMax; ++k )
+        {
+            Type xk = xAt(k);
+            rxx[k] += x*xk;
+            rdx[k] += d*xk;
+            wgt[k] += 1;
+        }
+    }
+    else
+    {
+        for( int k=0; k<=kMax; ++k )
+        {
+            Type xk = xAt(k);
+            rxx[k] += x*xk;
+            rdx[k] += d*xk;
+            wgt[k] += 1;
+        }
+
+        // remove the products of the sample W steps ago
+        Type xOld = xAt(W),
+             dOld = dAt(W);
+        kMax = min( p, nAvail-1-W );
+        for( int k=0; k<=kMax; ++k )
+        {
+            Type xk = xAt(W+k);
+            rxx[k] -= xOld*xk;
+            rdx[k] -= dOld*xk;
+            wgt[k] -= 1;
+        }
+
+        if( ++nRefresh == W )
+            refresh();
+    }
+}
+
+
+/**
+ * Input a block of samples.
+ */
+template <typename Type>
+void StreamWiener<Type>::input( const Vector<Type> &xn,
+                                const Vector<Type> &dn )
+{
+    assert( xn.size() == dn.size() );
+
+    for( int i=0; i<xn.size(); ++i )
+        input( xn[i], dn[i] );
+}
+
+template <typename Type>
+void StreamWiener<Type>::input( const Vector<Type> &xn )
+{
+    for( int i=0; i<xn.size(); ++i )
+        input( xn[i] );
+}
+
+
+/**
+ * Recompute the sliding window lags from the histories.
+ */
+template <typename Type>
+void StreamWiener<Type>::refresh()
+{
+    rxx = Type(0);
+    rdx = Type(0);
+    wgt = Type(0);
+
+    int jMax = min( W, nAvail );
+    for( int j=0; j<jMax; ++j )
+    {
+        Type xj = xAt(j),
+             dj = dAt(j);
+        int kMax = min( p, nAvail-1-j );
+        for( int k=0; k<=kMax; ++k )
+        {
+            Type xk = xAt(j+k);
+            rxx[k] += xj*xk;
+            rdx[k] += dj*xk;
+            wgt[k] += 1;
+        }
+    }
+
+    nRefresh = 0;
+}
+
+
+/**
+ * Get the order of the filter.
+ */
+template <typename Type>
+inline int StreamWiener<Type>::order() const
+{
+    return p;
+}
+
+
+/**
+ * Get the normalized auto-correlation r(0), ..., r(p) and
+ * cross-correlation of the current window.
+ */
+template <typename Type>
+Vector<Type> StreamWiener<Type>::getAutoCorr() const
+{
+    Vector<Type> rn(p+1);
+    for( int k=0; k<=p; ++k )
+        if( wgt[k] > 0 )
+            rn[k] = rxx[k] / wgt[k];
+
+    return rn;
+}
+
+template <typename Type>
+Vector<Type> StreamWiener<Type>::getCrossCorr() const
+{
+    Vector<Type> rn(p+1);
+    for( int k=0; k<=p; ++k )
+        if( wgt[k] > 0 )
+            rn[k] = rdx[k] / wgt[k];
+
+    return rn;
+}
+
+
+/**
+ * Solve the Wiener-Hopf equations of the current lags, starting from the
+ * previous solution.
+ * tol      : relative residual of conjugate gradient method, Levinson
+ *            algorithm is used if it isn't reached (or isn't a number)
+ * maxItr   : maximum iterations, 0 means p+1
+ * return   : the p+1 coefficients of Wiener filter
+ */
+template <typename Type>
+Vector<Type> StreamWiener<Type>::getFilter( const Type &tol, int maxItr )
+{
+    Vector<Type> rn = getAutoCorr(),
+                 bn = getCrossCorr();
+    if( rn[0] <= 0 )
+        return Vector<Type>(p+1);
+
+    if( maxItr <= 0 )
+        maxItr = p+1;
+
+    T.assign( rn );
+    IdentityPreconditioner<Type> M;
+    pcgSolver( T, M, bn, hn, tol, maxItr );
+
+    // the same stopping rule as "pcgSolver"
+    Type bNorm = norm(bn),
+         rNorm = 0;
+    if( bNorm == 0 )
+        bNorm = 1;
+    T.multiply( hn, Thn );
+    for( int i=0; i<=p; ++i )
+        rNorm += (bn[i]-Thn[i]) * (bn[i]-Thn[i]);
+
+    if( !( sqrt(rNorm) <= tol*bNorm ) )
+        if( !levinson( p+1, &rn[0], &bn[0], &hn[0], &work[0] ) )
+            hn = Type(0);
+
+    return hn;
+}
+
+
+/**
+ * The one step predictor by the current auto-correlation, see
+ * "wienerPredictor".
+ */
+template <typename Type>
+Vector<Type> StreamWiener<Type>::getPredictor()
+{
+    Vector<Type> rn = getAutoCorr(),
+                 predictor(p);
+    if( rn[0] <= 0 || p == 0 )
+        return predictor;
+
+    Type sigma2;
+    Vector<Type> ak(p+1);
+    if( levinsonDurbin( p, &rn[0], &ak[0], (Type*)0, sigma2 ) )
+        for( int i=1; i<=p; ++i )
+            predictor(i) = -ak[i];
+
+    return predictor;
+}
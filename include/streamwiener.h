@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+/*****************************************************************************
+ *                               streamwiener.h
+ *
+ * Streaming Wiener filter and predictor.
+ *
+ * "wienerFilter" and "wienerPredictor" in "wiener.h" compute the whole
+ * correlation sequences of the signals, but only p+1 lags are used. This
+ * class keeps the p+1 lags of the auto-correlation of the input x(n) and
+ * the cross-correlation between the desired signal d(n) and x(n), which
+ * are updated in O(p) operations per sample in one of the two ways:
+ *
+ * exponential window:  r(k) <- lambda*r(k) + x(n)*x(n-k), 0 < lambda <= 1,
+ *                      lambda = 1 gives the unbiased estimation over all
+ *                      samples, the same as "wienerFilter";
+ * sliding window:      the products of the newest sample are added and
+ *                      those of the sample W steps ago are removed, and the
+ *                      lags are recomputed every W samples to avoid the
+ *                      accumulation of rounding errors (O(p) amortized).
+ *
+ * The Wiener-Hopf equations are solved on demand by the conjugate gradient
+ * method starting from the previous solution, which needs only a few
+ * iterations when the statistics change slowly. The Toeplitz operator is
+ * built once and only its lags are replaced at each solution. If the
+ * residual is still above the tolerance after the given iterations,
+ * Levinson algorithm is used instead.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef STREAMWIENER_H
+#define STREAMWIENER_H
+
+
+#include <vector.h>
+#include <levinson.h>
+#include <toeplitzop.h>
+#include <pcgsolver.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class StreamWiener
+    {
+
+    public:
+
+        StreamWiener( int p, const Type &lambda=Type(1), int W=0 );
+        ~StreamWiener();
+
+        void reset();
+        void input( const Type &x, const Type &d=Type(0) );
+        void input( const Vector<Type> &xn, const Vector<Type> &dn );
+        void input( const Vector<Type> &xn );
+
+        int order() const;
+        Vector<Type> getAutoCorr() const;
+        Vector<Type> getCrossCorr() const;
+
+        Vector<Type> getFilter( const Type &tol=Type(1.0e-10),
+                                int maxItr=0 );
+        Vector<Type> getPredictor();
+
+    private:
+
+        // order, forgetting factor and sliding window length (0 for none)
+        int p;
+        Type lambda;
+        int W;
+
+        // histories of x(n) and d(n), the newest samples are at xPos and
+        // dPos, and the number of available samples (at most W+p+1)
+        Vector<Type> xBuf;
+        Vector<Type> dBuf;
+        int xPos,
+            dPos,
+            nAvail;
+
+        // samples since the last recomputation of the sliding window lags
+        int nRefresh;
+
+        // unnormalized correlation lags and their weights
+        Vector<Type> rxx;
+        Vector<Type> rdx;
+        Vector<Type> wgt;
+
+        // previous solution, work space of Levinson algorithm and the
+        // product T*hn for the residual
+        Vector<Type> hn;
+        Vector<Type> work;
+        Vector<Type> Thn;
+
+        // Toeplitz operator of the auto-correlation
+        ToeplitzOperator<Type> T;
+
+        Type xAt( int k ) const;
+        Type dAt( int k ) const;
+        void refresh();
+
+    };
+    // class StreamWiener
+
+
+    #include <streamwiener-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// STREAMWIENER_H
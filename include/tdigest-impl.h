@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                               tdigest-impl.h
+ *
+ * Implementation for TDigest class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ */
+template <typename Type>
+TDigest<Type>::TDigest( const Type &compression )
+: delta(compression)
+{
+    assert( compression > 0 );
+
+    buffer.resize( 5*int(ceil(delta)) + 10 );
+    reset();
+}
+
+template <typename Type>
+TDigest<Type>::~TDigest()
+{
+}
+
+
+/**
+ * Clear all the samples.
+ */
+template <typename Type>
+void TDigest<Type>::reset()
+{
+    total = 0;
+    xMin = 0;
+    xMax = 0;
+    nCentroids = 0;
+    nBuffer = 0;
+}
+
+
+/**
+ * Add a sample "x" of weight "w".
+ */
+template <typename Type>
+void TDigest<Type>::add( const Type &x, const Type &w )
+{
+    assert( w > 0 );
+
+    if( nBuffer == buffer.size() )
+        compress();
+
+    if( total == 0 )
+        xMin = xMax = x;
+    else if( x < xMin )
+        xMin = x;
+    else if( x > xMax )
+        xMax = x;
+
+    buffer[nBuffer++] = Centroid( x, w );
+    total += w;
+}
+
+
+/**
+ * Add a block of samples of unit weight.
+ */
+template <typename Type>
+void TDigest<Type>::add( const Vector<Type> &xn )
+{
+    for( int i=0; i<xn.size(); ++i )
+        add( xn[i] );
+}
+
+
+/**
+ * Merge the summary of another digest of disjoint data.
+ */
+template <typename Type>
+void TDigest<Type>::merge( const TDigest<Type> &rhs )
+{
+    if( rhs.total == 0 )
+        return;
+
+    Type lo = ( total == 0 || rhs.xMin < xMin ) ? rhs.xMin : xMin,
+         hi = ( total == 0 || rhs.xMax > xMax ) ? rhs.xMax : xMax;
+
+    for( int i=0; i<rhs.nCentroids; ++i )
+        add( rhs.centroids[i].mean, rhs.centroids[i].weight );
+    for( int i=0; i<rhs.nBuffer; ++i )
+        add( rhs.buffer[i].mean, rhs.buffer[i].weight );
+
+    xMin = lo;
+    xMax = hi;
+}
+
+
+/**
+ * Merge the buffered samples into the centroids. The centroids and the
+ * samples are sorted together and scanned from the left, the current
+ * centroid absorbs the next one while the cumulative quantile stays within
+ * one unit of the scale function from its left edge.
+ */
+template <typename Type>
+void TDigest<Type>::compress()
+{
+    if( nBuffer == 0 )
+        return;
+
+    int N = nCentroids + nBuffer;
+    Vector<Centroid> all( N );
+    for( int i=0; i<nCentroids; ++i )
+        all[i] = centroids[i];
+    for( int i=0; i<nBuffer; ++i )
+        all[nCentroids+i] = buffer[i];
+    quickSort( all, 0, N-1 );
+
+    if( centroids.size() < N )
+        centroids.resize( N );
+
+    Type q0 = 0,
+         limit = qLimit( q0 );
+    Centroid cur = all[0];
+    nCentroids = 0;
+
+    for( int i=1; i<N; ++i )
+    {
+        Type w = cur.weight + all[i].weight;
+        if( q0 + w/total <= limit )
+        {
+            cur.mean += (all[i].mean-cur.mean) * all[i].weight / w;
+            cur.weight = w;
+        }
+        else
+        {
+            centroids[nCentroids++] = cur;
+            q0 += cur.weight / total;
+            limit = qLimit( q0 );
+            cur = all[i];
+        }
+    }
+    centroids[nCentroids++] = cur;
+
+    nBuffer = 0;
+}
+
+
+/**
+ * The total weight of the samples.
+ */
+template <typename Type>
+inline Type TDigest<Type>::count() const
+{
+    return total;
+}
+
+
+/**
+ * The number of centroids (and buffered samples).
+ */
+template <typename Type>
+inline int TDigest<Type>::size() const
+{
+    return nCentroids + nBuffer;
+}
+
+
+/**
+ * The exact minimum and maximum of the samples.
+ */
+template <typename Type>
+inline Type TDigest<Type>::getMin() const
+{
+    return xMin;
+}
+
+template <typename Type>
+inline Type TDigest<Type>::getMax() const
+{
+    return xMax;
+}
+
+
+/**
+ * The p-quantile (0 <= p <= 1) of the samples. The centroid of weight w
+ * whose left edge is at cumulative weight c is placed at c+w/2, and the
+ * minimum and maximum at 0.5 and total-0.5, the p-quantile is the linear
+ * interpolation of these points at (total-1)*p + 0.5.
+ */
+template <typename Type>
+Type TDigest<Type>::quantile( const Type &p )
+{
+    assert( total > 0 );
+    assert( Type(0) <= p && p <= Type(1) );
+
+    compress();
+
+    Type index = (total-1)*p + Type(0.5);
+    Type pos0 = Type(0.5),
+         val0 = xMin,
+         cum = 0;
+
+    if( index <= pos0 )
+        return xMin;
+    if( index >= total-Type(0.5) )
+        return xMax;
+
+    for( int i=0; i<=nCentroids; ++i )
+    {
+        Type pos1, val1;
+        if( i < nCentroids )
+        {
+            pos1 = cum + centroids[i].weight/2;
+            val1 = centroids[i].mean;
+            cum += centroids[i].weight;
+        }
+        else
+        {
+            pos1 = total - Type(0.5);
+            val1 = xMax;
+        }
+
+        if( index <= pos1 )
+        {
+            if( pos1 <= pos0 )
+                return val1;
+            return val0 + (index-pos0)/(pos1-pos0)*(val1-val0);
+        }
+
+        pos0 = pos1;
+        val0 = val1;
+    }
+
+    return xMax;
+}
+
+
+/**
+ * The p-percentile (0 <= p <= 100) of the samples.
+ */
+template <typename Type>
+inline Type TDigest<Type>::percentile( const Type &p )
+{
+    return quantile( p/100 );
+}
+
+
+/**
+ * The cumulative distribution at "x", the inverse of "quantile".
+ */
+template <typename Type>
+Type TDigest<Type>::cdf( const Type &x )
+{
+    assert( total > 0 );
+
+    if( x < xMin )
+        return 0;
+    if( x >= xMax )
+        return 1;
+
+    compress();
+
+    Type pos0 = Type(0.5),
+         val0 = xMin,
+         cum = 0;
+
+    for( int i=0; i<=nCentroids; ++i )
+    {
+        Type pos1, val1;
+        if( i < nCentroids )
+        {
+            pos1 = cum + centroids[i].weight/2;
+            val1 = centroids[i].mean;
+            cum += centroids[i].weight;
+        }
+        else
+        {
+            pos1 = total - Type(0.5);
+            val1 = xMax;
+        }
+
+        if( x < val1 )
+        {
+            Type pos = pos0 + (x-val0)/(val1-val0)*(pos1-pos0);
+            return (pos-Type(0.5)) / (total-1);
+        }
+
+        pos0 = pos1;
+        val0 = val1;
+    }
+
+    return 1;
+}
+
+
+/**
+ * The largest cumulative quantile of a centroid starting at "q", i.e.
+ * k^{-1}( k(q)+1 ), where k^{-1}(k) = ( sin(2*pi*k/delta)+1 ) / 2.
+ */
+template <typename Type>
+Type TDigest<Type>::qLimit( const Type &q ) const
+{
+    Type r = 2*q - 1;
+    if( r < -1 )
+        r = -1;
+    else if( r > 1 )
+        r = 1;
+
+    Type theta = asin(r) + Type(TWOPI)/delta;
+    if( theta >= Type(HALFPI) )
+        return 1;
+
+    return ( sin(theta)+1 ) / 2;
+}
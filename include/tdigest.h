@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                  tdigest.h
+ *
+ * A mergeable streaming sketch of quantiles (the merging t-digest).
+ *
+ * The samples of a stream are summarized by a bounded number of centroids,
+ * i.e. the means and weights of clusters of adjacent samples. The size of
+ * a cluster is limited by the scale function
+ *      k(q) = delta/(2*pi) * asin(2q-1),
+ * every cluster spans at most one unit of k, so the clusters near the tails
+ * (q = 0 or 1) are small and the extreme quantiles are accurate, and there
+ * are no more than about "delta" (the compression) centroids whatever the
+ * length of the stream is. The new samples are collected in a buffer, and
+ * merged with the centroids in one sorted pass when the buffer is full, so
+ * the cost of adding a sample is O(log(delta)) amortized.
+ *
+ * Two digests of disjoint data are merged by adding the centroids of one to
+ * the other, so a large data set can be summarized by pieces in parallel.
+ * The quantiles are interpolated linearly between the centres of centroids
+ * (and the exact minimum and maximum at the ends), which is the same as
+ * "quantile" in "statistics.h" while no sample has been merged yet.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef TDIGEST_H
+#define TDIGEST_H
+
+
+#include <cmath>
+#include <constants.h>
+#include <vector.h>
+#include <sort.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class TDigest
+    {
+
+    public:
+
+        explicit TDigest( const Type &compression=Type(100) );
+        ~TDigest();
+
+        void reset();
+        void add( const Type &x, const Type &w=Type(1) );
+        void add( const Vector<Type> &xn );
+        void merge( const TDigest<Type> &rhs );
+        void compress();
+
+        Type count() const;
+        int size() const;
+        Type getMin() const;
+        Type getMax() const;
+        Type quantile( const Type &p );
+        Type percentile( const Type &p );
+        Type cdf( const Type &x );
+
+    private:
+
+        struct Centroid
+        {
+            Type mean,
+                 weight;
+
+            Centroid( const Type &m=Type(0), const Type &w=Type(0) )
+            : mean(m), weight(w)
+            { }
+
+            bool operator<( const Centroid &rhs ) const
+            {   return mean < rhs.mean;   }
+        };
+
+        Type delta;
+        Type total;
+        Type xMin,
+             xMax;
+
+        int nCentroids;
+        Vector<Centroid> centroids;
+
+        int nBuffer;
+        Vector<Centroid> buffer;
+
+        Type qLimit( const Type &q ) const;
+
+    };
+    // class TDigest
+
+
+    #include <tdigest-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// TDIGEST_H
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                             toeplitzop-impl.h
+ *
+ * Implementation for ToeplitzOperator and CirculantPreconditioner class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructors and destructor
+ * The symmetric Toeplitz operator is defined by its first row "rn", and the
+ * nonsymmetric one by its first column "cn" and first row "rn", the first
+ * element of "rn" is ignored.
+ */
+template <typename Type>
+ToeplitzOperator<Type>::ToeplitzOperator( const Vector<Type> &rn )
+                      : n(rn.size()), cn(rn), rn(rn)
+{
+    embed();
+}
+
+template <typename Type>
+ToeplitzOperator<Type>::ToeplitzOperator( const Vector<Type> &cn,
+                                          const Vector<Type> &rn )
+                      : n(cn.size()), cn(cn), rn(rn)
+{
+    assert( rn.size() == n );
+    embed();
+}
+
+template <typename Type>
+ToeplitzOperator<Type>::~ToeplitzOperator()
+{
+}
+
+
+/**
+ * Replace the operator by another one of the same dimension, defined in
+ * the same way as by the constructors.
+ */
+template <typename Type>
+void ToeplitzOperator<Type>::assign( const Vector<Type> &r )
+{
+    assert( r.size() == n );
+    cn = r;
+    rn = r;
+    embed();
+}
+
+template <typename Type>
+void ToeplitzOperator<Type>::assign( const Vector<Type> &c,
+                                     const Vector<Type> &r )
+{
+    assert( c.size() == n );
+    assert( r.size() == n );
+    cn = c;
+    rn = r;
+    embed();
+}
+
+
+/**
+ * Compute the eigenvalues of the circulant matrices of size L >= 2n-1 with
+ * T and T' as their leading n-by-n blocks.
+ */
+template <typename Type>
+void ToeplitzOperator<Type>::embed()
+{
+    assert( n > 0 );
+
+    L = 1;
+    while( L < 2*n-1 )
+        L <<= 1;
+
+    if( Ck.size() != L )
+    {
+        Ck.resize(L);
+        Ctk.resize(L);
+        zn.resize(L);
+    }
+
+    Ck = complex<Type>(0);
+    Ctk = complex<Type>(0);
+    Ck[0] = cn[0];
+    Ctk[0] = cn[0];
+    for( int k=1; k<n; ++k )
+    {
+        Ck[k] = cn[k];
+        Ck[L-k] = rn[k];
+        Ctk[k] = rn[k];
+        Ctk[L-k] = cn[k];
+    }
+
+    fft.fft(Ck);
+    fft.fft(Ctk);
+}
+
+
+/**
+ * Get the dimension, the first column and the first row.
+ */
+template <typename Type>
+inline int ToeplitzOperator<Type>::dim() const
+{
+    return n;
+}
+
+template <typename Type>
+inline Vector<Type> ToeplitzOperator<Type>::getColumn() const
+{
+    return cn;
+}
+
+template <typename Type>
+inline Vector<Type> ToeplitzOperator<Type>::getRow() const
+{
+    Vector<Type> row(rn);
+    row[0] = cn[0];
+
+    return row;
+}
+
+
+/**
+ * y = C*[x;0], the first n elements, where E is the eigenvalues of C.
+ */
+template <typename Type>
+void ToeplitzOperator<Type>::circMult( const Vector< complex<Type> > &E,
+                                       const Vector<Type> &x,
+                                       Vector<Type> &y )
+{
+    assert( x.size() == n );
+    if( y.size() != n )
+        y.resize(n);
+
+    for( int i=0; i<n; ++i )
+        zn[i] = x[i];
+    for( int i=n; i<L; ++i )
+        zn[i] = 0;
+
+    fft.fft(zn);
+    for( int k=0; k<L; ++k )
+        zn[k] *= E[k];
+    fft.ifft(zn);
+
+    for( int i=0; i<n; ++i )
+        y[i] = zn[i].real();
+}
+
+
+/**
+ * y = T*x and y = T'*x.
+ */
+template <typename Type>
+inline void ToeplitzOperator<Type>::multiply( const Vector<Type> &x,
+                                              Vector<Type> &y )
+{
+    circMult( Ck, x, y );
+}
+
+template <typename Type>
+inline void ToeplitzOperator<Type>::trMultiply( const Vector<Type> &x,
+                                                Vector<Type> &y )
+{
+    circMult( Ctk, x, y );
+}
+
+template <typename Type>
+Vector<Type> ToeplitzOperator<Type>::operator*( const Vector<Type> &x )
+{
+    Vector<Type> y(n);
+    circMult( Ck, x, y );
+
+    return y;
+}
+
+
+/**
+ * constructors and destructor
+ * type = "strang" : Strang's circulant, copy the central diagonals of T
+ * type = "chan"   : T. Chan's optimal circulant, the Frobenius norm of C-T
+ *                   is minimized
+ */
+template <typename Type>
+CirculantPreconditioner<Type>::CirculantPreconditioner(
+                                    ToeplitzOperator<Type> &T,
+                                    const string &type )
+                             : n(T.dim()), Ek(T.dim()), Rk(T.dim())
+{
+    Vector<Type> cn = T.getColumn(),
+                 rn = T.getRow(),
+                 c(n);
+
+    c[0] = cn[0];
+    if( type == "strang" )
+        for( int k=1; k<n; ++k )
+            c[k] = ( 2*k <= n ) ? cn[k] : rn[n-k];
+    else if( type == "chan" )
+        for( int k=1; k<n; ++k )
+            c[k] = ( (n-k)*cn[k] + k*rn[n-k] ) / Type(n);
+    else
+    {
+        cerr << "No such type preconditioner!" << endl;
+        c[0] = 1;
+    }
+
+    fft.fft( c, Ek );
+}
+
+template <typename Type>
+CirculantPreconditioner<Type>::~CirculantPreconditioner()
+{
+}
+
+
+/**
+ * Solve C*z = r.
+ */
+template <typename Type>
+void CirculantPreconditioner<Type>::solve( const Vector<Type> &r,
+                                           Vector<Type> &z )
+{
+    assert( r.size() == n );
+    if( z.size() != n )
+        z.resize(n);
+
+    fft.fft( r, Rk );
+    for( int k=0; k<n; ++k )
+        Rk[k] /= Ek[k];
+    fft.ifft( Rk, z );
+}
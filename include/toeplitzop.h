@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                toeplitzop.h
+ *
+ * Implicit Toeplitz operator and circulant preconditioner.
+ *
+ * Many applications only need the products T*x or the solution of T*x = b
+ * for an n-by-n Toeplitz matrix T, so there is no need to form the matrix
+ * by "toeplitz", which costs O(n^2) memory and time. The class
+ * "ToeplitzOperator" stores only the first column and row, and computes
+ * T*x in O(n*log(n)) by embedding T into a circulant matrix of power-of-2
+ * size L >= 2n-1, whose eigenvalues (the FFT of its first column) are
+ * computed once in the constructor. "assign" replaces T by another one of
+ * the same size, which reuses the FFT and the work space.
+ *
+ * The class "CirculantPreconditioner" approximates T by an n-by-n circulant
+ * matrix C, either Strang's (copying the central diagonals of T) or Chan's
+ * optimal one (minimizing the Frobenius norm of C-T), so C\r can be solved
+ * by FFTs of length n. Used with the preconditioned conjugate gradient
+ * method "pcgSolver", symmetric positive definite Toeplitz systems are
+ * solved in a few iterations of O(n*log(n)) each.
+ *
+ * The lengths n with small prime factors are preferred for the
+ * preconditioner, whose FFTs are computed by the prime factor algorithm.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef TOEPLITZOP_H
+#define TOEPLITZOP_H
+
+
+#include <string>
+#include <vector.h>
+#include <fftmr.h>
+#include <fftpf.h>
+
+
+namespace splab
+{
+
+    template <typename Type>
+    class ToeplitzOperator
+    {
+
+    public:
+
+        ToeplitzOperator( const Vector<Type> &rn );
+        ToeplitzOperator( const Vector<Type> &cn, const Vector<Type> &rn );
+        ~ToeplitzOperator();
+
+        void assign( const Vector<Type> &rn );
+        void assign( const Vector<Type> &cn, const Vector<Type> &rn );
+
+        int dim() const;
+        Vector<Type> getColumn() const;
+        Vector<Type> getRow() const;
+
+        void multiply( const Vector<Type> &x, Vector<Type> &y );
+        void trMultiply( const Vector<Type> &x, Vector<Type> &y );
+        Vector<Type> operator*( const Vector<Type> &x );
+
+    private:
+
+        // dimension and the circulant embedding size
+        int n,
+            L;
+
+        // first column and first row
+        Vector<Type> cn;
+        Vector<Type> rn;
+
+        // eigenvalues of the circulant embedding of T and T'
+        Vector< complex<Type> > Ck;
+        Vector< complex<Type> > Ctk;
+
+        // work space
+        Vector< complex<Type> > zn;
+        FFTMR<Type> fft;
+
+        void embed();
+        void circMult( const Vector< complex<Type> > &E,
+                       const Vector<Type> &x, Vector<Type> &y );
+
+    };
+    // class ToeplitzOperator
+
+
+    template <typename Type>
+    class CirculantPreconditioner
+    {
+
+    public:
+
+        CirculantPreconditioner( ToeplitzOperator<Type> &T,
+                                 const string &type="chan" );
+        ~CirculantPreconditioner();
+
+        void solve( const Vector<Type> &r, Vector<Type> &z );
+
+    private:
+
+        int n;
+
+        // eigenvalues of the circulant matrix
+        Vector< complex<Type> > Ek;
+
+        // work space
+        Vector< complex<Type> > Rk;
+        FFTPF<Type> fft;
+
+    };
+    // class CirculantPreconditioner
+
+
+    #include <toeplitzop-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// TOEPLITZOP_H
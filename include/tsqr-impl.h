@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 tsqr-impl.h
+ *
+ * Implementation for TSQR class.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+/**
+ * constructor and destructor
+ */
+template<typename Real>
+TSQR<Real>::TSQR() : m(0), n(0), mb(0), nLeaves(0)
+{
+}
+
+template<typename Real>
+TSQR<Real>::~TSQR()
+{
+}
+
+
+/**
+ * Create a tall-skinny QR factorization for A, m >= n.
+ */
+template <typename Real>
+void TSQR<Real>::dec( const Matrix<Real> &A )
+{
+    m = A.rows();
+    n = A.cols();
+    assert( m >= n );
+
+    mb = ( 4*n > MB ) ? 4*n : MB;
+    nLeaves = max( 1, m/mb );
+    leaves.resize( nLeaves );
+    nodes.resize( nLeaves-1 );
+
+    // factorize the row blocks
+    Vector< Matrix<Real> > Rs;
+    Rs.resize( nLeaves );
+
+    #pragma omp parallel for
+    for( int i=0; i<nLeaves; ++i )
+    {
+        leaves[i].dec( Matrix<Real>( rows(i), n, &A[i*mb][0] ) );
+        Rs[i] = leaves[i].getR();
+    }
+
+    // combine the R factors in pairs, an odd one goes to the next level
+    int offset = 0;
+    for( int c=nLeaves; c>1; c=(c+1)/2 )
+    {
+        int np = c/2;
+        Vector< Matrix<Real> > next;
+        next.resize( (c+1)/2 );
+
+        #pragma omp parallel for
+        for( int i=0; i<np; ++i )
+        {
+            nodes[offset+i].dec( stack( Rs[2*i], Rs[2*i+1] ) );
+            next[i] = nodes[offset+i].getR();
+        }
+        if( c%2 )
+            next[np] = Rs[c-1];
+
+        Rs = next;
+        offset += np;
+    }
+
+    R = Rs[0];
+}
+
+
+/**
+ * Flag to denote the matrix is of full rank.
+ */
+template <typename Real>
+inline bool TSQR<Real>::isFullRank() const
+{
+    for( int j=0; j<n; ++j )
+        if( R[j][j] == 0 )
+            return false;
+
+    return true;
+}
+
+
+/**
+ * the number of row blocks
+ */
+template <typename Real>
+inline int TSQR<Real>::blocks() const
+{
+    return nLeaves;
+}
+
+
+/**
+ * Return the n-by-n upper triangular factor.
+ */
+template <typename Real>
+Matrix<Real> TSQR<Real>::getR() const
+{
+    return R;
+}
+
+
+/**
+ * Least squares solution of A*x = b
+ * Return x: a vector that minimizes the two norm of A*x-b.
+ * If TSQR.isFullRank() is false, the routine returns a null
+ * (0-length) vector.
+ */
+template <typename Real>
+Vector<Real> TSQR<Real>::solve( const Vector<Real> &b )
+{
+    assert( b.dim() == m );
+
+    Matrix<Real> X = solve( Matrix<Real>( m, 1, &b[0] ) );
+    if( X.rows() == 0 )
+        return Vector<Real>();
+    else
+        return Vector<Real>( n, &X[0][0] );
+}
+
+
+/**
+ * Least squares solution of A*X = B
+ * Return X: a matrix that minimizes the two norm of A*X-B.
+ * If TSQR.isFullRank() is false, the routine returns a null
+ * (0) matrix.
+ */
+template <typename Real>
+Matrix<Real> TSQR<Real>::solve( const Matrix<Real> &B )
+{
+    assert( B.rows() == m );
+
+    // matrix is rank deficient
+    if( !isFullRank() )
+        return Matrix<Real>(0,0);
+
+    // compute the first n rows of transpose(Q)*B, and solve R*X = Y
+    Matrix<Real> X = reduce( B );
+    trsm( 'L', 'U', 'N', 'N', n, X.cols(), &R[0][0], n, &X[0][0], X.cols() );
+
+    return X;
+}
+
+
+/**
+ * the number of rows of block i, the last one takes the remainder
+ */
+template <typename Real>
+inline int TSQR<Real>::rows( int i ) const
+{
+    return ( i < nLeaves-1 ) ? mb : m-i*mb;
+}
+
+
+/**
+ * Apply transpose(Q) to B through the tree, and return the first n rows.
+ */
+template <typename Real>
+Matrix<Real> TSQR<Real>::reduce( const Matrix<Real> &B )
+{
+    int nx = B.cols();
+    Vector< Matrix<Real> > Ys;
+    Ys.resize( nLeaves );
+
+    #pragma omp parallel for
+    for( int i=0; i<nLeaves; ++i )
+        Ys[i] = topRows( leaves[i].applyQT(
+                         Matrix<Real>( rows(i), nx, &B[i*mb][0] ) ), n );
+
+    int offset = 0;
+    for( int c=nLeaves; c>1; c=(c+1)/2 )
+    {
+        int np = c/2;
+        Vector< Matrix<Real> > next;
+        next.resize( (c+1)/2 );
+
+        #pragma omp parallel for
+        for( int i=0; i<np; ++i )
+            next[i] = topRows( nodes[offset+i].applyQT(
+                               stack( Ys[2*i], Ys[2*i+1] ) ), n );
+        if( c%2 )
+            next[np] = Ys[c-1];
+
+        Ys = next;
+        offset += np;
+    }
+
+    return Ys[0];
+}
+
+
+/**
+ * the matrix [A; B]
+ */
+template <typename Real>
+Matrix<Real> TSQR<Real>::stack( const Matrix<Real> &A,
+                                const Matrix<Real> &B )
+{
+    int ma = A.rows(),
+        nc = A.cols();
+    Matrix<Real> S( ma+B.rows(), nc );
+
+    for( int i=0; i<ma; ++i )
+        for( int j=0; j<nc; ++j )
+            S[i][j] = A[i][j];
+    for( int i=0; i<B.rows(); ++i )
+        for( int j=0; j<nc; ++j )
+            S[ma+i][j] = B[i][j];
+
+    return S;
+}
+
+
+/**
+ * the first k rows of A
+ */
+template <typename Real>
+Matrix<Real> TSQR<Real>::topRows( const Matrix<Real> &A, int k )
+{
+    return Matrix<Real>( k, A.cols(), &A[0][0] );
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                   tsqr.h
+ *
+ * Class template of tall-skinny QR decomposition for real matrix.
+ *
+ * For an m-by-n matrix A with m >> n, the rows are split into blocks of at
+ * least MB (and 4*n) rows, and each block is factorized by "QRD",
+ *      A(i) = Q(i)*R(i),
+ * on separate threads if OpenMP is enabled. The R factors are then combined
+ * pairwise in a binary reduction tree: two stacked n-by-n factors [R1; R2]
+ * are factorized again, until one R is left, which is the R factor of A (up
+ * to the signs of its rows).
+ *
+ * Q is kept implicitly in the factorizations of the leaves and nodes of the
+ * tree, so that "solve" can apply Q^T to the right hand sides block by
+ * block and find the least squares solution of Ax=b or AX=B. The shape of
+ * the tree depends only on m and n, so the results don't depend on the
+ * number of threads. For less than 2*MB rows, there is only one block and
+ * the decomposition is the same as "QRD".
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#ifndef TSQR_H
+#define TSQR_H
+
+
+#include <qrd.h>
+
+
+namespace splab
+{
+
+    template <typename Real>
+    class TSQR
+    {
+
+    public:
+
+        TSQR();
+        ~TSQR();
+
+        void dec( const Matrix<Real> &A );
+        bool isFullRank() const;
+        int blocks() const;
+
+        Matrix<Real> getR() const;
+
+        Vector<Real> solve( const Vector<Real> &b );
+        Matrix<Real> solve( const Matrix<Real> &B );
+
+    private:
+
+        static const int MB = 4096;
+
+        int m,
+            n,
+            mb,
+            nLeaves;
+
+        // factorizations of the row blocks and of the tree nodes
+        Vector< QRD<Real> > leaves,
+                            nodes;
+
+        // the final upper triangular factor
+        Matrix<Real> R;
+
+        int rows( int i ) const;
+        Matrix<Real> reduce( const Matrix<Real> &B );
+
+        static Matrix<Real> stack( const Matrix<Real> &A,
+                                   const Matrix<Real> &B );
+        static Matrix<Real> topRows( const Matrix<Real> &A, int k );
+
+    };
+    //	class TSQR
+
+
+    #include <tsqr-impl.h>
+
+}
+// namespace splab
+
+
+#endif
+// TSQR_H
@@ -96,3 +96,152 @@ Matrix<Type> wvd( const Vector< complex<Type> > &cn )
 
     return coefs;
 }
+
+
+/**
+ * Compute the smoothed pseudo WVD of 1D real signal "sn", see the complex
+ * version below.
+ */
+template <typename Type>
+inline Matrix<Type> spwvd( const Vector<Type> &sn, const Vector<Type> &gn,
+                           const Vector<Type> &hn, int L, int step )
+{
+    return spwvd( complexVector(sn), gn, hn, L, step, 0, sn.size() );
+}
+
+template <typename Type>
+inline Matrix<Type> spwvd( const Vector<Type> &sn, const Vector<Type> &gn,
+                           const Vector<Type> &hn, int L, int step,
+                           int t0, int t1 )
+{
+    return spwvd( complexVector(sn), gn, hn, L, step, t0, t1 );
+}
+
+
+/**
+ * Compute the smoothed pseudo WVD of 1D complex signal "cn" at time instants
+ * 0, step, 2*step, ..., see the tile version below.
+ */
+template <typename Type>
+inline Matrix<Type> spwvd( const Vector< complex<Type> > &cn,
+                           const Vector<Type> &gn, const Vector<Type> &hn,
+                           int L, int step )
+{
+    return spwvd( cn, gn, hn, L, step, 0, cn.size() );
+}
+
+
+/**
+ * Compute the smoothed pseudo WVD of 1D complex signal "cn" at time instants
+ * t0, t0+step, ..., which are smaller than t1. So a long signal can be
+ * analysed tile by tile, and each tile only needs L*(t1-t0)/step memory.
+ * gn       : time smoothing window, odd length
+ * hn       : frequency smoothing window, odd length and symmetric
+ * L        : the number of frequency bins, the k-th row represents the
+ *            normalized frequency k/(2L)
+ * return   : L-by-ceil((t1-t0)/step) REAL matrix, the column represents
+ *            time, and row represents frequency.
+ */
+template <typename Type>
+Matrix<Type> spwvd( const Vector< complex<Type> > &cn,
+                    const Vector<Type> &gn, const Vector<Type> &hn,
+                    int L, int step, int t0, int t1 )
+{
+    assert( gn.size()%2 == 1 );
+    assert( hn.size()%2 == 1 );
+    assert( step > 0 );
+    assert( 0 <= t0 && t0 <= t1 && t1 <= cn.size() );
+
+    int cols = (t1-t0+step-1) / step,
+        pairs = (cols+1) / 2;
+    Matrix<Type> coefs( L, cols );
+
+    // Two Hermitian kernels are packed into one complex sequence, so the
+    // real and imaginary parts of its spectrum are the spectra of them.
+    #pragma omp parallel
+    {
+        Vector< complex<Type> > kn(L), Kk(L);
+        FFTMR<Type> dftmr;
+        FFTPF<Type> dftpf;
+
+        #pragma omp for schedule(dynamic)
+        for( int c=0; c<pairs; ++c )
+        {
+            int j = 2*c;
+
+            kn = complex<Type>(0);
+            spwvdKernel( cn, gn, hn, t0+j*step, complex<Type>(1,0), kn );
+            if( j+1 < cols )
+                spwvdKernel( cn, gn, hn, t0+(j+1)*step,
+                             complex<Type>(0,1), kn );
+
+            if( isPower2(L) )
+            {
+                dftmr.fft( kn );
+                for( int k=0; k<L; ++k )
+                    coefs[k][j] = kn[k].real();
+                if( j+1 < cols )
+                    for( int k=0; k<L; ++k )
+                        coefs[k][j+1] = kn[k].imag();
+            }
+            else
+            {
+                dftpf.fft( kn, Kk );
+                for( int k=0; k<L; ++k )
+                    coefs[k][j] = Kk[k].real();
+                if( j+1 < cols )
+                    for( int k=0; k<L; ++k )
+                        coefs[k][j+1] = Kk[k].imag();
+            }
+        }
+    }
+
+    return coefs;
+}
+
+
+/**
+ * Add "scale" times the smoothed instantaneous auto-correlation of "cn" at
+ * time "t" to "kn", which is stored in FFT order: lag 0, 1, ..., -2, -1.
+ * The time window is normalized to the available samples at each lag.
+ */
+template <typename Type>
+static void spwvdKernel( const Vector< complex<Type> > &cn,
+                         const Vector<Type> &gn, const Vector<Type> &hn,
+                         int t, const complex<Type> &scale,
+                         Vector< complex<Type> > &kn )
+{
+    int N = cn.size(),
+        L = kn.size(),
+        Lg = gn.size()/2,
+        Lh = hn.size()/2,
+        tauMax = min( (L-1)/2, Lh );
+
+    for( int tau=0; tau<=tauMax; ++tau )
+    {
+        // the smoothing range that keeps t+tau-u and t-tau-u in [0,N)
+        int uMin = max( -Lg, t+tau-N+1 ),
+            uMax = min( Lg, t-tau );
+        if( uMin > uMax )
+            break;
+
+        Type gs = 0;
+        complex<Type> R = 0;
+        for( int u=uMin; u<=uMax; ++u )
+        {
+            gs += gn[Lg+u];
+            R += gn[Lg+u] * cn[t+tau-u] * conj(cn[t-tau-u]);
+        }
+        if( gs == 0 )
+            continue;
+        R /= gs;
+
+        if( tau == 0 )
+            kn[0] += scale * hn[Lh] * R;
+        else
+        {
+            kn[tau] += scale * hn[Lh+tau] * R;
+            kn[L-tau] += scale * hn[Lh-tau] * conj(R);
+        }
+    }
+}
@@ -31,6 +31,14 @@
  * The "sn" can be either real signal or complex signal. The WVD coefficients
  * is an N-by-N REAL matrix, where N is the signal length.
  *
+ * For long signals the smoothed pseudo WVD "spwvd" should be used. It smooths
+ * the distribution by a time window "gn" and a frequency window "hn", and
+ * only computes the time instants t0, t0+step, ..., so the result can be
+ * obtained tile by tile without holding the whole N-by-N matrix. Because the
+ * windowed instantaneous auto-correlation is Hermitian, the spectra of two
+ * time instants are computed by one complex FFT. If OpenMP is enabled, the
+ * time instants are computed in parallel.
+ *
  * Zhang Ming, 2010-10, Xi'an Jiaotong University.
  *****************************************************************************/
 
@@ -52,6 +60,25 @@ namespace splab
     template<typename Type> Matrix<Type> wvd( const Vector<Type>& );
     template<typename Type> Matrix<Type> wvd( const Vector< complex<Type> >& );
 
+    template<typename Type>
+    Matrix<Type> spwvd( const Vector<Type>&, const Vector<Type>&,
+                        const Vector<Type>&, int, int step=1 );
+    template<typename Type>
+    Matrix<Type> spwvd( const Vector< complex<Type> >&, const Vector<Type>&,
+                        const Vector<Type>&, int, int step=1 );
+    template<typename Type>
+    Matrix<Type> spwvd( const Vector<Type>&, const Vector<Type>&,
+                        const Vector<Type>&, int, int, int, int );
+    template<typename Type>
+    Matrix<Type> spwvd( const Vector< complex<Type> >&, const Vector<Type>&,
+                        const Vector<Type>&, int, int, int, int );
+
+    template<typename Type>
+    static void spwvdKernel( const Vector< complex<Type> >&,
+                             const Vector<Type>&, const Vector<Type>&,
+                             int, const complex<Type>&,
+                             Vector< complex<Type> >& );
+
 
     #include <wvd-impl.h>
 
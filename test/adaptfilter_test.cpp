@@ -0,0 +1,200 @@
+/*****************************************************************************
+ *                              adaptfilter_test.cpp
+ *
+ * Adaptive filter objects testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <lms.h>
+#include <rls.h>
+#include <random.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 2000;
+const   int     order = 3;
+const   int     C = 4;
+
+
+Type maxDiff( const Vector<Type> &a, const Vector<Type> &b, int n=N )
+{
+    Type d = 0;
+    for( int i=0; i<n; ++i )
+        d = max( d, abs(a[i]-b[i]) );
+    return d;
+}
+
+
+int main()
+{
+    int L = order+1;
+    Random rg(37);
+    Vector<Type> xn(N), dn(N), yn(N), yf(N), wn(L);
+
+    // an unknown system "hn" excited by white noise
+    Type hn[] = { 0.8, -0.5, 0.3, -0.1 };
+    for( int k=0; k<N; ++k )
+        xn[k] = rg.random()/Type(rg.getM()) - Type(0.5);
+    for( int k=0; k<N; ++k )
+        for( int i=0; i<L && i<=k; ++i )
+            dn[k] += hn[i]*xn[k-i];
+
+    Type xnPow = dotProd(xn,xn)/N;
+    Type mu = Type( 0.1 / (L*xnPow) ), muN = Type( 0.1 / L );
+    Type rho = Type(0.5), gamma = Type(1.0e-9), alpha = Type(0.05),
+         lambda = Type(0.99), delta = Type(1.0);
+
+    // the objects give the same results as the functions
+    cout << "max |object - function| of the outputs:" << endl;
+
+    LMS<Type> lmsObj( L, mu );
+    lmsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = lms( xn[k], dn[k], wn, mu );
+    cout << "LMS        : " << maxDiff(yn,yf) << endl;
+
+    LMSNewton<Type> newtonObj( L, muN, alpha, xnPow );
+    newtonObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = lmsNewton( xn[k], dn[k], wn, muN, alpha, xnPow );
+    // the function loses the symmetry of its inverse correlation matrix by
+    // rounding errors and diverges after a while, so only compare the head
+    cout << "LMS-Newton : " << maxDiff(yn,yf,N/4) << endl;
+
+    NLMS<Type> nlmsObj( L, rho, gamma );
+    nlmsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = lmsNormalize( xn[k], dn[k], wn, rho, gamma );
+    cout << "NLMS       : " << maxDiff(yn,yf) << endl;
+
+    RLS<Type> rlsObj( L, lambda, delta );
+    rlsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = rls( xn[k], dn[k], wn, lambda, delta );
+    cout << "RLS        : " << maxDiff(yn,yf) << endl;
+
+    Type eps = Type(1.0);
+    SFTRLS<Type> sftrlsObj( L, lambda, eps );
+    sftrlsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = sftrls( xn[k], dn[k], wn, lambda, eps, "on" );
+    cout << "SFTRLS     : " << maxDiff(yn,yf) << endl;
+
+    // the lattice filters keep running when not trained, so the outputs of
+    // "filter" are compared, too
+    int M = N/2;
+    LRLS<Type> lrlsObj( L, lambda, eps );
+    lrlsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = lrls( xn[k], dn[k], wn, lambda, eps, "on" );
+    Type d = maxDiff(yn,yf);
+    for( int k=0; k<M; ++k )
+        d = max( d, abs( lrlsObj.filter(xn[k]) -
+                         lrls( xn[k], Type(0), wn, lambda, eps, "off" ) ) );
+    cout << "LRLS       : " << d << endl;
+
+    EFLRLS<Type> eflrlsObj( L, lambda, eps );
+    eflrlsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = eflrls( xn[k], dn[k], wn, lambda, eps, "on" );
+    d = maxDiff(yn,yf);
+    for( int k=0; k<M; ++k )
+        d = max( d, abs( eflrlsObj.filter(xn[k]) -
+                         eflrls( xn[k], Type(0), wn, lambda, eps, "off" ) ) );
+    cout << "EFLRLS     : " << d << endl;
+
+    // the first L outputs differ: the function takes 1 instead of x(0) as
+    // the diagonal of its initial triangular system
+    QRRLS<Type> qrrlsObj( L, sqrt(lambda) );
+    qrrlsObj.adapt( xn, dn, yn );
+    wn = 0;
+    for( int k=0; k<N; ++k )
+        yf[k] = qrrls( xn[k], dn[k], wn, sqrt(lambda), "on" );
+    d = 0;
+    for( int k=L; k<N; ++k )
+        d = max( d, abs(yn[k]-yf[k]) );
+    cout << "QRRLS      : " << d << endl << endl;
+
+    // several independent echo cancellers run concurrently
+    Matrix<Type> xc(C,N), dc(C,N), yc(C,N);
+    for( int c=0; c<C; ++c )
+        for( int k=0; k<N; ++k )
+        {
+            xc[c][k] = rg.random()/Type(rg.getM()) - Type(0.5);
+            for( int i=0; i<L && i<=k; ++i )
+                dc[c][k] += (c+1)*hn[i]*xc[c][k-i];
+        }
+
+    LMS<Type> f0( L, mu );
+    NLMS<Type> f1( L, rho, gamma );
+    LMSNewton<Type> f2( L, muN, alpha, xnPow );
+    RLS<Type> f3( L, lambda, delta );
+    AdaptFilter<Type> *filters[C] = { &f0, &f1, &f2, &f3 };
+    adaptChannels( filters, xc, dc, yc );
+
+    cout << "channel c has the unknown system (c+1)*hn:" << endl;
+    cout << "hn\t\t";
+    for( int i=0; i<L; ++i )
+        cout << setiosflags(ios::fixed) << setprecision(4) << hn[i] << "\t";
+    cout << endl;
+    const char *names[C] = { "LMS\t\t", "NLMS\t\t", "LMS-Newton\t", "RLS\t\t" };
+    for( int c=0; c<C; ++c )
+    {
+        wn = filters[c]->getWeights();
+        cout << names[c];
+        for( int i=0; i<L; ++i )
+            cout << wn[i]/(c+1) << "\t";
+        cout << endl;
+    }
+    cout << endl;
+
+    // the fast and the lattice RLS filters in the same way
+    SFTRLS<Type> g0( L, lambda, eps );
+    LRLS<Type> g1( L, lambda, eps );
+    EFLRLS<Type> g2( L, lambda, eps );
+    QRRLS<Type> g3( L, sqrt(lambda) );
+    AdaptFilter<Type> *rlsFilters[C] = { &g0, &g1, &g2, &g3 };
+    adaptChannels( rlsFilters, xc, dc, yc );
+
+    const char *rlsNames[C] = { "SFTRLS\t\t", "LRLS\t\t", "EFLRLS\t\t",
+                                "QRRLS\t\t" };
+    cout << "relative error of the last " << N/4 << " outputs:" << endl;
+    for( int c=0; c<C; ++c )
+    {
+        Type ee = 0, dd = 0;
+        for( int k=N-N/4; k<N; ++k )
+        {
+            ee += (dc[c][k]-yc[c][k]) * (dc[c][k]-yc[c][k]);
+            dd += dc[c][k] * dc[c][k];
+        }
+        cout << rlsNames[c] << resetiosflags(ios::fixed) << setprecision(4)
+             << sqrt(ee/dd) << endl;
+    }
+    wn = g3.getWeights();
+    cout << "QRRLS weights\t" << setiosflags(ios::fixed);
+    for( int i=0; i<L; ++i )
+        cout << wn[i]/C << "\t";
+    cout << endl << endl;
+
+    f3.reset();
+    cout << "weights after reset:\t" << f3.getWeights() << endl;
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                blas3_test.cpp
+ *
+ * Blocked matrix-matrix kernels testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <matrix.h>
+#include <blas3.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     M = 150;
+const   int     N = 290;
+const   int     K = 270;
+
+
+Matrix<Type> randMatrix( int rows, int cols, int seed )
+{
+    Vector<Type> r = randn( seed, Type(0.0), Type(1.0), rows*cols );
+    return Matrix<Type>( rows, cols, r.begin() );
+}
+
+
+Type maxDiff( const Matrix<Type> &A, const Matrix<Type> &B )
+{
+    Type d = 0;
+    for( int i=0; i<A.rows(); ++i )
+        for( int j=0; j<A.cols(); ++j )
+            d = max( d, abs(A[i][j]-B[i][j]) );
+    return d;
+}
+
+
+int main()
+{
+    char t[2] = { 'N', 'T' };
+    Type alpha = 1.5,
+         beta = -0.5;
+
+    cout << setiosflags(ios::scientific) << setprecision(2);
+    cout << "max|gemm - alpha*op(A)*op(B) - beta*C|" << endl;
+    for( int a=0; a<2; ++a )
+        for( int b=0; b<2; ++b )
+        {
+            Matrix<Type> A = (a == 0) ? randMatrix(M,K,1) : randMatrix(K,M,1),
+                         B = (b == 0) ? randMatrix(K,N,2) : randMatrix(N,K,2),
+                         C = randMatrix( M, N, 3 );
+            Matrix<Type> opA = (a == 0) ? A : trT(A),
+                         opB = (b == 0) ? B : trT(B),
+                         D = alpha*(opA*opB) + beta*C;
+
+            gemm( t[a], t[b], M, N, K, alpha, &A[0][0], A.cols(),
+                  &B[0][0], B.cols(), beta, &C[0][0], N );
+            cout << t[a] << t[b] << " : " << maxDiff( C, D ) << endl;
+        }
+    cout << endl;
+
+    cout << "max|C - alpha*A*A^T - beta*C0| of syrk (lower)" << endl;
+    for( int a=0; a<2; ++a )
+    {
+        Matrix<Type> A = (a == 0) ? randMatrix(N,K,6) : randMatrix(K,N,6),
+                     C = randMatrix( N, N, 7 );
+        Matrix<Type> opA = (a == 0) ? A : trT(A),
+                     D = alpha*(opA*trT(opA)) + beta*C;
+
+        syrk( (a == 0) ? 'N' : 'C', N, K, alpha, &A[0][0], A.cols(),
+              beta, &C[0][0], N );
+        for( int i=0; i<N; ++i )
+            for( int j=i+1; j<N; ++j )
+                C[i][j] = D[i][j];
+        cout << ((a == 0) ? 'N' : 'C') << " : " << maxDiff( C, D ) << endl;
+    }
+    cout << endl;
+
+    cout << "max|op(A)*X - B| or max|X*op(A) - B| of trsm" << endl;
+    char s[2] = { 'L', 'R' },
+         u[2] = { 'L', 'U' },
+         d[2] = { 'N', 'U' };
+    for( int h=0; h<2; ++h )
+        for( int i=0; i<2; ++i )
+            for( int j=0; j<2; ++j )
+                for( int k=0; k<2; ++k )
+                {
+                    int na = (s[h] == 'L') ? M : N;
+                    Matrix<Type> A = randMatrix( na, na, 4 ),
+                                 B = randMatrix( M, N, 5 );
+                    for( int r=0; r<na; ++r )
+                    {
+                        for( int c=0; c<na; ++c )
+                            if( (u[i] == 'L') ? (c > r) : (c < r) )
+                                A[r][c] = 0;
+                            else
+                                A[r][c] /= na;
+                        A[r][r] = (d[k] == 'U') ? 1 : 2+A[r][r];
+                    }
+
+                    Matrix<Type> X(B);
+                    trsm( s[h], u[i], t[j], d[k], M, N, &A[0][0], na,
+                          &X[0][0], N );
+                    Matrix<Type> opA = (j == 0) ? A : trT(A),
+                                 R = (s[h] == 'L') ? opA*X : X*opA;
+                    cout << s[h] << u[i] << t[j] << d[k] << " : "
+                         << maxDiff( R, B ) << endl;
+                }
+
+    return 0;
+}
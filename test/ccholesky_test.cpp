@@ -63,5 +63,29 @@ int main()
         cout << "The product of  A*inv(A) : " << A*IA << endl;
     }
 
+    // a Hermitian matrix of several blocks with complex off-diagonal entries
+    const int NL = 300;
+    Matrix<complex<Type> > B(NL,NL);
+    for( int i=0; i<NL; ++i )
+    {
+        for( int j=0; j<i; ++j )
+        {
+            B[i][j] = complex<Type>( cos(Type(i+2*j)), sin(Type(3*i-j)) );
+            B[j][i] = conj( B[i][j] );
+        }
+        B[i][i] = complex<Type>( 2*NL, 0 );
+    }
+
+    cho.dec(B);
+    L = cho.getL();
+    Matrix<complex<Type> > E = B - L*trH(L);
+    Type err = 0;
+    for( int i=0; i<NL; ++i )
+        for( int j=0; j<NL; ++j )
+            err = max( err, abs(E[i][j]) );
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "max |B - L*L^H| of a " << NL << " by " << NL << " matrix : "
+         << err << endl << endl;
+
 	return 0;
 }
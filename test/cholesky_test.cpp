@@ -62,7 +62,120 @@ int main()
         Matrix<Type> IA = cho.solve(eye(N,Type(1)));
         cout << "The inverse matrix of A : " << IA << endl;
         cout << "The product of  A*inv(A) : " << A*IA << endl;
+
+        Vector<Type> u(N);
+        for( int i=0; i<N; ++i )
+            u[i] = 1.0 / (i+1);
+        Matrix<Type> Au = A;
+        for( int i=0; i<N; ++i )
+            for( int j=0; j<N; ++j )
+                Au[i][j] += u[i]*u[j];
+
+        cho.update(u);
+        L = cho.getL();
+        cout << "The vector u : " << u << endl;
+        cout << "The updated L for A + u*u^T : " << L << endl;
+        cout << "A + u*u^T - L*L^T is : " << Au - L*trT(L) << endl;
+
+        if( cho.downdate(u) )
+        {
+            L = cho.getL();
+            cout << "The downdated L for A : " << L << endl;
+            cout << "A - L*L^T is : " << A - L*trT(L) << endl;
+        }
+
+        cout << "Downdating A by 3*b*b^T : "
+             << ( cho.downdate(Type(3)*b) ? "succeeded" : "not positive definite" )
+             << endl << endl;
+    }
+
+    // sliding window of W rows of [Aw, bw]: the first row leaves, a new
+    // row enters, the factor is compared with a fresh decomposition
+    const int W = 6;
+    Matrix<Type> Ab( W, N+1 );
+    for( int i=0; i<W; ++i )
+        for( int j=0; j<=N; ++j )
+            Ab[i][j] = cos( Type(i*(N+1)+j) ) + ( i == j );
+
+    Vector<Type> in(N+1), out(N+1);
+    for( int j=0; j<=N; ++j )
+    {
+        in[j] = sin( Type(j+1) );
+        out[j] = Ab[0][j];
+    }
+
+    cho.dec( trMult(Ab,Ab) );
+    cho.update( in );
+    bool ok = cho.downdate( out );
+    Matrix<Type> Lw = cho.getL();
+
+    for( int j=0; j<=N; ++j )
+        Ab[0][j] = in[j];
+    cho.dec( trMult(Ab,Ab) );
+    Type errL = 0;
+    for( int i=0; i<=N; ++i )
+        for( int j=0; j<=N; ++j )
+            errL = max( errL, abs(Lw[i][j]-cho.getL()[i][j]) );
+
+    // R = Lw', x by back substitution with R(0:N-1,0:N-1) and R(0:N-1,N)
+    Vector<Type> x(N);
+    for( int k=N-1; k>=0; --k )
+    {
+        x[k] = Lw[N][k];
+        for( int j=k+1; j<N; ++j )
+            x[k] -= Lw[j][k]*x[j];
+        x[k] /= Lw[k][k];
+    }
+
+    Matrix<Type> Aw( W, N );
+    Vector<Type> bw( W );
+    for( int i=0; i<W; ++i )
+    {
+        for( int j=0; j<N; ++j )
+            Aw[i][j] = Ab[i][j];
+        bw[i] = Ab[i][N];
+    }
+    cho.dec( trMult(Aw,Aw) );
+    Vector<Type> xw = cho.solve( trMult(Aw,bw) );
+
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "Sliding window of [A, b] : downdate "
+         << ( ok ? "succeeded" : "failed" ) << endl;
+    cout << "max |L - L of fresh dec| : " << errL << endl;
+    cout << "norm of x - x of fresh dec : " << norm(x-xw) << endl << endl;
+
+    // rank-one update of a Hermitian matrix
+    Matrix<complex<Type> > C(N,N);
+    Vector<complex<Type> > v(N);
+    for( int i=0; i<N; ++i )
+    {
+        for( int j=0; j<i; ++j )
+        {
+            C[i][j] = complex<Type>( Type(1)/(i+j+1), Type(i-j)/N );
+            C[j][i] = conj( C[i][j] );
+        }
+        C[i][i] = Type(N+i);
+        v[i] = complex<Type>( 1, Type(i)/N );
     }
+    Cholesky<complex<Type> > ccho;
+    ccho.dec( C );
+    ccho.update( v );
+    Matrix<complex<Type> > Lc = ccho.getL(),
+                           E = C + multTr(v,v) - multTr(Lc,Lc);
+    Type errC = 0;
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<N; ++j )
+            errC = max( errC, abs(E[i][j]) );
+    cout << "max |C + v*v^H - L*L^H| : " << errC << endl;
+
+    ok = ccho.downdate( v );
+    Lc = ccho.getL();
+    E = C - multTr(Lc,Lc);
+    errC = 0;
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<N; ++j )
+            errC = max( errC, abs(E[i][j]) );
+    cout << "max |C - L*L^H| after downdate : " << errC << endl << endl;
 
 	return 0;
 }
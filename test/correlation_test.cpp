@@ -75,5 +75,11 @@ int main()
     cout << "fast unbiased cross-correlation of yn and xn:   "
          << fastCorr(yn,xn,"unbiased") << endl;
 
+    // the first lags of auto correlation function
+    cout << "lags 0 to 3 of biased auto-correlation of yn:   "
+         << corrLags(yn,3,"biased") << endl;
+    cout << "lags 0 to 3 of unbiased auto-correlation of yn:   "
+         << corrLags(yn,3,"unbiased") << endl;
+
     return 0;
 }
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ *                                csd_test.cpp
+ *
+ * Multi-channel cross power spectral density testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <vectormath.h>
+#include <random.h>
+#include <classicalpse.h>
+#include <csd.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     C = 4;
+const   int     N = 4096;
+const   int     M = 128;
+const   int     K = 64;
+const   int     L = 128;
+const   int     D = 3;
+
+
+int main()
+{
+    /******************************* [ signal ] ******************************/
+    Type f0 = Type(0.125);
+    Vector<Type> tn = linspace( Type(0), Type(N+D-1), N+D );
+    Vector<Type> sn = sin(TWOPI*f0*tn) + randn( 1, Type(0), Type(1.0), N+D );
+
+    // channel 1 is channel 0 delayed by D samples, channel 2 is independent
+    // noise and channel 3 is the mixture of channel 0 and channel 2
+    Matrix<Type> xn( C, N );
+    Vector<Type> n1 = randn( 2, Type(0), Type(0.2), N ),
+                 n2 = randn( 3, Type(0), Type(1.0), N );
+    for( int i=0; i<N; ++i )
+    {
+        xn[0][i] = sn[D+i];
+        xn[1][i] = sn[i] + n1[i];
+        xn[2][i] = n2[i];
+        xn[3][i] = xn[0][i] + xn[2][i];
+    }
+
+    /****************************** [ estimate ] *****************************/
+    Vector<Type> wn = hanning( M, Type(1.0) );
+    CSD<Type> csd( C, wn, K, L );
+    csd.estimate( xn );
+
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "Averaged segments: " << csd.segments() << endl << endl;
+
+    // auto spectrum is the same as Welch method
+    Vector<Type> Pw = welchPSE( xn.getRow(0), wn, K, L ),
+                 P0 = csd.getPSD(0);
+    Type err = 0;
+    for( int k=0; k<csd.freqs(); ++k )
+        err = max( err, abs(Pw[k]-P0[k]) );
+    cout << "Maximum difference between S00 and Welch PSD: " << err
+         << endl << endl;
+
+    int k0 = int( f0*L );
+    cout << "Coherence at f0 (0,1), (0,2), (0,3): "
+         << csd.getCoherence(0,1)[k0] << "\t"
+         << csd.getCoherence(0,2)[k0] << "\t"
+         << csd.getCoherence(0,3)[k0] << endl;
+    cout << "Phase of S01 at f0: " << csd.getPhase(0,1)[k0]
+         << "\t theoretical: " << TWOPI*f0*D << endl;
+    cout << "Phase of S10 at f0: " << csd.getPhase(1,0)[k0] << endl << endl;
+
+    Matrix< complex<Type> > Sk = csd.getCSM(k0);
+    cout << "Cross spectral matrix at f0: " << Sk << endl;
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*****************************************************************************
+ *                                 fdaf_test.cpp
+ *
+ * Frequency-domain block LMS adaptive filter testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <fdaf.h>
+#include <random.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     L = 512;
+const   int     N = 64*L;
+const   int     segLen = 8*L;
+
+
+int main()
+{
+    Random rg(11);
+    Vector<Type> hn(L), xn(N), dn(N), yn(N);
+
+    // an exponentially decaying echo path
+    for( int i=0; i<L; ++i )
+        hn[i] = ( rg.random()/Type(rg.getM()) - Type(0.5) ) * exp(-Type(i)/64);
+
+    // colored input signal (first order AR) and the echo
+    Type v = 0;
+    for( int k=0; k<N; ++k )
+    {
+        v = Type(0.9)*v + rg.random()/Type(rg.getM()) - Type(0.5);
+        xn[k] = v;
+    }
+    for( int k=0; k<N; ++k )
+    {
+        Type sum = 0;
+        for( int i=0; i<L && i<=k; ++i )
+            sum += hn[i]*xn[k-i];
+        dn[k] = sum + Type(1.0e-4) * ( rg.random()/Type(rg.getM()) - Type(0.5) );
+    }
+
+    int blockLens[] = { L, L/8 };
+    for( int b=0; b<2; ++b )
+    {
+        int B = blockLens[b];
+        int P = L/B;
+        FDAF<Type> af( L, B, Type(0.5)/P );
+
+        cout << "block length = " << B << ", partitions = " << P << endl;
+        cout << "samples\t\tERLE (dB)\tmisalignment (dB)" << endl;
+        for( int s=0; s<N; s+=segLen )
+        {
+            Vector<Type> xs(segLen), ds(segLen), ys(segLen);
+            for( int k=0; k<segLen; ++k )
+            {
+                xs[k] = xn[s+k];
+                ds[k] = dn[s+k];
+            }
+            af.adapt( xs, ds, ys );
+
+            Type pd = 0, pe = 0;
+            for( int k=0; k<segLen; ++k )
+            {
+                pd += ds[k]*ds[k];
+                pe += (ds[k]-ys[k])*(ds[k]-ys[k]);
+            }
+            Vector<Type> wn = af.getWeights();
+            Type mis = norm(wn-hn) / norm(hn);
+
+            cout << setiosflags(ios::fixed) << setprecision(4)
+                 << s+segLen << "\t\t" << 10*log10(pd/pe) << "\t\t"
+                 << 20*log10(mis) << endl;
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
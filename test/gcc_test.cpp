@@ -0,0 +1,103 @@
+/*****************************************************************************
+ *                                 gcc_test.cpp
+ *
+ * Generalized cross-correlation testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <gcc.h>
+#include <correlation.h>
+#include <random.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     C = 6;
+const   int     N = 1000;
+const   int     M = 20;
+const   int     F = 10;
+
+
+int main()
+{
+    int i, j, c, f;
+    int delay[C] = { 0, 3, -5, 7, 12, -2 };
+
+    // a white source received with different delays and sensor noises
+    Vector<Type> sn = randn( 17, Type(0), Type(1), F*N+2*M );
+    Matrix<Type> xn(C,N);
+    Vector<Type> vn = randn( 29, Type(0), Type(0.5), C*F*N );
+
+    // plain cross-correlation, compared with "fastCorr"
+    for( c=0; c<C; ++c )
+        for( i=0; i<N; ++i )
+            xn[c][i] = sn[M+i-delay[c]] + vn[c*N+i];
+
+    GCC<Type> cc( C, N, M, "none" );
+    cc.estimate( xn );
+    Type err = 0;
+    for( i=0; i<C; ++i )
+        for( j=0; j<C; ++j )
+            if( i != j )
+            {
+                Vector<Type> x(N), y(N);
+                for( int k=0; k<N; ++k )
+                {
+                    x[k] = xn[i][k];
+                    y[k] = xn[j][k];
+                }
+                Vector<Type> r = fastCorr( x, y ),
+                             g = cc.getCorr( i, j );
+                for( int t=-M; t<=M; ++t )
+                    err = max( err, abs(r[N-1+t]-g[M+t]) );
+            }
+    cout << "max difference with fastCorr : " << err << endl << endl;
+
+    // weighted correlations averaged over frames
+    const char *weights[] = { "none", "phat", "scot", "roth" };
+    cout << setiosflags(ios::fixed) << setprecision(2);
+    cout << "true delays        :";
+    for( i=0; i<C; ++i )
+        for( j=i+1; j<C; ++j )
+            cout << setw(7) << Type(delay[i]-delay[j]);
+    cout << endl;
+
+    for( int w=0; w<4; ++w )
+    {
+        GCC<Type> gcc( C, N, M, weights[w], Type(0.5) );
+        for( f=0; f<F; ++f )
+        {
+            for( c=0; c<C; ++c )
+                for( i=0; i<N; ++i )
+                    xn[c][i] = sn[f*N+M+i-delay[c]] + vn[(c*F+f)*N+i];
+            gcc.estimate( xn );
+        }
+
+        Vector<Type> dn = gcc.getDelays();
+        cout << setw(5) << weights[w] << " delays       :";
+        for( i=0; i<dn.size(); ++i )
+            cout << setw(7) << dn[i];
+        cout << endl;
+    }
+    cout << endl;
+
+    // a short lag window is computed directly
+    GCC<Type> gs( C, N, 4, "phat" );
+    gs.estimate( xn );
+    cout << "delays of (0,1), (0,5), (2,5) in [-4,4] : "
+         << gs.getDelay(0,1) << "  " << gs.getDelay(0,5) << "  "
+         << gs.getDelay(2,5) << endl;
+    cout << "delay of (1,0)                          : "
+         << gs.getDelay(1,0) << endl << endl;
+
+    return 0;
+}
@@ -21,6 +21,7 @@ typedef double  Type;
 const   int     N = 2;
 const   int     M = 2;
 const   int     T = 20;
+const   int     K = 1000;
 
 
 int main()
@@ -45,5 +46,53 @@ int main()
 
     cout << "The theoretical xt should converge to:   " << ytInit << endl;
 
+    // the filter object gives the same estimation
+    KalmanFilter<Type> kf;
+    kf.init( Vector<Type>(N,Type(1.0)), diag(intV) );
+    for( int t=0; t<T; ++t )
+    {
+        kf.predict( A, Q );
+        kf.correct( C, R, yt.getColumn(t) );
+    }
+    cout << "Estimation of xt by KalmanFilter object:   " << kf.getState()
+         << endl;
+
+    // constant velocity model: state (position,velocity), measure position
+    Type dt = Type(0.1);
+    Matrix<Type> Ac(2,2), Cc(1,2), Qc(2,2), Rc(1,1);
+    Ac[0][0] = 1;   Ac[0][1] = dt;  Ac[1][1] = 1;
+    Cc[0][0] = 1;
+    Qc[0][0] = dt*dt*dt/3;  Qc[0][1] = dt*dt/2;
+    Qc[1][0] = dt*dt/2;     Qc[1][1] = dt;
+    Qc *= Type(0.01);
+    Rc[0][0] = Type(0.01);
+
+    // K targets moving with velocity k/K, tracked together
+    KalmanFilter<Type,2,1> *trackers = new KalmanFilter<Type,2,1>[K];
+    for( int k=0; k<K; ++k )
+        trackers[k].init( Vector<Type>(2), eye(2,Type(10.0)) );
+
+    Matrix<Type> Y(K,1);
+    int fails = 0;
+    for( int t=1; t<=10*T; ++t )
+    {
+        for( int k=0; k<K; ++k )
+            Y[k][0] = Type(k)/K * t*dt + Type(0.1)*sin(Type(7*t+k));
+        fails += kalmanBatch( trackers, K, Ac, Cc, Qc, Rc, Y );
+    }
+    cout << "Failed corrections:   " << fails << endl;
+
+    Type maxErr = 0;
+    for( int k=0; k<K; ++k )
+        maxErr = max( maxErr, abs(trackers[k].getState()[1]-Type(k)/K) );
+    cout << "The velocity of the last target:   "
+         << trackers[K-1].getState()[1] << "  (" << Type(K-1)/K << ")" << endl;
+    cout << "Maximum velocity error of " << K << " targets:   " << maxErr
+         << endl;
+    cout << "Covariance of the last target:   "
+         << trackers[K-1].getCovariance() << endl;
+
+    delete []trackers;
+
     return 0;
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 kde_test.cpp
+ *
+ * Binned kernel density estimation testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <kde.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 100000;
+const   int     M = 81;
+
+
+int main()
+{
+    int i, j;
+
+    // a mixture of two Gaussian
+    Vector<Type> xn = randn( 37, Type(0.0), Type(1.0), N );
+    for( i=0; i<N; i+=3 )
+        xn[i] = 4 + xn[i]/2;
+
+    // estimated by one block
+    KDE<Type> kde( Type(-4.0), Type(6.0), M );
+    kde.add( xn );
+    Vector<Type> gn = kde.getGrid(),
+                 fn = kde.getDensity();
+    Type h = kde.getBandwidth();
+
+    // estimated by a stream and merged parts
+    KDE<Type> k1( Type(-4.0), Type(6.0), M ),
+              k2( Type(-4.0), Type(6.0), M );
+    for( i=0; i<N/2; ++i )
+        k1.add( xn[i] );
+    for( i=N/2; i<N; ++i )
+        k2.add( xn[i] );
+    k1.merge( k2 );
+    Vector<Type> fm = k1.getDensity();
+
+    // the exact Gaussian kernel density at some grid points
+    cout << setiosflags(ios::fixed) << setprecision(6);
+    cout << "Density of " << kde.count() << " samples, bandwidth = " << h
+         << endl;
+    cout << "x\t\tdirect\t\tbinned\t\tmerged" << endl;
+    for( j=0; j<M; j+=8 )
+    {
+        Type s = 0;
+        for( i=0; i<N; ++i )
+        {
+            Type u = (gn[j]-xn[i]) / h;
+            s += exp( -u*u/2 );
+        }
+        s /= N*h*sqrt(TWOPI);
+        cout << gn[j] << "\t" << s << "\t" << fn[j] << "\t" << fm[j] << endl;
+    }
+    cout << endl;
+
+    Type area = 0;
+    for( j=0; j<M; ++j )
+        area += fn[j];
+    area *= gn[1]-gn[0];
+    cout << "The area under the density: " << area << endl;
+
+    return 0;
+}
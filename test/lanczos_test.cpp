@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *                               lanczos_test.cpp
+ *
+ * Lanczos class testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <toeplitz.h>
+#include <lanczos.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 100;
+const   int     K = 4;
+
+
+int main()
+{
+    // symmetric Toeplitz matrix of two sinusoids in white noise
+    Vector<Type> rn(N);
+    for( int i=0; i<N; ++i )
+        rn[i] = Type( cos(TWOPI*0.1*i) + 0.5*cos(TWOPI*0.3*i) );
+    rn[0] += Type(0.1);
+    Matrix<Type> A = toeplitz(rn);
+
+    EVD<Type> eig;
+    eig.dec(A);
+    Vector<Type> D = eig.getD();
+
+    cout << setiosflags(ios::fixed) << setprecision(6);
+
+    Lanczos<Type> lcz;
+    lcz.dec( A, K, "largest" );
+    Matrix<Type> V = lcz.getV();
+    Vector<Type> d = lcz.getD();
+    cout << "The " << K << " largest eigenvalues by Lanczos ("
+         << lcz.steps() << " steps) : " << d << endl;
+    cout << "The " << K << " largest eigenvalues by EVD : ";
+    for( int i=0; i<K; ++i )
+        cout << D[N-1-i] << "  ";
+    cout << endl << endl;
+    cout << "norm(A*V - V*D) : " << norm(A*V-V*diag(d)) << endl;
+    cout << "norm(V'*V - I) : "
+         << norm(trMult(V,V)-eye(K,Type(1.0))) << endl << endl;
+
+    // a random symmetric matrix
+    Vector<Type> rs = randu( 7, Type(-1.0), Type(1.0), N*N );
+    Matrix<Type> B(N,N);
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<=i; ++j )
+            B[i][j] = B[j][i] = rs[i*N+j];
+
+    eig.dec(B);
+    D = eig.getD();
+    lcz.dec( B, K, "smallest" );
+    V = lcz.getV();
+    d = lcz.getD();
+    cout << "The " << K << " smallest eigenvalues by Lanczos ("
+         << lcz.steps() << " steps) : " << d << endl;
+    cout << "The " << K << " smallest eigenvalues by EVD : ";
+    for( int i=0; i<K; ++i )
+        cout << D[i] << "  ";
+    cout << endl << endl;
+    cout << "norm(B*V - V*D) : " << norm(B*V-V*diag(d)) << endl << endl;
+
+    // k > n/3, computed by the full decomposition
+    lcz.dec( B, N/2, "largest" );
+    V = lcz.getV();
+    d = lcz.getD();
+    Type err = 0;
+    for( int i=0; i<N/2; ++i )
+        err = max( err, abs(d[i]-D[N-1-i]) );
+    cout << "The " << N/2 << " largest eigenvalues (" << lcz.steps()
+         << " steps), max error : " << err << endl;
+    cout << "norm(B*V - V*D) : " << norm(B*V-V*diag(d)) << endl;
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ *                               levinson_test.cpp
+ *
+ * Levinson, split Levinson and batched Levinson-Durbin algorithms testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <toeplitz.h>
+#include <levinson.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 8;
+const   int     P = 16;
+const   int     K = 1000;
+
+
+int main()
+{
+    int i, j;
+    Type sigma2, sigma2s, err;
+
+    // Toeplitz equations
+    Vector<Type> t(N), b(N);
+    for( i=0; i<N; ++i )
+    {
+        t[i] = Type(1)/(1+i);
+        b[i] = Type(i+1);
+    }
+    Vector<Type> x = levinson( t, b );
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "solution of Toeplitz equations:" << x << endl;
+    cout << "residual:" << toeplitz(t)*x - b << endl;
+
+    // Youle-Walker equations, r(k) = 0.9^k * cos(0.5*k)
+    Vector<Type> rn(P+1);
+    for( i=0; i<=P; ++i )
+        rn[i] = pow( Type(0.9), Type(i) ) * cos( Type(0.5*i) );
+    rn[0] += Type(0.01);
+
+    Vector<Type> ak = levinson( rn, sigma2 );
+    cout << "Levinson-Durbin predictor:" << ak << endl;
+    cout << "sigma2 = " << sigma2 << endl << endl;
+
+    Vector<Type> as(P+1), kn(P), ks(P), work(2*(P+2));
+    levinsonDurbin( P, &rn[0], &ak[0], &kn[0], sigma2 );
+    splitLevinson( P, &rn[0], &as[0], &ks[0], sigma2s, &work[0] );
+    cout << "split Levinson predictor:" << as << endl;
+    cout << "sigma2 = " << sigma2s << endl << endl;
+    cout << "reflection coefficients:" << ks << endl;
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "norm of predictors difference  : " << norm(as-ak) << endl;
+    cout << "norm of reflections difference : " << norm(ks-kn) << endl;
+    cout << "difference of sigma2           : " << abs(sigma2s-sigma2)
+         << endl << endl;
+
+    // batched systems
+    Matrix<Type> R(K,P+1), A(K,P+1), Kn(K,P);
+    Vector<Type> S(K);
+    for( j=0; j<K; ++j )
+    {
+        Type rho = Type(0.5) + Type(0.45*j)/K,
+             w = Type(3.0*j)/K;
+        for( i=0; i<=P; ++i )
+            R[j][i] = pow( rho, Type(i) ) * cos( w*i );
+        R[j][0] += Type(0.01);
+    }
+    levinsonBatch( K, P, (const Type*)R, (Type*)A, (Type*)Kn, &S[0] );
+
+    err = 0;
+    for( j=0; j<K; ++j )
+    {
+        levinsonDurbin( P, R[j], &ak[0], &kn[0], sigma2 );
+        for( i=0; i<=P; ++i )
+            err = max( err, abs(A[j][i]-ak[i]) );
+        for( i=0; i<P; ++i )
+            err = max( err, abs(Kn[j][i]-kn[i]) );
+        err = max( err, abs(S[j]-sigma2) );
+    }
+    cout << "max difference of " << K << " batched systems : " << err
+         << endl << endl;
+
+    return 0;
+}
@@ -58,6 +58,22 @@ int main()
     cout << "The least square solution is (using SVD decomposition) : "
          << svdLsSolver( cA, cb ) << endl;
 
+    // A^H*A with complex off-diagonal entries, solved by complex Cholesky
+    Matrix<Type> D( A.rows(), A.cols() );
+    for( int i=0; i<D.rows(); ++i )
+        for( int j=0; j<D.cols(); ++j )
+            D[i][j] = Type( (i+2*j)%3 ) - 1;
+    cA = complexMatrix( A, D );
+    cout << "The original complex matrix cA : " << cA << endl;
+    cout << "The least square solution is (using generalized inverse) : "
+         << lsSolver( cA, cb ) << endl;
+    cout << "The least square solution is (using QR decomposition) : "
+         << qrLsSolver( cA, cb ) << endl;
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "The difference of the two solutions : "
+         << norm( lsSolver( cA, cb ) - qrLsSolver( cA, cb ) ) << endl << endl;
+    cout << setiosflags(ios::fixed) << setprecision(3);
+
     // undetermined linear equations
     Matrix<Type> At( trT( A ) );
 	b.resize( 3 );
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <random.h>
 #include <lud.h>
 
 
@@ -21,6 +22,7 @@ using namespace splab;
 typedef double  Type;
 const   int     M = 3;
 const   int     N = 4;
+const   int     K = 300;
 
 
 int main()
@@ -83,5 +85,21 @@ int main()
 	    cout << "The cA * inverse(cA) : " << cA*invcA << endl;
 	}
 
+	// a larger matrix factorized by blocks
+	Vector<Type> r = randn( 37, Type(0.0), Type(1.0), K*K );
+	Matrix<Type> bA( K, K, r.begin() ), bPA( K, K );
+	LUD<Type> blu;
+	blu.dec(bA);
+	p = blu.getPivot();
+	for( int i=0; i<K; ++i )
+        bPA.setRow( bA.getRow(p[i]), i );
+
+	cout << resetiosflags(ios::fixed) << setiosflags(ios::scientific)
+	     << setprecision(2);
+	cout << "The norm of P*A - L*U for a " << K << " by " << K
+	     << " matrix : " << norm( bPA - blu.getL()*blu.getU() ) << endl;
+	cout << "The norm of A * inverse(A) - I : "
+	     << norm( bA*blu.solve(eye(K,Type(1))) - eye(K,Type(1)) ) << endl;
+
 	return 0;
 }
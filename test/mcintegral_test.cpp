@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                              mcintegral_test.cpp
+ *
+ * Monte Carlo and quasi-Monte Carlo integration testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <mcintegral.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     D = 6;
+
+
+/**
+ * Sobol's g-function, whose integral over the unit cube is 1.
+ */
+class GFunc
+{
+
+public:
+
+    Type operator()( Vector<Type> &x )
+    {
+        Type y = 1;
+        for( int d=0; d<x.size(); ++d )
+            y *= ( fabs(4*x[d]-2) + d ) / ( 1 + d );
+        return y;
+    }
+
+};
+
+
+int main()
+{
+    GFunc f;
+    Vector<Type> lower( D, Type(0) ),
+                 upper( D, Type(1) );
+
+    const char *methods[3] = { "mc", "sobol", "halton" };
+
+    cout << setiosflags(ios::fixed) << setprecision(8);
+    for( int m=0; m<3; ++m )
+    {
+        MCIntegral<Type, GFunc> mci( lower, upper, methods[m] );
+        cout << "Method: " << methods[m] << endl;
+        cout << "N\t\tvalue\t\terror estimate\ttrue error" << endl;
+        for( int k=0; k<4; ++k )
+        {
+            Type I = mci.integrate( f, int(mci.count()) + (1<<14) );
+            cout << mci.count() << "\t\t" << I << "\t" << mci.getError()
+                 << "\t" << fabs(I-1) << endl;
+        }
+        cout << endl;
+    }
+
+    // on a box, until the error is less than the tolerance
+    Vector<Type> a( D, Type(-1) ),
+                 b( D, Type(1) );
+    MCIntegral<Type, GFunc> box( a, b );
+    Type I = box.integrate( f, Type(1.0e-2), 1<<24 );
+    cout << "The integral over [-1,1]^" << D << " with tolerance 1e-2." << endl;
+    cout << I << " +- " << box.getError() << " by " << box.count()
+         << " points." << endl;
+
+    return 0;
+}
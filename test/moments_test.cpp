@@ -0,0 +1,119 @@
+/*****************************************************************************
+ *                                moments_test.cpp
+ *
+ * Mergeable moments accumulators testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <statistics.h>
+#include <moments.h>
+#include <utilities.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 100000;
+const   int     M = 1000;
+const   int     C = 5;
+
+
+int main()
+{
+    int i, j;
+
+    // a shifted and skewed sequence
+    Vector<Type> xn = randn( 37, Type(0.0), Type(1.0), N );
+    for( i=0; i<N; ++i )
+        xn[i] = 1.0e6 + exp( xn[i] );
+
+    cout << setiosflags(ios::fixed) << setprecision(6);
+    cout << "The whole sequence routines." << endl;
+    cout << mean(xn) << "  " << var(xn) << "  " << skew(xn-mean(xn)) << "  "
+         << kurt(xn-mean(xn)) << endl << endl;
+
+    // a block
+    Moments<Type> mb;
+    mb.add( xn );
+    cout << "Accumulated by one block." << endl;
+    cout << mb.getMean() << "  " << mb.getVar() << "  " << mb.getSkew()
+         << "  " << mb.getKurt() << endl << endl;
+
+    // three parts merged, one of them restored from its state
+    Moments<Type> m1, m2, m3, m4;
+    for( i=0; i<N/3; ++i )
+        m1.add( xn[i] );
+    m2.add( wkeep( xn, N/2-N/3, N/3 ) );
+    m3.add( wkeep( xn, N-N/2, N/2 ) );
+    m4.setState( m3.getState() );
+    m1.merge( m2 );
+    m1.merge( m4 );
+    cout << "Merged by three parts of " << m1.count() << " samples." << endl;
+    cout << m1.getMean() << "  " << m1.getVar() << "  " << m1.getSkew()
+         << "  " << m1.getKurt() << endl << endl;
+
+    // columns of a matrix, two halves merged
+    Matrix<Type> A(M,C);
+    for( j=0; j<C; ++j )
+    {
+        Vector<Type> tmp = randu( 11+j, Type(0.0), Type(j+1.0), M );
+        for( i=0; i<M; ++i )
+            A[i][j] = tmp[i]*tmp[i];
+    }
+
+    ColumnMoments<Type> c1(C), c2(C);
+    Matrix<Type> B(M/2,C);
+    for( i=0; i<M/2; ++i )
+        for( j=0; j<C; ++j )
+            B[i][j] = A[i][j];
+    c1.add( B );
+    for( i=M/2; i<M; ++i )
+    {
+        Vector<Type> row(C);
+        for( j=0; j<C; ++j )
+            row[j] = A[i][j];
+        c2.add( row );
+    }
+    c1.merge( c2 );
+
+    Type err = 0;
+    Vector<Type> cm = c1.getMean(),
+                 cv = c1.getVar(),
+                 cs = c1.getSkew(),
+                 ck = c1.getKurt();
+    for( j=0; j<C; ++j )
+    {
+        Vector<Type> col(M);
+        for( i=0; i<M; ++i )
+            col[i] = A[i][j];
+        Vector<Type> dev = col-mean(col);
+        err = max( err, abs(cm[j]-mean(col)) );
+        err = max( err, abs(cv[j]-var(col)) );
+        err = max( err, abs(cs[j]-skew(dev)) );
+        err = max( err, abs(ck[j]-kurt(dev)) );
+    }
+    cout << "Column means and variances." << endl;
+    cout << cm << cv;
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "maximum error of columns : " << err << endl << endl;
+
+    Moments<float> mf;
+    Vector<float> xf(1000000);
+    for( i=0; i<xf.size(); ++i )
+        xf[i] = float(i%2);
+    for( i=0; i<20; ++i )
+        mf.add( xf );
+    cout << "float samples beyond 2^24 : " << setprecision(10) << mf.count()
+         << ", mean = " << setprecision(4) << mf.getMean() << endl << endl;
+
+    return 0;
+}
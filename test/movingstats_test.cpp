@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *                              movingstats_test.cpp
+ *
+ * Sliding window statistics testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <statistics.h>
+#include <movingstats.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     W = 100;
+const   int     C = 4;
+const   int     N = 2000;
+const   int     K = 37;
+
+
+int main()
+{
+    int c, n, k;
+
+    // a single channel stream input sample by sample
+    Vector<Type> xn = randn( 37, Type(0.0), Type(1.0), N );
+    for( n=0; n<N; ++n )
+        xn[n] = 10 + xn[n]*xn[n]*xn[n];
+
+    MovingMoments<Type> mm( W );
+    MovingMedian<Type> md( W );
+    MovingMinMax<Type> mx( W );
+
+    Type errMean = 0, errVar = 0, errSkew = 0, errKurt = 0,
+         errMid = 0, errMin = 0, errMax = 0;
+    for( n=0; n<N; ++n )
+    {
+        mm.input( xn[n] );
+        md.input( xn[n] );
+        mx.input( xn[n] );
+
+        int L = min( n+1, W );
+        Vector<Type> yn(L);
+        for( k=0; k<L; ++k )
+            yn[k] = xn[n-L+1+k];
+
+        errMean = max( errMean, abs(mm.getMean()-mean(yn)) );
+        errVar = max( errVar, abs(mm.getVar()-var(yn)) );
+        if( L > 2 )
+        {
+            errSkew = max( errSkew, abs(mm.getSkew()-skew(yn)) );
+            errKurt = max( errKurt, abs(mm.getKurt()-kurt(yn)) );
+        }
+        errMid = max( errMid, abs(md.getMedian()-mid(yn)) );
+        errMin = max( errMin, abs(mx.getMin()-min(yn)) );
+        errMax = max( errMax, abs(mx.getMax()-max(yn)) );
+    }
+
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "The last window: mean, variance, skew, kurtosis, median, "
+         << "minimum and maximum." << endl;
+    cout << mm.getMean() << endl << mm.getVar() << endl << mm.getSkew()
+         << endl << mm.getKurt() << endl << md.getMedian() << endl
+         << mx.getMin() << endl << mx.getMax() << endl << endl;
+
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "The maximum errors compared with the whole window routines."
+         << endl;
+    cout << "mean     : " << errMean << endl;
+    cout << "variance : " << errVar << endl;
+    cout << "skew     : " << errSkew << endl;
+    cout << "kurtosis : " << errKurt << endl;
+    cout << "median   : " << errMid << endl;
+    cout << "minimum  : " << errMin << endl;
+    cout << "maximum  : " << errMax << endl << endl;
+
+    // multi-channel streams input block by block
+    Matrix<Type> xc(C,N);
+    for( c=0; c<C; ++c )
+    {
+        Vector<Type> tmp = randu( 11+c, Type(-1.0), Type(1.0), N );
+        for( n=0; n<N; ++n )
+            xc[c][n] = tmp[n];
+    }
+
+    MovingMoments<Type> mmc( W, C );
+    MovingMedian<Type> mdc( W, C );
+    MovingMinMax<Type> mxc( W, C );
+    Type err = 0;
+    for( n=0; n<N; n+=K )
+    {
+        int L = min( K, N-n );
+        Matrix<Type> blk(C,L);
+        for( c=0; c<C; ++c )
+            for( k=0; k<L; ++k )
+                blk[c][k] = xc[c][n+k];
+        mmc.input( blk );
+        mdc.input( blk );
+        mxc.input( blk );
+
+        int M = min( n+L, W );
+        for( c=0; c<C; ++c )
+        {
+            Vector<Type> yn(M);
+            for( k=0; k<M; ++k )
+                yn[k] = xc[c][n+L-M+k];
+            err = max( err, abs(mmc.getMean(c)-mean(yn)) );
+            err = max( err, abs(mmc.getVar(c)-var(yn)) );
+            err = max( err, abs(mdc.getMedian(c)-mid(yn)) );
+            err = max( err, abs(mxc.getMin(c)-min(yn)) );
+            err = max( err, abs(mxc.getMax(c)-max(yn)) );
+        }
+    }
+    cout << "maximum error of " << C << " channels by blocks : " << err
+         << endl << endl;
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*****************************************************************************
+ *                              nlkalman_test.cpp
+ *
+ * Unscented and ensemble Kalman filter testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <kalman.h>
+#include <nlkalman.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 4;
+const   int     M = 2;
+const   int     T = 100;
+const   Type    dt = 0.1;
+
+
+/**
+ * Constant velocity motion in the plane, state (px,py,vx,vy).
+ */
+class Motion
+{
+
+public:
+
+    void operator()( const Type *x, Type *fx )
+    {
+        fx[0] = x[0] + dt*x[2];
+        fx[1] = x[1] + dt*x[3];
+        fx[2] = x[2];
+        fx[3] = x[3];
+    }
+
+};
+
+
+/**
+ * Measure the position directly.
+ */
+class Position
+{
+
+public:
+
+    void operator()( const Type *x, Type *hx )
+    {
+        hx[0] = x[0];
+        hx[1] = x[1];
+    }
+
+};
+
+
+/**
+ * Measure the range and bearing of the target.
+ */
+class RangeBearing
+{
+
+public:
+
+    void operator()( const Type *x, Type *hx )
+    {
+        hx[0] = sqrt( x[0]*x[0] + x[1]*x[1] );
+        hx[1] = atan2( x[1], x[0] );
+    }
+
+};
+
+
+int main()
+{
+    Motion f;
+    Position hp;
+    RangeBearing hr;
+
+    Matrix<Type> A = eye( N, Type(1) ), C(M,N), Q(N,N), R(M,M);
+    A[0][2] = dt;   A[1][3] = dt;
+    C[0][0] = 1;    C[1][1] = 1;
+    Q[2][2] = Type(0.01);   Q[3][3] = Type(0.01);
+    R[0][0] = Type(0.04);   R[1][1] = Type(0.04);
+
+    Vector<Type> x0(N), y(M);
+    x0[0] = 10;    x0[1] = 5;
+    Matrix<Type> P0 = eye( N, Type(1) );
+
+    // for a linear system the UKF is the same as the Kalman filter
+    KalmanFilter<Type> kf;
+    UKF<Type> ukf;
+    kf.init( x0, P0 );
+    ukf.init( x0, P0 );
+    for( int t=1; t<=T; ++t )
+    {
+        y[0] = 10 + t*dt + Type(0.2)*sin(Type(3*t));
+        y[1] = 5 - t*dt + Type(0.2)*cos(Type(5*t));
+        kf.predict( A, Q );
+        kf.correct( C, R, y );
+        ukf.predict( f, Q );
+        ukf.correct( hp, R, y );
+    }
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "linear system, Kalman filter:\t" << kf.getState() << endl;
+    cout << "linear system, UKF:\t\t" << ukf.getState() << endl;
+    cout << "norm of covariance difference:\t"
+         << norm(kf.getCovariance()-ukf.getCovariance()) << endl << endl;
+
+    // range and bearing measurements of a target with velocity (1,-1)
+    Matrix<Type> Rr(M,M);
+    Rr[0][0] = Type(0.01);   Rr[1][1] = Type(1.0e-4);
+
+    UKF<Type> ukf2;
+    EnKF<Type> enkf( 500 );
+    ukf2.init( x0, P0 );
+    enkf.init( x0, P0 );
+    for( int t=1; t<=T; ++t )
+    {
+        Type px = 10 + t*dt,
+             py = 5 - t*dt;
+        y[0] = sqrt(px*px+py*py) + Type(0.1)*sin(Type(3*t));
+        y[1] = atan2(py,px) + Type(0.01)*cos(Type(5*t));
+
+        ukf2.predict( f, Q );
+        ukf2.correct( hr, Rr, y );
+        enkf.predict( f, Q );
+        enkf.correct( hr, Rr, y );
+    }
+    cout << "true state:\t\t" << 10+T*dt << "\t" << 5-T*dt << "\t"
+         << Type(1) << "\t" << Type(-1) << endl;
+    cout << "UKF estimation:\t\t";
+    for( int i=0; i<N; ++i )
+        cout << ukf2.getState()[i] << "\t";
+    cout << endl;
+    cout << "EnKF estimation:\t";
+    for( int i=0; i<N; ++i )
+        cout << enkf.getState()[i] << "\t";
+    cout << endl << endl;
+
+    cout << "UKF covariance:" << ukf2.getCovariance() << endl;
+    cout << "EnKF covariance (" << enkf.members() << " members):"
+         << enkf.getCovariance() << endl;
+
+    return 0;
+}
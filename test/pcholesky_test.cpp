@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+
+/*****************************************************************************
+ *                              pcholesky_test.cpp
+ *
+ * Packed Cholesky decomposition testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <pcholesky.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 300;
+
+
+Type maxDiff( const Matrix<Type> &A, const Matrix<Type> &B )
+{
+    Type d = 0;
+    for( int i=0; i<A.rows(); ++i )
+        for( int j=0; j<A.cols(); ++j )
+            d = max( d, abs(A[i][j]-B[i][j]) );
+    return d;
+}
+
+
+int main()
+{
+    Vector<Type> r = randn( 37, Type(0.0), Type(1.0), N*N );
+    Matrix<Type> G( N, N, r.begin() ),
+                 A = G*trT(G);
+    for( int i=0; i<N; ++i )
+        A[i][i] += N;
+
+    Vector<Type> ap( N*(N+1)/2 );
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<=i; ++j )
+            ap[i*(i+1)/2+j] = A[i][j];
+
+    Vector<Type> b = randn( 38, Type(0.0), Type(1.0), N );
+    Vector<Type> s = randn( 39, Type(0.0), Type(1.0), N*5 );
+    Matrix<Type> B( N, 5, s.begin() );
+
+    PackedCholesky<Type> pc;
+    Cholesky<Type> cho;
+    cho.dec(A);
+
+    cout << setiosflags(ios::scientific) << setprecision(2);
+    for( int k=0; k<2; ++k )
+    {
+        if( k == 0 )
+        {
+            cout << "From the full matrix (N = " << N << ")" << endl;
+            pc.dec(A);
+        }
+        else
+        {
+            cout << "From the lower triangle packed by rows" << endl;
+            pc.dec( N, ap );
+        }
+
+        if( !pc.isSpd() )
+            cout << "Factorization was not complete." << endl;
+        else
+        {
+            Matrix<Type> L = pc.getL();
+            cout << "max|A - L*L^T|         : "
+                 << maxDiff( A, L*trT(L) ) << endl;
+            cout << "max|L - Cholesky L|    : "
+                 << maxDiff( L, cho.getL() ) << endl;
+
+            Vector<Type> lp = pc.getPacked();
+            Type d = 0;
+            for( int i=0; i<N; ++i )
+                for( int j=0; j<=i; ++j )
+                    d = max( d, abs(lp[i*(i+1)/2+j]-L[i][j]) );
+            cout << "max|packed L - L|      : " << d << endl;
+
+            Vector<Type> x = pc.solve(b);
+            cout << "||A*x - b||            : " << norm( A*x-b )
+                 << endl;
+
+            Matrix<Type> X = pc.solve(B);
+            cout << "max|A*X - B|           : " << maxDiff( A*X, B )
+                 << endl;
+        }
+        cout << endl;
+    }
+
+    // leading submatrices of A, within one tile and one row past it
+    int sizes[3] = { 5, 128, 129 };
+    for( int k=0; k<3; ++k )
+    {
+        int n = sizes[k];
+        Matrix<Type> An( n, n );
+        Vector<Type> bn( n );
+        for( int i=0; i<n; ++i )
+        {
+            for( int j=0; j<n; ++j )
+                An[i][j] = A[i][j];
+            bn[i] = b[i];
+        }
+        pc.dec(An);
+        Matrix<Type> L = pc.getL();
+        cout << "N = " << n << ",  max|A - L*L^T| : "
+             << maxDiff( An, L*trT(L) ) << ",  ||A*x - b|| : "
+             << norm( An*pc.solve(bn)-bn ) << endl;
+    }
+    cout << endl;
+
+    A[N-1][N-1] = -1;
+    pc.dec(A);
+    cout << "With A(N,N) = -1, isSpd : " << boolalpha << pc.isSpd()
+         << endl << endl;
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ *                                philox_test.cpp
+ *
+ * Counter-based random number generator testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <philox.h>
+#include <statistics.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double          Type;
+typedef Philox::uint64  uint64;
+const   int             N = 1000000;
+
+
+int main()
+{
+    int i;
+
+    // known answers of Philox4x32-10 for zero key and counter
+    Philox rg;
+    uint64 x0 = rg.random(),
+           x1 = rg.random();
+    cout << hex << setfill('0');
+    cout << "the first counter : " << setw(8) << (x0 & 0xFFFFFFFFU) << " "
+         << setw(8) << (x0 >> 32) << " " << setw(8) << (x1 & 0xFFFFFFFFU)
+         << " " << setw(8) << (x1 >> 32) << endl;
+    cout << "expected          : 6627e8d5 e169c58d bc57ac4c 9b00dbd8"
+         << endl << endl;
+    cout << dec << setfill(' ');
+
+    // jumping ahead and bulk fill give the same numbers as one by one
+    Philox g1( 2011, 7 ), g2( 2011, 7 );
+    Vector<uint64> xn(N);
+    g1.random( &xn[0], N );
+    g2.jump( N-3 );
+    bool same = true;
+    for( i=N-3; i<N; ++i )
+        same = same && ( g2.random() == xn[i] );
+    cout << "jump ahead agrees with bulk fill : "
+         << ( same ? "yes" : "no" ) << endl;
+
+    Philox g3( 2011, 7 );
+    g3.jump( 5 );
+    Vector<uint64> yn(1000);
+    g3.random( &yn[0], 1000 );
+    same = true;
+    for( i=0; i<1000; ++i )
+        same = same && ( yn[i] == xn[5+i] );
+    cout << "fill from an odd position agrees : "
+         << ( same ? "yes" : "no" ) << endl;
+
+    Philox s0 = g1.split( 0 ),
+           s1 = g1.split( 1 );
+    cout << "first outputs of streams 0 and 1 : " << s0.random() << "  "
+         << s1.random() << endl << endl;
+
+    // uniform and normal numbers
+    Philox g( 37 );
+    Vector<Type> un(N), vn(N);
+    g.uniform( un );
+    g.normal( vn, Type(1), Type(2) );
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "uniform (0,1) : mean = " << mean(un) << ", variance = "
+         << var(un) << ", min = " << min(un) << ", max = " << max(un)
+         << endl;
+    cout << "normal (1,2)  : mean = " << mean(vn) << ", variance = "
+         << var(vn) << ", skew = " << skew(vn) << ", kurtosis = "
+         << kurt(vn) << endl;
+    cout << "position after the fills : " << g.getPosition() << endl << endl;
+
+    return 0;
+}
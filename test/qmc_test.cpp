@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                                 qmc_test.cpp
+ *
+ * Low-discrepancy sequences testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <qmc.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     D = 4;
+const   int     N = 8;
+const   int     M = 1 << 16;
+
+
+int main()
+{
+    int i, j;
+    Vector<Type> x(D);
+
+    Sobol sobol(D);
+    Halton halton(D);
+    cout << setiosflags(ios::fixed) << setprecision(6);
+    cout << "The first points of Sobol and Halton sequences." << endl;
+    for( i=0; i<N; ++i )
+    {
+        sobol.next( x );
+        for( j=0; j<D; ++j )
+            cout << x[j] << "  ";
+        cout << "|  ";
+        halton.next( x );
+        for( j=0; j<D; ++j )
+            cout << x[j] << "  ";
+        cout << endl;
+    }
+    cout << endl;
+
+    // jump ahead and compare with the generated points
+    Sobol s1(D), s2(D);
+    s1.scramble( 2011 );
+    s2.scramble( 2011 );
+    Matrix<Type> X = s1.generate<Type>( M );
+    s2.setPosition( M-1 );
+    s2.next( x );
+    cout << "The last point by generation and jumping ahead." << endl;
+    for( j=0; j<D; ++j )
+        cout << X[M-1][j] << "  ";
+    cout << endl;
+    for( j=0; j<D; ++j )
+        cout << x[j] << "  ";
+    cout << endl << endl;
+
+    // each coordinate of 2^m points hits every cell of width 2^-m once
+    Vector<int> hits(M);
+    int bad = 0;
+    for( j=0; j<D; ++j )
+    {
+        hits = 0;
+        for( i=0; i<M; ++i )
+            hits[int(X[i][j]*M)]++;
+        for( i=0; i<M; ++i )
+            if( hits[i] != 1 )
+                bad++;
+    }
+    cout << "The empty or doubly hit cells of scrambled Sobol points: "
+         << bad << endl << endl;
+
+    // the mean of x1*x2*...*xD is 2^-D
+    Halton h1(D);
+    h1.scramble( 2011 );
+    Matrix<Type> Y = h1.generate<Type>( M );
+    Type ms = 0,
+         mh = 0;
+    for( i=0; i<M; ++i )
+    {
+        Type ps = 1,
+             ph = 1;
+        for( j=0; j<D; ++j )
+        {
+            ps *= X[i][j];
+            ph *= Y[i][j];
+        }
+        ms += ps;
+        mh += ph;
+    }
+    cout << setprecision(8);
+    cout << "The mean of the products of coordinates (exact "
+         << 1.0/(1<<D) << ")." << endl;
+    cout << ms/M << "  " << mh/M << endl;
+
+    return 0;
+}
@@ -60,5 +60,48 @@ int main()
 	else
         cout << " The matrix is rank deficient! " << endl;
 
+    // sliding window of the rows of [A, b]: the first row leaves, [1 4 16 1]
+    // enters, R(0:N-1,N) = transpose(Q)*b
+    Matrix<Type> Ab( M, N+1 );
+    for( int i=0; i<M; ++i )
+    {
+        for( int j=0; j<N; ++j )
+            Ab[i][j] = A[i][j];
+        Ab[i][N] = b[i];
+    }
+
+    Vector<Type> in(N+1), out(N+1);
+    in[0] = 1;  in[1] = 4;  in[2] = 16;  in[3] = 1;
+    for( int j=0; j<=N; ++j )
+        out[j] = Ab[0][j];
+
+    qr.dec( Ab );
+    qr.insertRow( in );
+    qr.deleteRow( out );
+    R = qr.getR();
+    cout << "The updated R of [A, b] : " << R << endl;
+
+    for( int j=0; j<=N; ++j )
+        Ab[0][j] = in[j];
+    qr.dec( Ab );
+    cout << "The R of [A, b] by decomposition : " << qr.getR() << endl;
+
+    Vector<Type> x(N);
+    for( int k=N-1; k>=0; --k )
+    {
+        x[k] = R[k][N];
+        for( int j=k+1; j<N; ++j )
+            x[k] -= R[k][j]*x[j];
+        x[k] /= R[k][k];
+    }
+    cout << "The least squares solution of the new window : " << x << endl;
+
+    for( int j=0; j<N; ++j )
+        A[0][j] = in[j];
+    b[0] = in[N];
+    qr.dec( A );
+    cout << "The solution by decomposition of the new window : "
+         << qr.solve(b) << endl;
+
 	return 0;
 }
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *                                sampler_test.cpp
+ *
+ * Normal, exponential, Poisson and binomial samplers testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <sampler.h>
+#include <statistics.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 1000000;
+
+
+template <typename T>
+void moments( const char *name, const Vector<T> &xn )
+{
+    Vector<Type> yn(xn.size());
+    for( int i=0; i<xn.size(); ++i )
+        yn[i] = Type( xn[i] );
+
+    cout << name << "mean = " << setw(9) << mean(yn) << ", variance = "
+         << setw(9) << var(yn) << ", skew = " << setw(7) << skew(yn)
+         << ", kurtosis = " << setw(7) << kurt(yn) << endl;
+}
+
+
+int main()
+{
+    int i, cnt;
+    Sampler sp( 2011 );
+
+    Vector<Type> xn(N);
+    Vector<int> kn(N);
+
+    cout << setiosflags(ios::fixed) << setprecision(4);
+
+    // normal: skew 0, kurtosis 0, P(|x|>4) = 6.334e-5
+    sp.normal( xn );
+    moments( "normal(0,1)             : ", xn );
+    for( cnt=0, i=0; i<N; ++i )
+        cnt += ( abs(xn[i]) > 4 );
+    cout << "samples of |x| > 4 : " << cnt << " (63.3 expected)" << endl;
+    for( i=0; i<N; ++i )
+        xn[i] = sp.normal();
+    moments( "normal(0,1) one by one  : ", xn );
+    sp.normal( xn, Type(3), Type(0.5) );
+    moments( "normal(3,0.5)           : ", xn );
+    cout << endl;
+
+    // exponential: skew 2, kurtosis 6
+    sp.exponential( xn );
+    moments( "exponential(1)          : ", xn );
+    for( i=0; i<N; ++i )
+        xn[i] = sp.exponential();
+    moments( "exponential one by one  : ", xn );
+    sp.exponential( xn, Type(2) );
+    moments( "exponential(2)          : ", xn );
+    cout << endl;
+
+    // Poisson: mean = variance = lambda, skew = lambda^(-1/2)
+    sp.poisson( kn, 3.5 );
+    moments( "Poisson(3.5)            : ", kn );
+    sp.poisson( kn, 100.0 );
+    moments( "Poisson(100)            : ", kn );
+    for( i=0; i<N; ++i )
+        kn[i] = sp.poisson( 1000.0 );
+    moments( "Poisson(1000)           : ", kn );
+    cout << endl;
+
+    // binomial: mean = n*p, variance = n*p*(1-p)
+    sp.binomial( kn, 20, 0.2 );
+    moments( "binomial(20,0.2)        : ", kn );
+    sp.binomial( kn, 1000, 0.3 );
+    moments( "binomial(1000,0.3)      : ", kn );
+    for( i=0; i<N; ++i )
+        kn[i] = sp.binomial( 500, 0.9 );
+    moments( "binomial(500,0.9)       : ", kn );
+    cout << endl;
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*****************************************************************************
+ *                              srkalman_test.cpp
+ *
+ * Square-root Kalman filter testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <kalman.h>
+#include <srkalman.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+const   int     N = 3;
+const   int     T = 20000;
+
+
+/**
+ * Constant acceleration model with position measurement.
+ */
+template <typename Type>
+void model( Matrix<Type> &A, Matrix<Type> &C, Matrix<Type> &Q,
+            Matrix<Type> &R )
+{
+    Type dt = Type(0.01);
+    A = eye( N, Type(1) );
+    A[0][1] = dt;   A[0][2] = dt*dt/2;   A[1][2] = dt;
+    C = Type(0);
+    C[0][0] = 1;
+    Q = Type(0);
+    Q[2][2] = Type(1.0e-6);
+    R = Type(1.0e-6);
+}
+
+
+int main()
+{
+    Matrix<double> Ad(N,N), Cd(1,N), Qd(N,N), Rd(1,1);
+    Matrix<float>  Af(N,N), Cf(1,N), Qf(N,N), Rf(1,1);
+    model( Ad, Cd, Qd, Rd );
+    model( Af, Cf, Qf, Rf );
+
+    KalmanFilter<double> kd;
+    KalmanFilter<float> kf;
+    SRKalmanFilter<double> sd;
+    SRKalmanFilter<float> sf;
+    kd.init( Vector<double>(N), eye(N,1.0) );
+    kf.init( Vector<float>(N), eye(N,1.0f) );
+    sd.init( Vector<double>(N), eye(N,1.0) );
+    sf.init( Vector<float>(N), eye(N,1.0f) );
+
+    // a target moving with constant acceleration 0.5
+    int fails = 0;
+    for( int t=1; t<=T; ++t )
+    {
+        double s = 0.25 * (0.01*t)*(0.01*t) + 1.0e-3*sin(7.0*t);
+        float y = float(s);
+
+        kd.predict( Ad, Qd );
+        kd.correct( Cd, Rd, &s );
+        sd.predict( Ad, Qd );
+        sd.correct( Cd, Rd, &s );
+        sf.predict( Af, Qf );
+        sf.correct( Cf, Rf, &y );
+        kf.predict( Af, Qf );
+        if( !kf.correct( Cf, Rf, &y ) )
+            fails++;
+
+        if( t%(T/5) == 0 )
+        {
+            cout << setiosflags(ios::fixed) << setprecision(6)
+                 << "t = " << t << ",  acceleration (double / SR double / "
+                 << "SR float / float):  " << kd.getState()[2] << "  "
+                 << sd.getState()[2] << "  " << sf.getState()[2] << "  "
+                 << kf.getState()[2] << endl;
+        }
+    }
+    cout << endl;
+
+    cout << resetiosflags(ios::fixed) << setiosflags(ios::scientific)
+         << setprecision(4);
+    cout << "covariance of the double precision filter:"
+         << kd.getCovariance() << endl;
+    cout << "covariance of the square-root filter:"
+         << sd.getCovariance() << endl;
+    cout << "covariance of the single precision square-root filter:"
+         << sf.getCovariance() << endl;
+    cout << "covariance of the single precision filter:"
+         << kf.getCovariance() << endl;
+    cout << "failed corrections of the single precision filter:  " << fails
+         << endl << endl;
+
+    // piecewise constant jerk: Q = g*g' is singular, and its rounding
+    // errors leave slightly negative pivots in single precision
+    float dt = 0.01f,
+          g[N] = { dt*dt*dt/6, dt*dt/2, dt };
+    for( int i=0; i<N; ++i )
+        for( int j=0; j<N; ++j )
+            Qf[i][j] = 1.0e-2f * g[i]*g[j];
+
+    // the factors of the constant Q and R are computed once
+    Matrix<float> Qs(N,N), Rs(1,1);
+    bool good = lowerCholesky( N, (const float*)Qf, (float*)Qs ) &&
+                lowerCholesky( 1, (const float*)Rf, (float*)Rs );
+
+    const int K = 4;
+    SRKalmanFilter<float> sp, ss, batch[K];
+    sp.init( Vector<float>(N), eye(N,1.0f) );
+    ss.init( Vector<float>(N), eye(N,1.0f) );
+    for( int k=0; k<K; ++k )
+        batch[k].init( Vector<float>(N), eye(N,1.0f) );
+
+    Matrix<float> Y(K,1);
+    bool ok[K];
+    int batchFails = 0;
+    for( int t=1; t<=T; ++t )
+    {
+        float y = float( 0.25 * (0.01*t)*(0.01*t) + 1.0e-3*sin(7.0*t) );
+        good = sp.predict( Af, Qf ) && good;
+        good = sp.correct( Cf, Rf, &y ) && good;
+        ss.predictSqrt( Af, Qs );
+        good = ss.correctSqrt( Cf, Rs, &y ) && good;
+
+        for( int k=0; k<K; ++k )
+            Y[k][0] = y;
+        batchFails += srKalmanBatch( batch, K, Af, Cf, Qf, Rf, Y, ok );
+    }
+
+    cout << resetiosflags(ios::scientific) << setiosflags(ios::fixed)
+         << setprecision(6);
+    cout << "singular process noise, acceleration (factors at each step / "
+         << "given factors / batch):  " << sp.getState()[2] << "  "
+         << ss.getState()[2] << "  " << batch[K-1].getState()[2] << endl;
+    cout << "all steps succeeded:  " << ( good ? "yes" : "no" )
+         << ",  failed batch steps:  " << batchFails << endl;
+
+    return 0;
+}
@@ -30,6 +30,17 @@ int main()
     cout << setiosflags(ios::fixed) << setprecision(4);
     cout << "The minimum maximum and median value of the sequence." << endl;
     cout << min(xn) << endl << max(xn) << endl << mid(xn) <<endl << endl;
+
+    Vector<Type> sn(xn), pn(5);
+    quickSort( sn, 0, N-1 );
+    pn[0] = 0.0;    pn[1] = 0.01;   pn[2] = 0.25;   pn[3] = 0.5;    pn[4] = 1.0;
+    cout << "The median, quantiles and percentile of the sequence." << endl;
+    cout << median(xn) << "  " << (sn[N/2-1]+sn[N/2])/2 << endl;
+    cout << quantile(xn,pn) << endl;
+    for( int i=0; i<pn.size(); ++i )
+        cout << quantile(xn,pn[i]) << "  ";
+    cout << endl << percentile(xn,Type(99.0)) << "  "
+         << sn[989] + 0.01*(sn[990]-sn[989]) << endl << endl;
     cout << "The mean, variance and standard variance of the sequence." << endl;
     cout << mean(xn) << endl << var(xn) << endl << stdVar(xn) << endl << endl;
 
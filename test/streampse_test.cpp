@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *                              streampse_test.cpp
+ *
+ * Streaming Welch power spectrum estimator testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <vectormath.h>
+#include <random.h>
+#include <classicalpse.h>
+#include <streampse.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 1000;
+const   int     M = 64;
+const   int     K = 24;
+const   int     L = 128;
+
+
+int main()
+{
+    /******************************* [ signal ] ******************************/
+    Type amp1 = Type(1.0),
+         amp2 = Type(0.5);
+    Type f1 = Type(0.1),
+         f2 = Type(0.3);
+    Vector<Type> tn = linspace(Type(0), Type(N-1), N );
+    Vector<Type> sn = amp1*sin(TWOPI*f1*tn) + amp2*sin(TWOPI*f2*tn) +
+                      randn( 37, Type(0), Type(0.1), N );
+    Vector<Type> wn = hamming( M, Type(1.0) );
+
+    /************************* [ reference estimation ] **********************/
+    Vector<Type> Pw = welchPSE( sn, wn, K, L );
+    Vector<Type> Pb = bartlettPSE( sn, M, L );
+
+    /************************* [ streaming estimation ] **********************/
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    StreamPSE<Type> welch( wn, K, L ),
+                    bartlett( rectangle(M,Type(1)), M, L ),
+                    tracker( wn, K, L, Type(0.1) );
+
+    // blocks of irregular size
+    int pos = 0, len = 1;
+    while( pos < N )
+    {
+        int n = min( len, N-pos );
+        Vector<Type> block = wkeep( sn, n, pos );
+        welch.input( block );
+        bartlett.input( block );
+        tracker.input( block );
+
+        pos += n;
+        len = (len*7+3) % 97 + 1;
+    }
+
+    cout << "Segments of streaming Welch:    " << welch.segments() << endl;
+    cout << "Segments of streaming Bartlett: " << bartlett.segments()
+         << endl << endl;
+    cout << "Relative error of streaming Welch:    "
+         << norm(welch.getPSD()-Pw) / norm(Pw) << endl;
+    cout << "Relative error of streaming Bartlett: "
+         << norm(bartlett.getPSD()-Pb) / norm(Pb) << endl << endl;
+
+    Vector<Type> Pe = tracker.getPSD();
+    cout << "Exponentially averaged PSD at f1 and f2:  "
+         << Pe[int(f1*L)] << "\t" << Pe[int(f2*L)] << endl;
+    cout << "Welch PSD at f1 and f2:                   "
+         << Pw[int(f1*L)] << "\t" << Pw[int(f2*L)] << endl;
+
+    return 0;
+}
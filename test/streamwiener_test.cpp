@@ -0,0 +1,122 @@
+/*****************************************************************************
+ *                             streamwiener_test.cpp
+ *
+ * Streaming Wiener filter testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <wiener.h>
+#include <streamwiener.h>
+#include <random.h>
+#include <vectormath.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 1024;
+const   int     W = 200;
+const   int     fOrder = 8;
+const   int     pOrder = 3;
+
+
+int main()
+{
+    int i, k, n;
+
+    // the same as "wienerFilter" with lambda = 1
+    Vector<Type> tn(N), dn(N), vn(N), xn(N);
+    tn = linspace( Type(0.0), Type(2*TWOPI), N );
+    dn = sin(tn);
+    vn = randn( 37, Type(0.0), Type(1.0), N );
+    xn = dn + vn;
+
+    StreamWiener<Type> sw( fOrder );
+    for( i=0; i<N; i+=100 )
+    {
+        int len = min( 100, N-i );
+        sw.input( wkeep(xn,len,i), wkeep(dn,len,i) );
+        sw.getFilter();
+    }
+    Vector<Type> hn = wienerFilter( xn, dn, fOrder );
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "streaming Wiener filter:" << sw.getFilter() << endl;
+    cout << resetiosflags(ios::fixed) << setprecision(4);
+    cout << "difference with wienerFilter : "
+         << norm(sw.getFilter()-hn) << endl << endl;
+
+    Vector<Type> sn(N);
+    for( i=0; i<N; ++i )
+        sn[i] = sin( Type(i*TWOPI/10) ) + Type(0.1)*vn[i];
+    StreamWiener<Type> sp( pOrder );
+    sp.input( sn );
+    cout << "difference with wienerPredictor : "
+         << norm(sp.getPredictor()-wienerPredictor(sn,pOrder))
+         << endl << endl;
+
+    // sliding window, compared with the lags of the last W samples
+    StreamWiener<Type> ss( fOrder, Type(1), W );
+    Type err = 0;
+    for( n=0; n<N; ++n )
+    {
+        ss.input( xn[n], dn[n] );
+        if( n%97 == 0 || n == N-1 )
+        {
+            Vector<Type> rn(fOrder+1), cn(fOrder+1),
+                         rs = ss.getAutoCorr(),
+                         cs = ss.getCrossCorr();
+            for( k=0; k<=fOrder; ++k )
+            {
+                int cnt = 0;
+                for( i=max(0,n-W+1); i<=n; ++i )
+                    if( i-k >= 0 )
+                    {
+                        rn[k] += xn[i]*xn[i-k];
+                        cn[k] += dn[i]*xn[i-k];
+                        cnt++;
+                    }
+                rn[k] /= cnt;
+                cn[k] /= cnt;
+            }
+            err = max( err, norm(rn-rs)+norm(cn-cs) );
+        }
+    }
+    cout << "sliding window lags error : " << err << endl;
+    Vector<Type> rn = ss.getAutoCorr(),
+                 cn = ss.getCrossCorr();
+    cout << "sliding window filter error : "
+         << norm(ss.getFilter()-levinson(rn,cn)) << endl << endl;
+
+    // tracking a changing system by exponential window
+    Vector<Type> h1(fOrder+1), h2(fOrder+1);
+    for( k=0; k<=fOrder; ++k )
+    {
+        h1[k] = Type(1)/(k+1);
+        h2[k] = ( k%2 == 0 ) ? Type(0.5) : Type(-0.5);
+    }
+    StreamWiener<Type> se( fOrder, Type(0.995) );
+    Vector<Type> un = randn( 11, Type(0.0), Type(1.0), 2*N );
+    for( n=0; n<2*N; ++n )
+    {
+        Vector<Type> &h = ( n < N ) ? h1 : h2;
+        Type y = 0;
+        for( k=0; k<=fOrder && k<=n; ++k )
+            y += h[k]*un[n-k];
+        se.input( un[n], y );
+        if( n == N-1 )
+            cout << "misalignment of system 1 : "
+                 << norm(se.getFilter()-h1)/norm(h1) << endl;
+    }
+    cout << "misalignment of system 2 : "
+         << norm(se.getFilter()-h2)/norm(h2) << endl << endl;
+
+    return 0;
+}
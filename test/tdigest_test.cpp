@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+/*****************************************************************************
+ *                               tdigest_test.cpp
+ *
+ * Streaming quantile sketch testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <statistics.h>
+#include <tdigest.h>
+#include <utilities.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 200000;
+const   int     M = 7;
+
+
+int main()
+{
+    int i;
+    Type p[M] = { 0.0, 0.001, 0.01, 0.5, 0.99, 0.999, 1.0 };
+    Vector<Type> pn( M, p );
+
+    Vector<Type> xn = randn( 37, Type(0.0), Type(1.0), N );
+    for( i=0; i<N; ++i )
+        xn[i] = exp( xn[i] );
+
+    // the exact quantiles
+    Vector<Type> qn = quantile( xn, pn );
+
+    // one digest of the whole stream
+    TDigest<Type> td;
+    td.add( xn );
+
+    // four digests of parts merged
+    TDigest<Type> t0, t1, t2, t3;
+    for( i=0; i<N; ++i )
+        switch( i%4 )
+        {
+            case 0: t0.add( xn[i] ); break;
+            case 1: t1.add( xn[i] ); break;
+            case 2: t2.add( xn[i] ); break;
+            default: t3.add( xn[i] );
+        }
+    t0.merge( t1 );
+    t0.merge( t2 );
+    t0.merge( t3 );
+
+    cout << setiosflags(ios::fixed) << setprecision(6);
+    cout << "Digest of " << td.count() << " samples by " << td.size()
+         << " centroids, merged by " << t0.size() << " centroids." << endl;
+    cout << "p\t\texact\t\tdigest\t\tmerged" << endl;
+    for( i=0; i<M; ++i )
+        cout << pn[i] << "\t" << qn[i] << "\t" << td.quantile(pn[i]) << "\t"
+             << t0.quantile(pn[i]) << endl;
+    cout << endl;
+
+    cout << "The 50th and 99th percentiles." << endl;
+    cout << percentile(xn,Type(50)) << "\t" << td.percentile(50) << endl;
+    cout << percentile(xn,Type(99)) << "\t" << td.percentile(99) << endl;
+    cout << endl;
+
+    cout << "The CDF at the exact quantiles." << endl;
+    for( i=1; i<M-1; ++i )
+        cout << pn[i] << "\t" << td.cdf(qn[i]) << endl;
+    cout << endl;
+
+    // a short stream is kept exactly
+    TDigest<Type> ts;
+    Vector<Type> yn = wkeep( xn, 11, 0 );
+    ts.add( yn );
+    cout << "A short stream." << endl;
+    for( i=0; i<M; ++i )
+        cout << quantile(yn,pn[i]) << "\t" << ts.quantile(pn[i]) << endl;
+
+    return 0;
+}
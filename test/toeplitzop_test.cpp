@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *                              toeplitzop_test.cpp
+ *
+ * Implicit Toeplitz operator testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <toeplitz.h>
+#include <toeplitzop.h>
+#include <pcgsolver.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     N = 300;
+const   int     M = 20000;
+
+
+int main()
+{
+    // compare with the explicit Toeplitz matrix
+    Vector<Type> cn(N), rn(N), x(N), y(N), z(N);
+    for( int i=0; i<N; ++i )
+    {
+        cn[i] = Type(1)/(1+i);
+        rn[i] = cos(Type(i));
+        x[i] = sin(Type(i*i));
+    }
+
+    ToeplitzOperator<Type> T( cn, rn );
+    Matrix<Type> Tm = toeplitz( cn, rn );
+
+    T.multiply( x, y );
+    cout << setiosflags(ios::scientific) << setprecision(4);
+    cout << "norm(T*x - toeplitz(cn,rn)*x) :   " << norm(y-Tm*x) << endl;
+    T.trMultiply( x, y );
+    cout << "norm(T'*x - trT(toeplitz(cn,rn))*x) :   "
+         << norm(y-trMult(Tm,x)) << endl;
+
+    // the same operator object for the symmetric matrix of rn
+    T.assign( rn );
+    T.multiply( x, y );
+    cout << "norm(T*x - toeplitz(rn)*x) after assign :   "
+         << norm(y-toeplitz(rn)*x) << endl << endl;
+
+    // a large symmetric positive definite system, the auto-correlation of
+    // an AR(1) process, which can't be formed explicitly
+    Vector<Type> rm(M), b(M), xn;
+    for( int i=0; i<M; ++i )
+    {
+        rm[i] = pow( Type(0.9), Type(i) );
+        b[i] = cos(Type(i)/100);
+    }
+    rm[0] += Type(0.01);
+
+    ToeplitzOperator<Type> R( rm );
+    IdentityPreconditioner<Type> I;
+    CirculantPreconditioner<Type> S( R, "strang" ),
+                                  C( R, "chan" );
+
+    int itr;
+    Vector<Type> res(M);
+    itr = pcgSolver( R, I, b, xn );
+    R.multiply( xn, res );
+    cout << "n = " << M << endl;
+    cout << "CG without preconditioner:   " << itr << " iterations,  "
+         << "relative residual " << norm(b-res)/norm(b) << endl;
+
+    xn.resize(0);
+    itr = pcgSolver( R, S, b, xn );
+    R.multiply( xn, res );
+    cout << "CG with Strang preconditioner:   " << itr << " iterations,  "
+         << "relative residual " << norm(b-res)/norm(b) << endl;
+
+    xn.resize(0);
+    itr = pcgSolver( R, C, b, xn );
+    R.multiply( xn, res );
+    cout << "CG with Chan preconditioner:   " << itr << " iterations,  "
+         << "relative residual " << norm(b-res)/norm(b) << endl;
+
+    return 0;
+}
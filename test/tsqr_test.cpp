@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2008-2011 Zhang Ming (M. Zhang), zmjerry@163.com
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 2 or any later version.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details. A copy of the GNU General Public License is available at:
+ * http://www.fsf.org/licensing/licenses
+ */
+
+
+
+
+/*****************************************************************************
+ *                                tsqr_test.cpp
+ *
+ * TSQR class testing.
+ *
+ * Zhang Ming, 2011-01, Xi'an Jiaotong University.
+ *****************************************************************************/
+
+
+#define BOUNDS_CHECK
+
+#include <iostream>
+#include <iomanip>
+#include <random.h>
+#include <tsqr.h>
+
+
+using namespace std;
+using namespace splab;
+
+
+typedef double  Type;
+const   int     M = 20000;
+const   int     N = 6;
+
+
+int main()
+{
+    Vector<Type> r = randn( 17, Type(0.0), Type(1.0), M*N ),
+                 e = randn( 18, Type(0.0), Type(0.1), M );
+    Matrix<Type> A( M, N, r.begin() );
+    Vector<Type> x0(N), b;
+    for( int i=0; i<N; ++i )
+        x0[i] = i+1;
+    b = A*x0 + e;
+
+    TSQR<Type> tsqr;
+    tsqr.dec(A);
+    QRD<Type> qr;
+    qr.dec(A);
+
+    cout << setiosflags(ios::fixed) << setprecision(4);
+    cout << "The number of row blocks : " << tsqr.blocks() << endl << endl;
+    cout << "The upper triangular matrix R of TSQR : " << tsqr.getR() << endl;
+    cout << "The upper triangular matrix R of QRD : " << qr.getR() << endl;
+
+    if( tsqr.isFullRank() )
+    {
+        Vector<Type> x = tsqr.solve(b);
+        cout << "The exact solution x0 : " << x0 << endl;
+        cout << "The least squares solution of A * x = b : " << x << endl;
+        cout << "The least squares solution by QRD : " << qr.solve(b) << endl;
+
+        Matrix<Type> B( M, 2 );
+        for( int i=0; i<M; ++i )
+        {
+            B[i][0] = b[i];
+            B[i][1] = -2*b[i];
+        }
+        cout << "The least squares solution of A * X = [b, -2b] : "
+             << tsqr.solve(B) << endl;
+    }
+    else
+        cout << " The matrix is rank deficient! " << endl;
+
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <iomanip>
 #include <timing.h>
+#include <window.h>
 #include <wvd.h>
 
 
@@ -51,5 +52,40 @@ int main()
 	cout << "The time marginal condition is: " << timeMarg << endl;
 	cout << "The frequency marginal condition is: " << freqMarg << endl;
 
+	/******************************* [ SPWVD ] *******************************/
+	Vector<Type> gn = hamming( 11, Type(1.0) ),
+                 hn = hamming( 31, Type(1.0) );
+	cout << "Computing smoothed pseudo Wigner-Wille distribution." << endl;
+	cnt.start();
+    Matrix<Type> spCoefs = spwvd( sn, gn, hn, 64, 2 );
+	cnt.stop();
+	runtime = cnt.read();
+	cout << "The running time = " << runtime << " (ms)" << endl << endl;
+
+    // compute the same distribution tile by tile
+    int tile = 20;
+    Type tileErr = 0;
+    for( int t0=0; t0<Ls; t0+=tile )
+    {
+        Matrix<Type> part = spwvd( sn, gn, hn, 64, 2, t0, t0+tile );
+        for( int i=0; i<part.rows(); ++i )
+            for( int j=0; j<part.cols(); ++j )
+                tileErr = max( tileErr, abs(part[i][j]-spCoefs[i][t0/2+j]) );
+    }
+	cout << "The maximum difference between tiled and whole SPWVD is: "
+         << tileErr << endl << endl;
+
+    // the instantaneous frequency, a linear chirp centered at 0.25
+    cout << "The normalized frequency of the peak along time is: " << endl;
+    for( int j=10; j<40; j+=5 )
+    {
+        int peak = 0;
+        for( int i=1; i<spCoefs.rows(); ++i )
+            if( spCoefs[i][j] > spCoefs[peak][j] )
+                peak = i;
+        cout << Type(peak)/(2*spCoefs.rows()) << "  ";
+    }
+    cout << endl;
+
 	return 0;
 }